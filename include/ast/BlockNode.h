@@ -12,20 +12,32 @@ namespace funk
 class BlockNode : public Node
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::BLOCK; }
+
     BlockNode(const SourceLocation& loc);
     BlockNode(const SourceLocation& loc, const Vector<Node*>& statements);
     ~BlockNode();
 
     void add(Node* statement);
     Vector<Node*> get_statements() const;
+    // Replaces all statements without deleting the previous ones
+    void set_statements(const Vector<Node*>& new_statements);
 
     Node* evaluate() const override;
     Node* evaluate_same_scope() const;
+    Node* evaluate_in_frame() const;
+
+    // Number of symbols the block declares, a scope is only pushed for blocks that declare something
+    size_t get_slot_count() const;
 
     String to_s() const override;
 
 private:
     Vector<Node*> statements;
+    size_t slot_count{0};
+
+    void count_slots(const Node* statement);
+    Node* run() const;
 };
 
 } // namespace funk
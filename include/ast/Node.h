@@ -4,9 +4,11 @@
  */
 #pragma once
 
+#include "ast/NodeKind.h"
 #include "ast/NodeValue.h"
 #include "utils/Common.h"
 #include "utils/Exception.h"
+#include "utils/Stats.h"
 
 namespace funk
 {
@@ -21,14 +23,29 @@ public:
     /**
      * @brief Constructs a node with a source location.
      * @param loc Source location information
+     * @param kind The kind of the concrete node class
      */
-    Node(const SourceLocation& loc);
+    Node(const SourceLocation& loc, NodeKind kind);
 
     /**
      * @brief Virtual destructor for proper cleanup of derived classes.
      */
     virtual ~Node() = default;
 
+    /**
+     * @brief Allocates a node, counting its size against the budget of the run.
+     * @param size Size of the concrete node class
+     * @return void* The memory of the node
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * @brief Releases a node, giving its size back to the budget of the run.
+     * @param memory The memory of the node
+     * @param size Size of the concrete node class
+     */
+    static void operator delete(void* memory, size_t size);
+
     /**
      * @brief Evaluates the node and returns the result.
      * @return Pointer to the node representing the evaluation result
@@ -47,8 +64,44 @@ public:
      */
     SourceLocation get_location() const;
 
+    /**
+     * @brief Gets the kind of the node.
+     * @return The kind of the concrete node class
+     */
+    NodeKind get_kind() const { return kind; }
+
+    /**
+     * @brief Checks if the node is an expression.
+     * @return True if the node is an ExpressionNode
+     */
+    bool is_expression() const { return kind >= NodeKind::ASSIGNMENT && kind < NodeKind::COUNT; }
+
 protected:
     SourceLocation location; ///< Source location where this node appears in the code
+    const NodeKind kind;     ///< The kind of the concrete node class
 };
 
+/**
+ * @brief Casts a node to a node class by checking its kind instead of using RTTI.
+ * The target class must provide a static is_kind(NodeKind) function.
+ * @tparam T The node class to cast to
+ * @param node The node to cast
+ * @return The node as T, or nullptr if the node is null or not a T
+ */
+template <typename T> T* node_cast(Node* node)
+{
+    return node && T::is_kind(node->get_kind()) ? static_cast<T*>(node) : nullptr;
+}
+
+/**
+ * @brief Casts a const node to a node class by checking its kind instead of using RTTI.
+ * @tparam T The node class to cast to
+ * @param node The node to cast
+ * @return The node as T, or nullptr if the node is null or not a T
+ */
+template <typename T> const T* node_cast(const Node* node)
+{
+    return node && T::is_kind(node->get_kind()) ? static_cast<const T*>(node) : nullptr;
+}
+
 } // namespace funk
@@ -0,0 +1,53 @@
+/**
+ * @file NodeKind.h
+ * @brief Defines the NodeKind tag that identifies the concrete class of an AST node.
+ */
+#pragma once
+
+#include "utils/Common.h"
+
+namespace funk
+{
+
+/**
+ * @brief Enumeration of all concrete AST node classes.
+ * Every node stores its kind, so code can dispatch on the kind with a switch instead of using RTTI.
+ * Control flow and declaration kinds come first, followed by all expression kinds.
+ */
+enum class NodeKind
+{
+    // Statements
+    BLOCK,       ///< BlockNode
+    IF,          ///< IfNode
+    WHILE,       ///< WhileNode
+    RETURN,      ///< ReturnNode
+    YIELD,       ///< YieldNode
+    DECLARATION, ///< DeclarationNode
+    FUNCTION,    ///< FunctionNode
+
+    // Expressions
+    ASSIGNMENT,  ///< AssignmentNode
+    BINARY_OP,   ///< BinaryOpNode
+    UNARY_OP,    ///< UnaryOpNode
+    CALL,        ///< CallNode
+    METHOD_CALL, ///< MethodCallNode
+    PIPE,        ///< PipeNode
+    LIST,        ///< ListNode
+    MAP,         ///< MapNode
+    STREAM,      ///< StreamNode
+    SPAWN,       ///< SpawnNode
+    AWAIT,       ///< AwaitNode
+    LITERAL,     ///< LiteralNode
+    VARIABLE,    ///< VariableNode
+
+    COUNT ///< Number of node kinds, not a real kind
+};
+
+/**
+ * @brief Converts a NodeKind to its string representation
+ * @param kind The node kind to convert
+ * @return A string representation of the node kind
+ */
+String node_kind_to_s(NodeKind kind);
+
+} // namespace funk
@@ -0,0 +1,85 @@
+/**
+ * @file NodeRewriter.h
+ * @brief Defines the NodeRewriter interface used to transform the Abstract Syntax Tree of the Funk language.
+ */
+#pragma once
+
+#include "ast/NodeVisitor.h"
+
+namespace funk
+{
+
+/**
+ * @brief Base class for passes that replace nodes of the AST.
+ * rewrite() dispatches on the node kind like NodeVisitor::visit() and returns the node that takes the place of the
+ * rewritten one. The default implementations rewrite the children of the node and return the node itself.
+ * A rewrite_* function that returns a different node owns the old one and must delete it, after detaching the children
+ * it reuses. Returning nullptr for a statement of a block removes the statement.
+ */
+class NodeRewriter
+{
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes.
+     */
+    virtual ~NodeRewriter() = default;
+
+    /**
+     * @brief Rewrites a node by dispatching on its kind.
+     * @param node The node to rewrite, null nodes are returned as is
+     * @return The node that replaces the rewritten node
+     */
+    Node* rewrite(Node* node);
+
+protected:
+    /**
+     * @brief Rewrites all direct children of a node and stores the replacements in the node.
+     * @param node The node whose children are rewritten
+     */
+    void rewrite_children(Node* node);
+
+    /**
+     * @brief Rewrites a node that must stay of the same node class.
+     * @tparam T The node class of the slot that holds the node
+     * @param node The node to rewrite
+     * @return The replacement node
+     * @throws RuntimeError if the replacement is not a T
+     */
+    template <typename T> T* rewrite_as(T* node)
+    {
+        Node* result{rewrite(node)};
+        T* cast{node_cast<T>(result)};
+        if (result && !cast) { throw RuntimeError(result->get_location(), "Rewrite produced a node of the wrong kind"); }
+        return cast;
+    }
+
+    virtual Node* rewrite_block(BlockNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_if(IfNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_while(WhileNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_return(ReturnNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_yield(YieldNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_declaration(DeclarationNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_function(FunctionNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_assignment(AssignmentNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_binary_op(BinaryOpNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_unary_op(UnaryOpNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_call(CallNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_method_call(MethodCallNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_pipe(PipeNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_list(ListNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_map(MapNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_stream(StreamNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_spawn(SpawnNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_await(AwaitNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_literal(LiteralNode* node) { return rewrite_default(node); }
+    virtual Node* rewrite_variable(VariableNode* node) { return rewrite_default(node); }
+
+private:
+    Node* rewrite_default(Node* node)
+    {
+        rewrite_children(node);
+        return node;
+    }
+};
+
+} // namespace funk
@@ -1,72 +1,182 @@
 #pragma once
 
+#include "runtime/Object.h"
 #include "token/TokenType.h"
+#include "utils/BigInt.h"
 #include "utils/Common.h"
 #include "utils/Exception.h"
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace funk
 {
 
 /**
- * @brief Class that wraps a variant to store any primitive value in Funk.
+ * @brief Class that stores any primitive value in Funk in a single 64-bit word.
  * Provides type checking, conversion, and operator functionality.
+ *
+ * Values are NaN-boxed: a real is stored as its own bits, every other type is stored in the payload of a quiet NaN
+ * that real arithmetic never produces, with the type in the bits above the payload. Numbs that need more than the
+ * 48 bits of the payload, texts, big numbs and objects are pointers to immutable, reference counted cells, so copying
+ * a value never copies characters or digits.
+ *
+ * A numb is a 64-bit integer. Arithmetic that overflows it fails, or gives a big numb when numb promotion is enabled.
+ * A big numb is only used for values that don't fit in a numb and otherwise behaves like a numb.
  */
 class NodeValue
 {
 public:
+    /**
+     * @brief Variant with the same alternatives as a NodeValue, in the order of type_index().
+     */
+    using Variant = std::variant<Numb, double, bool, char, None, String, BigInt, ObjectRef>;
+
     /**
      * @brief Constructs a NodeValue with no value.
      */
-    NodeValue() : value(None{}) {}
+    NodeValue() : bits(box(NONE_TAG, 0)) {}
+    /**
+     * @brief Constructs a NodeValue with the given value.
+     * @param v The value to initialize with
+     */
+    NodeValue(int v) : NodeValue(static_cast<Numb>(v)) {}
+
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(int v) : value(v) {}
+    NodeValue(Numb v) :
+        bits(v >= -INLINE_LIMIT && v < INLINE_LIMIT ? box(INT_TAG, static_cast<uint64_t>(v) & PAYLOAD_MASK)
+                                                    : share(WIDE_TAG, new Cell<Numb>{{1}, v}))
+    {
+    }
 
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(double v) : value(v) {}
+    NodeValue(double v) : bits(v == v ? to_bits(v) : CANONICAL_NAN) {}
 
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(bool v) : value(v) {}
+    NodeValue(bool v) : bits(box(BOOL_TAG, v ? 1 : 0)) {}
 
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(char v) : value(v) {}
+    NodeValue(char v) : bits(box(CHAR_TAG, static_cast<unsigned char>(v))) {}
 
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(const String& v) : value(v) {}
+    NodeValue(const String& v) : bits(share(TEXT_TAG, text_cell(v))) {}
 
     /**
      * @brief Constructs a NodeValue with the given value.
      * @param v The value to initialize with
      */
-    NodeValue(None v) : value(v) {}
+    NodeValue(None /* v */) : bits(box(NONE_TAG, 0)) {}
+
+    /**
+     * @brief Constructs a NodeValue referring to a runtime object.
+     * @param v The object to refer to
+     */
+    NodeValue(ObjectRef v) : bits(share(OBJECT_TAG, new Cell<ObjectRef>{{1}, std::move(v)})) {}
+
+    /**
+     * @brief Constructs a NodeValue with the given value, a numb if it fits in one.
+     * @param v The value to initialize with
+     */
+    NodeValue(const BigInt& v);
 
     /**
      * @brief Constructs a NodeValue with the given variant.
      * @param v The variant to initialize with
      */
-    NodeValue(const std::variant<int, double, bool, char, String, None>& v) : value(v) {}
+    NodeValue(const Variant& v);
+
+    /**
+     * @brief Copies a value, a text is shared with the copy.
+     * @param other The value to copy
+     */
+    NodeValue(const NodeValue& other) : bits(other.bits) { retain(); }
+
+    /**
+     * @brief Moves a value, leaving nothing in the moved from value.
+     * @param other The value to move
+     */
+    NodeValue(NodeValue&& other) noexcept : bits(other.bits) { other.bits = box(NONE_TAG, 0); }
+
+    /**
+     * @brief Releases the cell held by the value, if any.
+     */
+    ~NodeValue() { release(); }
+
+    /**
+     * @brief Copies a value, a text is shared with the copy.
+     * @param other The value to copy
+     * @return Reference to this value
+     */
+    NodeValue& operator=(const NodeValue& other)
+    {
+        other.retain();
+        release();
+        bits = other.bits;
+        return *this;
+    }
+
+    /**
+     * @brief Moves a value, leaving nothing in the moved from value.
+     * @param other The value to move
+     * @return Reference to this value
+     */
+    NodeValue& operator=(NodeValue&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            bits = other.bits;
+            other.bits = box(NONE_TAG, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Enables or disables numb promotion for the whole interpreter.
+     * @param enabled True to give big numbs on overflow, false to fail
+     */
+    static void set_numb_promotion(bool enabled);
+
+    /**
+     * @brief Checks if numb arithmetic that overflows gives big numbs.
+     * @return bool True if numb promotion is enabled
+     */
+    static bool numb_promotion();
 
     /**
      * @brief Checks if the expression's value is of a specific type.
      * @tparam T The type to check for
      * @return True if the value is of type T
      */
-    template <typename T> bool is_a() const;
+    template <typename T> bool is_a() const
+    {
+        if constexpr (std::is_same_v<T, double>) { return (bits & BOX) != BOX; }
+        else if constexpr (std::is_same_v<T, Numb>)
+        {
+            return (bits >> TYPE_SHIFT) == (BOX >> TYPE_SHIFT) || (bits >> TYPE_SHIFT) == WIDE_HIGH_BITS;
+        }
+        else
+        {
+            constexpr uint64_t high_bits{(BOX >> TYPE_SHIFT) | tag_of<T>()};
+            return (bits >> TYPE_SHIFT) == high_bits;
+        }
+    }
 
     /**
      * @brief Gets the expression's value as a specific type.
@@ -85,7 +195,7 @@ public:
     template <typename T> T cast() const;
 
     /**
-     * @brief Checks if the expression's value is numeric (int or double).
+     * @brief Checks if the expression's value is numeric (numb, big numb or real).
      * @return True if the value is numeric
      */
     bool is_numeric() const;
@@ -97,10 +207,78 @@ public:
     bool is_nothing() const;
 
     /**
-     * @brief Gets the underlying variant.
-     * @return Reference to the underlying variant
+     * @brief Checks if other values hold the same cell as this one, so changing what it holds would change them too.
+     * @return True if the value is held in a cell that other values hold as well
+     */
+    bool is_shared() const { return bits >= SHARED && counted()->references.load(std::memory_order_acquire) > 1; }
+
+    /**
+     * @brief Gets the index of the value's type, in the order of the Variant alternatives.
+     * @return The type index
+     */
+    size_t type_index() const
+    {
+        if ((bits & BOX) != BOX) { return REAL_TYPE; }
+        return TAG_TYPES[(bits >> TYPE_SHIFT) & TYPE_MASK];
+    }
+
+    /**
+     * @brief Gets a numb without checking the type, the caller must have checked it.
+     * @return The numb
+     */
+    Numb as_numb() const
+    {
+        // The payload is sign extended by shifting it to the top and back
+        if ((bits >> TYPE_SHIFT) != WIDE_HIGH_BITS) { return static_cast<Numb>(bits << 16) >> 16; }
+        return cell<Numb>()->value;
+    }
+
+    /**
+     * @brief Gets a real without checking the type, the caller must have checked it.
+     * @return The real
+     */
+    double as_real() const
+    {
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    /**
+     * @brief Gets a bool without checking the type, the caller must have checked it.
+     * @return The bool
+     */
+    bool as_bool() const { return (bits & PAYLOAD_MASK) != 0; }
+
+    /**
+     * @brief Gets a char without checking the type, the caller must have checked it.
+     * @return The char
+     */
+    char as_char() const { return static_cast<char>(bits & 0xFF); }
+
+    /**
+     * @brief Gets a text without checking the type or copying it, the caller must have checked the type.
+     * @return Reference to the shared text, valid as long as this value holds it
+     */
+    const String& as_text() const { return cell<String>()->value; }
+
+    /**
+     * @brief Gets a big numb without checking the type or copying it, the caller must have checked the type.
+     * @return Reference to the shared big numb, valid as long as this value holds it
      */
-    auto& get_variant() const { return value; }
+    const BigInt& as_big() const { return cell<BigInt>()->value; }
+
+    /**
+     * @brief Gets an object without checking the type, the caller must have checked it.
+     * @return Reference to the object reference, valid as long as this value holds it
+     */
+    const ObjectRef& as_object() const { return cell<ObjectRef>()->value; }
+
+    /**
+     * @brief Converts the value to a variant.
+     * @return The variant holding a copy of the value
+     */
+    Variant get_variant() const;
 
     /**
      * @brief Gets the TokenType that corresponds to this value's type
@@ -115,12 +293,127 @@ public:
      */
     bool type_as(const NodeValue& other) const;
 
+    /**
+     * @brief Appends text or a character to a text value in place.
+     * The text grows like a buffer, so repeated appends take amortized linear time. A text shared with other values
+     * is copied first, so the other values keep their text.
+     * @param suffix The value to append
+     * @throws TypeError if this value is not text or the suffix is not text or a character
+     */
+    void append(const NodeValue& suffix);
+
 private:
-    std::variant<int, double, bool, char, String, None> value; ///< The stored value
+    /**
+     * @brief Reference count of a cell shared by the values that hold it.
+     */
+    struct Counted
+    {
+        std::atomic<size_t> references; ///< Number of values holding the cell
+
+        // Cells count their size against the budget of the run, like nodes
+        static void* operator new(size_t size);
+        static void operator delete(void* memory, size_t size);
+    };
+
+    /**
+     * @brief Shared cell holding a value that doesn't fit in the payload.
+     */
+    template <typename T> struct Cell : Counted
+    {
+        T value; ///< The value
+    };
+
+    // Types in the order of the Variant alternatives
+    static constexpr size_t INT_TYPE = 0;
+    static constexpr size_t REAL_TYPE = 1;
+    static constexpr size_t BOOL_TYPE = 2;
+    static constexpr size_t CHAR_TYPE = 3;
+    static constexpr size_t NONE_TYPE = 4;
+    static constexpr size_t TEXT_TYPE = 5;
+    static constexpr size_t BIG_TYPE = 6;
+    static constexpr size_t OBJECT_TYPE = 7;
+
+    // Tags of boxed values, reals are never boxed so they don't need one
+    static constexpr size_t INT_TAG = 0;
+    static constexpr size_t NONE_TAG = 1;
+    static constexpr size_t BOOL_TAG = 2;
+    static constexpr size_t CHAR_TAG = 3;
+    static constexpr size_t TEXT_TAG = 4; ///< First of the tags of values held in cells
+    static constexpr size_t BIG_TAG = 5;
+    static constexpr size_t OBJECT_TAG = 6;
+    static constexpr size_t WIDE_TAG = 7; ///< Numb in a cell, reported as INT_TYPE
+
+    // Type of the values boxed with each tag
+    static constexpr size_t TAG_TYPES[] = {
+        INT_TYPE, NONE_TYPE, BOOL_TYPE, CHAR_TYPE, TEXT_TYPE, BIG_TYPE, OBJECT_TYPE, INT_TYPE};
+
+    static constexpr uint64_t BOX = 0xFFF8000000000000;           ///< Negative quiet NaN bits marking a boxed value
+    static constexpr uint64_t CANONICAL_NAN = 0x7FF8000000000000; ///< The only NaN a real is stored as
+    static constexpr uint64_t PAYLOAD_MASK = 0x0000FFFFFFFFFFFF;  ///< Bits holding the boxed value
+    static constexpr int TYPE_SHIFT = 48;                         ///< Position of the type of a boxed value
+    static constexpr uint64_t TYPE_MASK = 0x7;                    ///< Bits of the type of a boxed value
+
+    static constexpr Numb INLINE_LIMIT = Numb{1} << 47;                         ///< Smallest numb kept in a cell
+    static constexpr uint64_t SHARED = BOX | (TEXT_TAG << TYPE_SHIFT);         ///< Lowest bits of a value in a cell
+    static constexpr uint64_t WIDE_HIGH_BITS = (BOX >> TYPE_SHIFT) | WIDE_TAG; ///< High bits of a numb in a cell
+
+    uint64_t bits; ///< The stored value
+
+    static uint64_t box(size_t tag, uint64_t payload) { return BOX | (tag << TYPE_SHIFT) | payload; }
+
+    static uint64_t share(size_t tag, Counted* counted)
+    {
+        return box(tag, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(counted)));
+    }
+
+    static uint64_t to_bits(double v)
+    {
+        uint64_t b;
+        std::memcpy(&b, &v, sizeof(b));
+        return b;
+    }
+
+    template <typename T> static constexpr size_t tag_of()
+    {
+        if constexpr (std::is_same_v<T, Numb>) { return INT_TAG; }
+        else if constexpr (std::is_same_v<T, bool>) { return BOOL_TAG; }
+        else if constexpr (std::is_same_v<T, char>) { return CHAR_TAG; }
+        else if constexpr (std::is_same_v<T, String>) { return TEXT_TAG; }
+        else if constexpr (std::is_same_v<T, BigInt>) { return BIG_TAG; }
+        else if constexpr (std::is_same_v<T, ObjectRef>) { return OBJECT_TAG; }
+        else
+        {
+            static_assert(std::is_same_v<T, None>, "Not a type a NodeValue can hold");
+            return NONE_TAG;
+        }
+    }
+
+    /**
+     * @brief Allocates the cell of a text, counting its characters against the budget of the run.
+     */
+    static Counted* text_cell(const String& v);
+
+    Counted* counted() const { return reinterpret_cast<Counted*>(static_cast<uintptr_t>(bits & PAYLOAD_MASK)); }
+
+    template <typename T> Cell<T>* cell() const { return static_cast<Cell<T>*>(counted()); }
+
+    void retain() const
+    {
+        if (bits >= SHARED) { counted()->references.fetch_add(1, std::memory_order_relaxed); }
+    }
+
+    void release()
+    {
+        if (bits >= SHARED && counted()->references.fetch_sub(1, std::memory_order_acq_rel) == 1) { destroy(); }
+    }
+
+    /**
+     * @brief Deletes the shared cell after its last value released it.
+     */
+    void destroy();
 };
 
-template <typename Op> NodeValue numeric_op(const NodeValue& lhs, const NodeValue& rhs, Op op);
-template <typename Op> NodeValue comparison(const NodeValue& lhs, const NodeValue& rhs, Op op);
+// Binary operators are dispatched through tables indexed by the types of both operands
 
 // Arithmetic operators
 NodeValue operator+(const NodeValue& lhs, const NodeValue& rhs);
@@ -0,0 +1,80 @@
+/**
+ * @file NodeVisitor.h
+ * @brief Defines the NodeVisitor interface used to walk the Abstract Syntax Tree of the Funk language.
+ */
+#pragma once
+
+#include "ast/BlockNode.h"
+#include "ast/Node.h"
+#include "ast/control/IfNode.h"
+#include "ast/control/ReturnNode.h"
+#include "ast/control/WhileNode.h"
+#include "ast/control/YieldNode.h"
+#include "ast/declaration/DeclarationNode.h"
+#include "ast/declaration/FunctionNode.h"
+#include "ast/expression/AssignmentNode.h"
+#include "ast/expression/AwaitNode.h"
+#include "ast/expression/BinaryOpNode.h"
+#include "ast/expression/CallNode.h"
+#include "ast/expression/ListNode.h"
+#include "ast/expression/LiteralNode.h"
+#include "ast/expression/MapNode.h"
+#include "ast/expression/MethodCallNode.h"
+#include "ast/expression/PipeNode.h"
+#include "ast/expression/SpawnNode.h"
+#include "ast/expression/StreamNode.h"
+#include "ast/expression/UnaryOpNode.h"
+#include "ast/expression/VariableNode.h"
+
+namespace funk
+{
+
+/**
+ * @brief Base class for passes over the AST.
+ * visit() dispatches on the node kind with a single switch and calls the matching visit_* function. The default
+ * implementations visit the children of the node, so a pass only overrides the node classes it cares about.
+ */
+class NodeVisitor
+{
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes.
+     */
+    virtual ~NodeVisitor() = default;
+
+    /**
+     * @brief Visits a node by dispatching on its kind.
+     * @param node The node to visit, null nodes are ignored
+     */
+    void visit(Node* node);
+
+protected:
+    /**
+     * @brief Visits all direct children of a node.
+     * @param node The node whose children are visited
+     */
+    void visit_children(Node* node);
+
+    virtual void visit_block(BlockNode* node) { visit_children(node); }
+    virtual void visit_if(IfNode* node) { visit_children(node); }
+    virtual void visit_while(WhileNode* node) { visit_children(node); }
+    virtual void visit_return(ReturnNode* node) { visit_children(node); }
+    virtual void visit_yield(YieldNode* node) { visit_children(node); }
+    virtual void visit_declaration(DeclarationNode* node) { visit_children(node); }
+    virtual void visit_function(FunctionNode* node) { visit_children(node); }
+    virtual void visit_assignment(AssignmentNode* node) { visit_children(node); }
+    virtual void visit_binary_op(BinaryOpNode* node) { visit_children(node); }
+    virtual void visit_unary_op(UnaryOpNode* node) { visit_children(node); }
+    virtual void visit_call(CallNode* node) { visit_children(node); }
+    virtual void visit_method_call(MethodCallNode* node) { visit_children(node); }
+    virtual void visit_pipe(PipeNode* node) { visit_children(node); }
+    virtual void visit_list(ListNode* node) { visit_children(node); }
+    virtual void visit_map(MapNode* node) { visit_children(node); }
+    virtual void visit_stream(StreamNode* node) { visit_children(node); }
+    virtual void visit_spawn(SpawnNode* node) { visit_children(node); }
+    virtual void visit_await(AwaitNode* node) { visit_children(node); }
+    virtual void visit_literal(LiteralNode* node) { visit_children(node); }
+    virtual void visit_variable(VariableNode* node) { visit_children(node); }
+};
+
+} // namespace funk
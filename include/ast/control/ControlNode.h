@@ -7,7 +7,9 @@ namespace funk
 class ControlNode : public Node
 {
 public:
-    ControlNode(const SourceLocation& loc);
+    static bool is_kind(NodeKind kind) { return kind >= NodeKind::IF && kind <= NodeKind::YIELD; }
+
+    ControlNode(const SourceLocation& loc, NodeKind kind);
     ~ControlNode() override;
 };
 } // namespace funk
@@ -9,11 +9,22 @@ namespace funk
 class IfNode : public ControlNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::IF; }
+
     IfNode(ExpressionNode* condition, BlockNode* body, Node* else_branch = nullptr);
     ~IfNode() override;
     Node* evaluate() const override;
     String to_s() const override;
 
+    ExpressionNode* get_condition() const;
+    BlockNode* get_body() const;
+    Node* get_else_branch() const;
+
+    // Setters replace a child without deleting the previous one
+    void set_condition(ExpressionNode* new_condition);
+    void set_body(BlockNode* new_body);
+    void set_else_branch(Node* new_else_branch);
+
 private:
     ExpressionNode* condition;
     BlockNode* body;
@@ -9,6 +9,8 @@ namespace funk
 class ReturnNode : public ControlNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::RETURN; }
+
     ReturnNode(const SourceLocation& location, ExpressionNode* value);
     ~ReturnNode() override;
 
@@ -16,6 +18,8 @@ public:
     String to_s() const override;
 
     ExpressionNode* get_value() const;
+    // Replaces the returned expression without deleting the previous one
+    void set_value(ExpressionNode* new_value);
 
 private:
     ExpressionNode* value;
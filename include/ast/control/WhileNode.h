@@ -9,11 +9,20 @@ namespace funk
 class WhileNode : public ControlNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::WHILE; }
+
     WhileNode(ExpressionNode* condition, BlockNode* body);
     ~WhileNode() override;
     Node* evaluate() const override;
     String to_s() const override;
 
+    ExpressionNode* get_condition() const;
+    BlockNode* get_body() const;
+
+    // Setters replace a child without deleting the previous one
+    void set_condition(ExpressionNode* new_condition);
+    void set_body(BlockNode* new_body);
+
 private:
     ExpressionNode* condition;
     BlockNode* body;
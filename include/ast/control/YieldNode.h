@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ast/control/ControlNode.h"
+#include "ast/expression/ExpressionNode.h"
+
+namespace funk
+{
+
+// Produces the next value of a generator. Only a Generator runs yield statements, evaluating one is an error.
+class YieldNode : public ControlNode
+{
+public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::YIELD; }
+
+    YieldNode(const SourceLocation& location, ExpressionNode* value);
+    ~YieldNode() override;
+
+    Node* evaluate() const override;
+    String to_s() const override;
+
+    ExpressionNode* get_value() const;
+    // Replaces the yielded expression without deleting the previous one
+    void set_value(ExpressionNode* new_value);
+
+private:
+    ExpressionNode* value;
+};
+
+} // namespace funk
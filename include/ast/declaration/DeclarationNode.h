@@ -11,6 +11,8 @@ namespace funk
 class DeclarationNode : public Node
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::DECLARATION; }
+
     DeclarationNode(const SourceLocation& location, bool is_mutable, TokenType type, const String& identifier,
         ExpressionNode* initializer);
 
@@ -20,9 +22,13 @@ public:
 
     String get_identifier() const;
     Node* get_initializer() const;
+    // Replaces the initializer without deleting the previous one
+    void set_initializer(ExpressionNode* new_initializer);
     String to_s() const override;
 
     String get_type() const;
+    TokenType get_token_type() const;
+    bool is_mutable_variable() const;
 
     Node* evaluate() const override;
 
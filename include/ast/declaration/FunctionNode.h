@@ -16,6 +16,8 @@ class BlockNode;
 class FunctionNode : public Node
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::FUNCTION; }
+
     FunctionNode(const SourceLocation& location, bool is_mutable, const String& identifier,
         const Vector<Pair<TokenType, String>>& parameters, BlockNode* body);
 
@@ -33,10 +35,17 @@ public:
     String get_identifier() const;
     const Vector<Pair<TokenType, String>>& get_parameters() const;
     BlockNode* get_body() const;
+    // Replaces the body without deleting the previous one
+    void set_body(BlockNode* new_body);
+    const Vector<ExpressionNode*>& get_pattern_values() const;
 
     bool is_pattern_matching() const;
     bool matches(const Vector<ExpressionNode*>& arguments) const;
 
+    // Functions with yield statements are generators, calling one gives a generator that runs the body lazily
+    bool is_generator() const;
+    void set_generator(bool value);
+
 private:
     bool is_mutable;
     bool is_pattern;
@@ -44,7 +53,9 @@ private:
     Vector<Pair<TokenType, String>> parameters;
     Vector<ExpressionNode*> pattern_values;
     BlockNode* body;
+    bool generator{false};
 
-    void init_param_scope(const Vector<ExpressionNode*>& arguments) const;
+    Vector<ExpressionNode*> evaluate_arguments(const Vector<ExpressionNode*>& arguments) const;
+    void init_param_scope(const Vector<ExpressionNode*>& values) const;
 };
 } // namespace funk
@@ -1,4 +1,5 @@
 #pragma once
+#include "ast/expression/BinaryOpNode.h"
 #include "ast/expression/ExpressionNode.h"
 #include "ast/expression/LiteralNode.h"
 #include "ast/expression/VariableNode.h"
@@ -10,11 +11,15 @@ namespace funk
 class AssignmentNode : public ExpressionNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::ASSIGNMENT; }
+
     AssignmentNode(Node* left, const Token& op, ExpressionNode* right);
 
     Node* get_left() const;
     const Token& get_op() const;
     ExpressionNode* get_right() const;
+    // Replaces the right-hand side without deleting the previous one
+    void set_right(ExpressionNode* new_right);
 
     Node* evaluate() const override;
     String to_s() const override;
@@ -24,6 +29,12 @@ private:
     Node* left;
     Token op;
     ExpressionNode* right;
+
+    // Operands appended in place for 'x = x + a + b' and 'x += a' on text variables
+    Vector<ExpressionNode*> appended;
+
+    void find_appended();
+    Node* append(VariableNode* var) const;
 };
 
-} // namespace funk
\ No newline at end of file
+} // namespace funk
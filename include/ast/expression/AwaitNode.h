@@ -0,0 +1,75 @@
+/**
+ * @file AwaitNode.h
+ * @brief Defines the AwaitNode class for awaiting tasks in the Funk AST.
+ */
+#pragma once
+
+#include "ast/expression/ExpressionNode.h"
+#include "ast/expression/LiteralNode.h"
+
+namespace funk
+{
+
+/**
+ * @brief Class representing waiting for the value of a task in the Funk AST.
+ *
+ * AwaitNode blocks until the task its operand evaluates to has finished and
+ * evaluates to the task's value, rethrowing the error the task failed with.
+ */
+class AwaitNode : public ExpressionNode
+{
+public:
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::AWAIT
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::AWAIT; }
+
+    /**
+     * @brief Constructs a await node.
+     * @param loc Source location of the 'await' keyword
+     * @param expr The expression evaluating to the task
+     */
+    AwaitNode(const SourceLocation& loc, ExpressionNode* expr);
+
+    /**
+     * @brief Virtual destructor for proper cleanup of resources.
+     */
+    ~AwaitNode() override;
+
+    /**
+     * @brief Evaluates the await expression.
+     * @return A literal node holding the value of the task
+     */
+    Node* evaluate() const override;
+
+    /**
+     * @brief Converts the await expression to a string representation.
+     * @return String representation of the await expression
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Gets the value that this await expression evaluates to.
+     * @return The value of the task's expression
+     */
+    NodeValue get_value() const override;
+
+    /**
+     * @brief Gets the expression giving the awaited task.
+     * @return Pointer to the expression
+     */
+    ExpressionNode* get_expr() const;
+
+    /**
+     * @brief Replaces the expression giving the awaited task, the previous expression is not deleted.
+     * @param new_expr The new expression
+     */
+    void set_expr(ExpressionNode* new_expr);
+
+private:
+    ExpressionNode* expr; ///< The expression giving the awaited task
+};
+
+} // namespace funk
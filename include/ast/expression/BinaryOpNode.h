@@ -7,6 +7,7 @@
 #include "ast/expression/ExpressionNode.h"
 #include "ast/expression/LiteralNode.h"
 #include "token/Token.h"
+#include <atomic>
 
 namespace funk
 {
@@ -17,10 +18,36 @@ namespace funk
  * BinaryOpNode represents operations that require two operands (left and right)
  * and an operator. These include arithmetic operations like addition and
  * multiplication, as well as comparison operations like equality and greater than.
+ *
+ * The node specializes itself on the operand types seen by its first evaluation: while both operands keep being
+ * numbs, reals or texts, the operator is applied directly to the unwrapped values. When the operand types change, the
+ * node falls back to the generic NodeValue operators for good.
+ *
+ * A parallel node has two independent calls to pure functions as operands. When a worker is idle, the right call is
+ * forked onto it while the left one is evaluated on the calling thread.
  */
 class BinaryOpNode : public ExpressionNode
 {
 public:
+    /**
+     * @brief Operand types a binary operation is specialized for.
+     */
+    enum class Specialization
+    {
+        UNSPECIALIZED, ///< Not evaluated yet
+        NUMB_NUMB,     ///< Both operands are numbs
+        REAL_REAL,     ///< Both operands are reals
+        TEXT_TEXT,     ///< Both operands are texts
+        GENERIC        ///< Any operand types, applied with the NodeValue operators
+    };
+
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::BINARY_OP
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::BINARY_OP; }
+
     /**
      * @brief Constructs a binary operation node with left and right expressions and an operator.
      * @param left The left-hand side expression
@@ -36,7 +63,7 @@ public:
 
     /**
      * @brief Evaluates the binary operation.
-     * @return A node representing the result of applying the operator to the operands
+     * @return A new literal node holding the result of applying the operator to the operands
      */
     Node* evaluate() const override;
 
@@ -47,11 +74,22 @@ public:
     String to_s() const override;
 
     /**
-     * @brief Gets the value that this binary operation evaluates to.
+     * @brief Gets the value that this binary operation evaluates to, without allocating a result node.
      * @return The evaluated value of this binary operation
      */
     NodeValue get_value() const override;
 
+    /**
+     * @brief Applies a binary operator to two values.
+     * @param op The operator to apply
+     * @param left_value The left-hand side value
+     * @param right_value The right-hand side value
+     * @return The result of the operation
+     * @throws TypeError if the operator can't be applied to the values
+     * @throws RuntimeError if the operator is not a binary operator or the operation fails
+     */
+    static NodeValue apply(TokenType op, const NodeValue& left_value, const NodeValue& right_value);
+
     /**
      * @brief Gets the binary operator used in this operation.
      * @return The binary operator
@@ -70,10 +108,75 @@ public:
      */
     ExpressionNode* get_right() const;
 
+    /**
+     * @brief Replaces the left-hand side expression, the previous expression is not deleted.
+     * @param new_left The new left expression
+     */
+    void set_left(ExpressionNode* new_left);
+
+    /**
+     * @brief Replaces the right-hand side expression, the previous expression is not deleted.
+     * @param new_right The new right expression
+     */
+    void set_right(ExpressionNode* new_right);
+
+    /**
+     * @brief Gets the operand types this operation is specialized for.
+     * @return The current specialization
+     */
+    Specialization get_specialization() const;
+
+    /**
+     * @brief Allows the right operand to be evaluated on another thread, only for pure calls as both operands.
+     * @param value True to evaluate the operands in parallel when a worker is idle
+     */
+    void set_parallel(bool value);
+
+    /**
+     * @brief Checks if the operands may be evaluated in parallel.
+     * @return True if the node is parallel
+     */
+    bool is_parallel() const;
+
 private:
     Token op;              ///< The binary operator
     ExpressionNode* left;  ///< The left-hand side expression
     ExpressionNode* right; ///< The right-hand side expression
+    bool parallel{false};  ///< True if the right operand may be forked
+
+    /**
+     * @brief Operand types seen so far.
+     * Atomic because tasks share the tree, every state is correct for any operands so relaxed accesses are enough.
+     */
+    mutable std::atomic<Specialization> specialization{Specialization::UNSPECIALIZED};
+
+    /**
+     * @brief Picks the specialization for the operand types of the first evaluation.
+     * @param left_value The left-hand side value
+     * @param right_value The right-hand side value
+     * @return Specialization The picked specialization
+     */
+    Specialization specialize(const NodeValue& left_value, const NodeValue& right_value) const;
+
+    /**
+     * @brief Applies the operator to two numbs, with the same results and errors as the generic operators.
+     */
+    NodeValue apply_numb(Numb lhs, Numb rhs) const;
+
+    /**
+     * @brief Applies the operator to two reals, with the same results and errors as the generic operators.
+     */
+    NodeValue apply_real(double lhs, double rhs) const;
+
+    /**
+     * @brief Applies the operator to two texts, with the same results as the generic operators.
+     */
+    NodeValue apply_text(const String& lhs, const String& rhs) const;
+
+    /**
+     * @brief Applies the operator with the generic NodeValue operators, reporting errors at this node.
+     */
+    NodeValue apply_generic(const NodeValue& left_value, const NodeValue& right_value) const;
 };
 
 } // namespace funk
@@ -14,18 +14,25 @@ namespace funk
 class CallNode : public ExpressionNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::CALL || kind == NodeKind::METHOD_CALL; }
+
     CallNode(const Token& identifier, const Vector<ExpressionNode*>& args);
     ~CallNode() override;
 
     Node* evaluate() const override;
+    Node* call_with(const Vector<ExpressionNode*>& arguments) const;
 
     String to_s() const override;
 
     NodeValue get_value() const override;
     const Token& get_identifier() const;
     const Vector<ExpressionNode*>& get_args() const;
+    // Replaces an argument without deleting the previous one
+    void set_arg(size_t index, ExpressionNode* arg);
 
 protected:
+    CallNode(const Token& identifier, const Vector<ExpressionNode*>& args, NodeKind kind);
+
     Token identifier;
     Vector<ExpressionNode*> args;
 };
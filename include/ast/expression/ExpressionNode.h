@@ -16,11 +16,19 @@ namespace funk
 class ExpressionNode : public Node
 {
 public:
+    /**
+     * @brief Checks if a node kind belongs to an expression class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is an expression kind
+     */
+    static bool is_kind(NodeKind kind) { return kind >= NodeKind::ASSIGNMENT && kind < NodeKind::COUNT; }
+
     /**
      * @brief Constructs an expression node with source location information.
      * @param loc Source location information
+     * @param kind The kind of the concrete node class
      */
-    ExpressionNode(const SourceLocation& loc);
+    ExpressionNode(const SourceLocation& loc, NodeKind kind);
 
     /**
      * @brief Virtual destructor for proper cleanup of derived classes.
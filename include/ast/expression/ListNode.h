@@ -8,6 +8,8 @@ namespace funk
 class ListNode : public ExpressionNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::LIST; }
+
     ListNode(const SourceLocation& location, const TokenType& type, const Vector<ExpressionNode*>& elements);
     ~ListNode() override;
 
@@ -16,6 +18,9 @@ public:
     NodeValue get_value() const override;
 
     size_t length() const;
+    const Vector<ExpressionNode*>& get_elements() const;
+    // Replaces an element without deleting the previous one
+    void set_element(size_t index, ExpressionNode* element);
 
 private:
     const TokenType type;
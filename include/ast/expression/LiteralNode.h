@@ -9,6 +9,8 @@
 namespace funk
 {
 
+class Map;
+
 /**
  * @brief Node representing a literal value in the Funk AST.
  * LiteralNode represents constant values like numbers, strings, booleans, etc. that appear directly in the source code.
@@ -16,6 +18,13 @@ namespace funk
 class LiteralNode : public ExpressionNode
 {
 public:
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::LITERAL
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::LITERAL; }
+
     /**
      * @brief Constructs a literal node with source location and value.
      * @param loc Source location information
@@ -41,6 +50,26 @@ public:
      */
     NodeValue get_value() const;
 
+    /**
+     * @brief Replaces the value of this literal in place.
+     * @param new_value The new value
+     */
+    void set_value(const NodeValue& new_value);
+
+    /**
+     * @brief Appends to the text value of this literal in place.
+     * @param suffix The text or character to append
+     * @throws TypeError if the literal is not text or the suffix is not text or a character
+     */
+    void append(const NodeValue& suffix);
+
+    /**
+     * @brief Gets the map of this literal to change it in place, copying the map first if other values hold it.
+     * @return Map& The map, held by this literal only
+     * @throws TypeError if the literal is not a map
+     */
+    Map& own_map();
+
 private:
     NodeValue value; ///< The actual value of this literal
 };
@@ -0,0 +1,86 @@
+/**
+ * @file MapNode.h
+ * @brief Defines the MapNode class for representing map literals in the Funk AST.
+ */
+#pragma once
+#include "ast/expression/ExpressionNode.h"
+#include <utility>
+
+namespace funk
+{
+
+/**
+ * @brief Node representing a map literal, like { "a": 1, "b": 2 }.
+ * Every evaluation creates a new map from the current values of the key and value expressions.
+ */
+class MapNode : public ExpressionNode
+{
+public:
+    /**
+     * @brief Key and value expressions of one entry of the literal.
+     */
+    using Entry = std::pair<ExpressionNode*, ExpressionNode*>;
+
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::MAP
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::MAP; }
+
+    /**
+     * @brief Constructs a map literal.
+     * @param loc Source location information
+     * @param entries Key and value expressions in the order they were written, owned by the node
+     */
+    MapNode(const SourceLocation& loc, const Vector<Entry>& entries);
+
+    /**
+     * @brief Deletes the key and value expressions.
+     */
+    ~MapNode() override;
+
+    /**
+     * @brief Evaluates the map literal.
+     * @return Pointer to a new literal node holding the new map
+     */
+    Node* evaluate() const override;
+
+    /**
+     * @brief Converts the map literal to a string representation.
+     * @return String representation of the map literal
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Creates the map without allocating a node for it.
+     * @return The new map
+     * @throws TypeError if a key or value is none or of another type than the first one
+     */
+    NodeValue get_value() const override;
+
+    /**
+     * @brief Gets the key and value expressions.
+     * @return The entries of the literal
+     */
+    const Vector<Entry>& get_entries() const;
+
+    /**
+     * @brief Replaces the key expression of an entry without deleting the previous one.
+     * @param index Index of the entry
+     * @param key The new key expression
+     */
+    void set_key(size_t index, ExpressionNode* key);
+
+    /**
+     * @brief Replaces the value expression of an entry without deleting the previous one.
+     * @param index Index of the entry
+     * @param value The new value expression
+     */
+    void set_value(size_t index, ExpressionNode* value);
+
+private:
+    Vector<Entry> entries; ///< Key and value expressions
+};
+
+} // namespace funk
@@ -6,9 +6,13 @@
 
 namespace funk
 {
+class Map;
+
 class MethodCallNode : public CallNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::METHOD_CALL; }
+
     MethodCallNode(ExpressionNode* object, const Token& method, const Vector<ExpressionNode*>& args);
     ~MethodCallNode() override;
 
@@ -16,7 +20,25 @@ public:
     String to_s() const override;
     NodeValue get_value() const override;
 
+    ExpressionNode* get_object() const;
+    // Replaces the object without deleting the previous one
+    void set_object(ExpressionNode* new_object);
+
 private:
     ExpressionNode* object;
+
+    // Evaluates the object, following variables to the node holding their value, receives the variable if the object
+    // is one
+    Node* evaluate_object(VariableNode*& variable) const;
+    // Calls the method on the evaluated object
+    Node* call_method(Node* evaluated_object, VariableNode* variable) const;
+    // Calls a method of the generator the object holds, returns false if it holds none
+    bool call_generator(Node* evaluated_object, NodeValue& result) const;
+    // Calls a method of the channel the object holds, returns false if it holds none
+    bool call_channel(Node* evaluated_object, NodeValue& result) const;
+    // Calls a method of the map the object holds, returns false if it holds none or the method gives a stream
+    bool call_map(Node* evaluated_object, VariableNode* variable, NodeValue& result) const;
+    // Gets the map held by a variable to change it in place
+    Map& own_map(VariableNode* variable) const;
 };
 } // namespace funk
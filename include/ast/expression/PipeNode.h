@@ -3,6 +3,10 @@
 #include "ast/declaration/FunctionNode.h"
 #include "ast/expression/CallNode.h"
 #include "ast/expression/ExpressionNode.h"
+#include "ast/expression/StreamNode.h"
+#include "runtime/Channel.h"
+#include "runtime/Generator.h"
+#include "runtime/Map.h"
 
 namespace funk
 {
@@ -10,6 +14,8 @@ namespace funk
 class PipeNode : public ExpressionNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::PIPE; }
+
     PipeNode(const SourceLocation& location, ExpressionNode* source, ExpressionNode* target);
     ~PipeNode() override;
 
@@ -20,8 +26,17 @@ public:
     ExpressionNode* get_source() const;
     ExpressionNode* get_target() const;
 
+    // Setters replace a child without deleting the previous one
+    void set_source(ExpressionNode* new_source);
+    void set_target(ExpressionNode* new_target);
+
 private:
     ExpressionNode* source;
     ExpressionNode* target;
+
+    // Sends the value to the sink if there is one, otherwise calls the target with it
+    Node* apply(Node* value, Channel* sink) const;
+    // Gets the channel held by a variable named as target, piped values are sent to it
+    std::shared_ptr<Channel> get_sink() const;
 };
 } // namespace funk
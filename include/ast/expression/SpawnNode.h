@@ -0,0 +1,75 @@
+/**
+ * @file SpawnNode.h
+ * @brief Defines the SpawnNode class for spawning tasks in the Funk AST.
+ */
+#pragma once
+
+#include "ast/expression/ExpressionNode.h"
+#include "ast/expression/LiteralNode.h"
+
+namespace funk
+{
+
+/**
+ * @brief Class representing an expression that runs as a task in the Funk AST.
+ *
+ * SpawnNode queues its expression to run concurrently on the scheduler and evaluates
+ * to the task, without waiting for the expression's value.
+ */
+class SpawnNode : public ExpressionNode
+{
+public:
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::SPAWN
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::SPAWN; }
+
+    /**
+     * @brief Constructs a spawn node.
+     * @param loc Source location of the 'spawn' keyword
+     * @param expr The expression to run in the task
+     */
+    SpawnNode(const SourceLocation& loc, ExpressionNode* expr);
+
+    /**
+     * @brief Virtual destructor for proper cleanup of resources.
+     */
+    ~SpawnNode() override;
+
+    /**
+     * @brief Evaluates the spawn expression.
+     * @return A literal node holding the spawned task
+     */
+    Node* evaluate() const override;
+
+    /**
+     * @brief Converts the spawn expression to a string representation.
+     * @return String representation of the spawn expression
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Gets the value that this spawn expression evaluates to.
+     * @return The task value, awaited to get the expression's value
+     */
+    NodeValue get_value() const override;
+
+    /**
+     * @brief Gets the expression run in the task.
+     * @return Pointer to the expression
+     */
+    ExpressionNode* get_expr() const;
+
+    /**
+     * @brief Replaces the expression run in the task, the previous expression is not deleted.
+     * @param new_expr The new expression
+     */
+    void set_expr(ExpressionNode* new_expr);
+
+private:
+    ExpressionNode* expr; ///< The expression run in the task
+};
+
+} // namespace funk
@@ -0,0 +1,71 @@
+/**
+ * @file StreamNode.h
+ * @brief Defines the StreamNode class for representing lazy sequences of values in the Funk AST.
+ */
+#pragma once
+
+#include "ast/expression/ExpressionNode.h"
+#include <functional>
+
+namespace funk
+{
+
+/**
+ * @brief Node representing a lazy sequence of values.
+ * Values are pulled one at a time from a producer, so a stream never holds more than the current value. Streams are
+ * consumed by piping them into a function, which is then called once per value.
+ */
+class StreamNode : public ExpressionNode
+{
+public:
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::STREAM
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::STREAM; }
+
+    /**
+     * @brief Function producing the next value of a stream, returns false when the stream is exhausted.
+     */
+    using Producer = std::function<bool(NodeValue&)>;
+
+    /**
+     * @brief Constructs a stream node from a producer.
+     * @param loc Source location information
+     * @param name Name of the stream, used in its string representation
+     * @param producer Function producing the values of the stream
+     */
+    StreamNode(const SourceLocation& loc, const String& name, Producer producer);
+
+    /**
+     * @brief Evaluates the stream node.
+     * @return Pointer to the node itself, values are only produced by next()
+     */
+    Node* evaluate() const override;
+
+    /**
+     * @brief Converts the stream to a string representation.
+     * @return String representation of the stream
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Gets the value of the stream, which is its string representation.
+     * @return The string representation of the stream
+     */
+    NodeValue get_value() const override;
+
+    /**
+     * @brief Produces the next value of the stream.
+     * @param value Receives the next value
+     * @return bool False if the stream is exhausted
+     */
+    bool next(NodeValue& value) const;
+
+private:
+    String name;       ///< Name of the stream
+    Producer producer; ///< Function producing the values
+};
+
+} // namespace funk
@@ -20,6 +20,13 @@ namespace funk
 class UnaryOpNode : public ExpressionNode
 {
 public:
+    /**
+     * @brief Checks if a node kind belongs to this class, used by node_cast.
+     * @param kind The node kind to check
+     * @return True if the kind is NodeKind::UNARY_OP
+     */
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::UNARY_OP; }
+
     /**
      * @brief Constructs a unary operation node with an expression and an operator.
      * @param op The unary operator to apply
@@ -50,6 +57,16 @@ public:
      */
     NodeValue get_value() const override;
 
+    /**
+     * @brief Applies a unary operator to a value.
+     * @param op The operator to apply
+     * @param value The operand
+     * @return The result of the operation
+     * @throws TypeError if the operator can't be applied to the value
+     * @throws RuntimeError if the operator is not a unary operator
+     */
+    static NodeValue apply(TokenType op, const NodeValue& value);
+
     /**
      * @brief Gets the unary operator used in this operation.
      * @return The unary operator
@@ -62,6 +79,12 @@ public:
      */
     ExpressionNode* get_expr() const;
 
+    /**
+     * @brief Replaces the operand, the previous expression is not deleted.
+     * @param new_expr The new operand
+     */
+    void set_expr(ExpressionNode* new_expr);
+
 private:
     Token op;             ///< The unary operator
     ExpressionNode* expr; ///< The expression to apply the operator to
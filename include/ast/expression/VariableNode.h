@@ -2,6 +2,7 @@
 
 #include "ast/Node.h"
 #include "ast/expression/ExpressionNode.h"
+#include "ast/expression/LiteralNode.h"
 #include "parser/Scope.h"
 #include "token/TokenType.h"
 
@@ -11,6 +12,8 @@ namespace funk
 class VariableNode : public ExpressionNode
 {
 public:
+    static bool is_kind(NodeKind kind) { return kind == NodeKind::VARIABLE; }
+
     VariableNode(const SourceLocation& location, const String& identifier, bool is_mutable, TokenType type,
         ExpressionNode* value);
     VariableNode(const SourceLocation& location, const String& identifier);
@@ -25,6 +28,8 @@ public:
     const String& get_identifier() const;
     ExpressionNode* get_value_node() const;
     void set_value(ExpressionNode* new_value);
+    void assign(const NodeValue& new_value);
+    void append(const NodeValue& suffix);
 
 private:
     String identifier;
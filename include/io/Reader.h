@@ -0,0 +1,105 @@
+/**
+ * @file Reader.h
+ * @brief Defines the buffered Reader used for all program input in the Funk language.
+ */
+#pragma once
+
+#include "io/Writer.h"
+#include "utils/Common.h"
+#include "utils/Exception.h"
+
+namespace funk
+{
+
+/**
+ * @brief Buffered reader on top of a file descriptor.
+ * Regular files are memory mapped and read without copying, anything else is read in large chunks straight from the
+ * descriptor. The reader does not synchronize with the C++ streams.
+ */
+class Reader
+{
+public:
+    /**
+     * @brief Default buffer size in bytes.
+     */
+    static const size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    /**
+     * @brief Constructs a reader for an already open file descriptor.
+     * @param fd The file descriptor to read from
+     * @param capacity Size of the buffer in bytes, used when the descriptor can't be mapped
+     */
+    Reader(int fd, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Unmaps the input if it was mapped.
+     */
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    /**
+     * @brief Returns the reader that the calling thread reads from.
+     * @return Reader& The reader of the program run by the thread, or else the standard input reader, which is tied to
+     * the standard output writer
+     */
+    static Reader& in();
+
+    /**
+     * @brief Makes a reader the one that the calling thread reads from.
+     * @param reader The reader, or nullptr for the standard input reader
+     * @return Reader* The previous reader, or nullptr if it was the standard input reader
+     */
+    static Reader* enter(Reader* reader);
+
+    /**
+     * @brief Sets a writer that is flushed before the reader blocks on more input.
+     * @param writer The writer to flush, or nullptr for none
+     */
+    void tie(Writer* writer);
+
+    /**
+     * @brief Reads the next line without the trailing newline.
+     * @param line Receives the line
+     * @return bool False if the end of the input was reached before anything was read
+     */
+    bool read_line(String& line);
+
+    /**
+     * @brief Reads all remaining input.
+     * @return String The remaining input
+     */
+    String read_all();
+
+    /**
+     * @brief Checks if the end of the input has been reached.
+     * @return bool True if there is nothing left to read
+     */
+    bool done();
+
+private:
+    static thread_local Reader* current; ///< Reader of the program run by the thread, nullptr for standard input
+
+    int fd;              ///< File descriptor that is read from
+    Writer* tied{};      ///< Writer flushed before blocking reads
+    Vector<char> buffer; ///< Input buffer for descriptors that can't be mapped
+    const char* begin{}; ///< Start of the unread input
+    const char* end{};   ///< End of the available input
+    char* mapped{};      ///< Start of the mapping, if the input is mapped
+    size_t mapped_size{0}; ///< Size of the mapping
+    bool eof{false};     ///< True when the descriptor has no more input
+
+    /**
+     * @brief Tries to map the descriptor into memory.
+     */
+    void map();
+
+    /**
+     * @brief Reads the next chunk of input into the buffer.
+     * @return bool False if no more input was available
+     */
+    bool fill();
+};
+
+} // namespace funk
@@ -0,0 +1,87 @@
+/**
+ * @file Socket.h
+ * @brief Defines the Unix domain Socket that connects the funk client to a funk server.
+ */
+#pragma once
+
+#include "utils/Common.h"
+#include "utils/Exception.h"
+
+namespace funk
+{
+
+/**
+ * @brief Unix domain socket that exchanges whole messages, along with open file descriptors.
+ * Messages keep their boundaries, so a receive returns exactly what one send sent. Descriptors sent with a message are
+ * duplicated into the receiving process, which lets a server write straight to the standard output of its client.
+ */
+class Socket
+{
+public:
+    static const size_t MAX_MESSAGE = 64 * 1024; ///< Largest message in bytes
+    static const size_t MAX_FDS = 8;             ///< Most descriptors sent with a message
+
+    /**
+     * @brief Creates a socket that accepts connections at a path, replacing a socket left there by a stopped server.
+     * @param path Path of the socket file
+     * @return Socket The listening socket
+     * @throws FileError if the socket could not be created, the path is taken by anything but a socket or a server
+     * still accepts connections on it
+     */
+    static Socket listen(const String& path);
+
+    /**
+     * @brief Connects to a socket that listens at a path.
+     * @param path Path of the socket file
+     * @return Socket The connected socket
+     * @throws FileError if nothing listens at the path
+     */
+    static Socket connect(const String& path);
+
+    /**
+     * @brief Closes the socket, a listening socket also removes its file.
+     */
+    ~Socket();
+
+    Socket(Socket&& other) noexcept;
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+    Socket& operator=(Socket&&) = delete;
+
+    /**
+     * @brief Waits for the next connection of a listening socket.
+     * @return Socket The socket of the connection
+     * @throws FileError if the connection could not be accepted
+     */
+    Socket accept() const;
+
+    /**
+     * @brief Sends a message.
+     * @param message The bytes to send, at most MAX_MESSAGE
+     * @param fds Descriptors to send along, at most MAX_FDS, they stay open in the sending process
+     * @throws FileError if the message could not be sent
+     */
+    void send(const String& message, const Vector<int>& fds = {}) const;
+
+    /**
+     * @brief Waits for the next message.
+     * @param message Receives the bytes of the message
+     * @param fds Receives the descriptors sent along, the caller must close them
+     * @return bool False if the other side closed the connection
+     * @throws FileError if the message could not be received
+     */
+    bool receive(String& message, Vector<int>& fds) const;
+
+private:
+    int fd;      ///< Descriptor of the socket
+    String path; ///< Path of the socket file if the socket listens, else empty
+
+    /**
+     * @brief Takes ownership of a socket descriptor.
+     * @param fd The descriptor
+     * @param path Path of the socket file if the socket listens
+     */
+    explicit Socket(int fd, const String& path = "");
+};
+
+} // namespace funk
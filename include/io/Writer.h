@@ -0,0 +1,140 @@
+/**
+ * @file Writer.h
+ * @brief Defines the buffered Writer used for all program output in the Funk language.
+ */
+#pragma once
+
+#include "utils/Common.h"
+#include "utils/Exception.h"
+#include <mutex>
+
+namespace funk
+{
+
+/**
+ * @brief Buffered writer on top of a file descriptor.
+ * Output is collected in a fixed size buffer and only handed to the operating system when the buffer is full or
+ * when flush() is called, so the number of write syscalls depends on the buffer size instead of the number of writes.
+ * A writer can be shared by tasks, every call is written as a whole. A writer may also collect its output in a string
+ * instead, which captures the output of a program that shares its process with others.
+ */
+class Writer
+{
+public:
+    /**
+     * @brief Default buffer size in bytes.
+     */
+    static const size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    /**
+     * @brief Constructs a writer for an already open file descriptor.
+     * @param fd The file descriptor to write to
+     * @param capacity Size of the buffer in bytes
+     * @param owns_fd True if the writer should close the descriptor when destroyed
+     */
+    Writer(int fd, size_t capacity = DEFAULT_CAPACITY, bool owns_fd = false);
+
+    /**
+     * @brief Constructs a writer for a file.
+     * @param path Path to the file to write to
+     * @param append True to append to the file, false to truncate it
+     * @param capacity Size of the buffer in bytes
+     * @throws FileError if the file could not be opened
+     */
+    Writer(const String& path, bool append, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Constructs a writer that appends its output to a string.
+     * @param sink The string to append to, it must outlive the writer
+     * @param capacity Size of the buffer in bytes
+     */
+    explicit Writer(String* sink, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Flushes the remaining output and closes the descriptor if owned.
+     */
+    ~Writer();
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /**
+     * @brief Returns the writer that the calling thread prints to.
+     * @return Writer& The writer of the program run by the thread, or else the standard output writer
+     */
+    static Writer& out();
+
+    /**
+     * @brief Returns the standard output writer, whatever writer the calling thread prints to.
+     * @return Writer& The writer of the standard output
+     */
+    static Writer& standard();
+
+    /**
+     * @brief Makes a writer the one that the calling thread prints to.
+     * @param writer The writer, or nullptr for the standard output writer
+     * @return Writer* The previous writer, or nullptr if it was the standard output writer
+     */
+    static Writer* enter(Writer* writer);
+
+    /**
+     * @brief Writes a string to the buffer.
+     * @param text The text to write
+     */
+    void write(const String& text);
+
+    /**
+     * @brief Writes raw bytes to the buffer.
+     * @param data Pointer to the bytes
+     * @param size Number of bytes
+     */
+    void write(const char* data, size_t size);
+
+    /**
+     * @brief Writes a single character to the buffer.
+     * @param c The character to write
+     */
+    void put(char c);
+
+    /**
+     * @brief Hands all buffered output to the operating system.
+     * @throws FileError if the output could not be written
+     */
+    void flush();
+
+    /**
+     * @brief Changes the size of the buffer, flushing any pending output first.
+     * @param capacity New buffer size in bytes, at least one
+     */
+    void set_capacity(size_t capacity);
+
+    /**
+     * @brief Gets the size of the buffer.
+     * @return size_t Buffer size in bytes
+     */
+    size_t get_capacity() const;
+
+private:
+    static thread_local Writer* current; ///< Writer of the program run by the thread, nullptr for standard output
+
+    int fd;                ///< File descriptor that is written to, -1 when writing to a string
+    bool owns_fd;          ///< True if the descriptor is closed by the destructor
+    String* sink{nullptr}; ///< String that is written to instead of a descriptor, if any
+    Vector<char> buffer;   ///< Pending output
+    size_t used{0};        ///< Number of bytes in use in the buffer
+    std::mutex lock;       ///< Serializes writes from concurrent tasks
+
+    /**
+     * @brief Writes bytes directly to the file descriptor.
+     * @param data Pointer to the bytes
+     * @param size Number of bytes
+     */
+    void write_fd(const char* data, size_t size);
+
+    /**
+     * @brief Hands all buffered output to the operating system, the lock must be held.
+     */
+    void flush_buffer();
+};
+
+} // namespace funk
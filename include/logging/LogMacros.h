@@ -16,9 +16,16 @@
 
 /**
  * @brief Logs a debug message.
+ * The message is only formatted when debug logging is enabled, since debug messages are logged on hot paths.
  * @param message The message to log (can be any streamable object)
  */
-#define LOG_DEBUG(message) funk::logger().log(funk::LogLevel::DEBUG, FUNK_LOG_STREAM(message))
+#define LOG_DEBUG(message)                                                                                             \
+    do {                                                                                                               \
+        if (funk::logger().get_level() <= funk::LogLevel::DEBUG)                                                       \
+        {                                                                                                              \
+            funk::logger().log(funk::LogLevel::DEBUG, FUNK_LOG_STREAM(message));                                       \
+        }                                                                                                              \
+    } while (false)
 
 /**
  * @brief Logs an informational message.
@@ -9,6 +9,7 @@
 
 #include "utils/Common.h"
 #include <chrono>
+#include <mutex>
 
 namespace funk
 {
@@ -107,6 +108,7 @@ private:
     std::string log_path;   ///< Path to the log file
     std::ofstream log_file; ///< Output stream for the log file
     LogLevel log_level;     ///< Current log level
+    std::mutex lock;        ///< Keeps messages logged by concurrent tasks apart
 };
 
 /**
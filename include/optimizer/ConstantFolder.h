@@ -0,0 +1,70 @@
+/**
+ * @file ConstantFolder.h
+ * @brief Defines the constant folding pass of the Funk optimizer.
+ */
+#pragma once
+
+#include "optimizer/Pass.h"
+#include "utils/Common.h"
+
+namespace funk
+{
+
+/**
+ * @brief Folds operations on literals into a single literal and simplifies operations on typed variables.
+ * Operations that would fail, like a division by zero or adding a bool to a text, are left in the tree so that the
+ * error is reported at runtime with its original location.
+ * The simplifications only use the types of variables declared with an initializer, since the type of those can
+ * never change. Declarations outside of a function are not used in its body, because the body can be called from
+ * any scope.
+ */
+class ConstantFolder : public Pass
+{
+public:
+    /**
+     * @brief Constructs the pass, named "fold".
+     */
+    ConstantFolder();
+
+protected:
+    void prepare(Node* root) override;
+    Node* rewrite_block(BlockNode* node) override;
+    Node* rewrite_function(FunctionNode* node) override;
+    Node* rewrite_declaration(DeclarationNode* node) override;
+    Node* rewrite_binary_op(BinaryOpNode* node) override;
+    Node* rewrite_unary_op(UnaryOpNode* node) override;
+
+private:
+    Vector<HashMap<String, TokenType>> types{}; ///< Known variable types per block, NONE when unknown
+
+    /**
+     * @brief Gets the type of an expression if it is known before running the program.
+     * @param expr The expression to check
+     * @return TokenType The value type, or NONE if it is unknown
+     */
+    TokenType type_of(const ExpressionNode* expr) const;
+
+    /**
+     * @brief Records the type of a symbol declared in the current block.
+     * @param name The name of the symbol
+     * @param type The value type, or NONE if it is unknown
+     */
+    void declare(const String& name, TokenType type);
+
+    /**
+     * @brief Applies algebraic simplifications to a binary operation with folded operands.
+     * @param node The operation to simplify
+     * @return Node* The simplified node, or the operation itself
+     */
+    Node* simplify(BinaryOpNode* node);
+
+    /**
+     * @brief Replaces a node with a literal holding its value.
+     * @param node The node to replace, it is deleted
+     * @param value The value of the node
+     * @return LiteralNode* The new literal
+     */
+    LiteralNode* replace_with_literal(ExpressionNode* node, const NodeValue& value);
+};
+
+} // namespace funk
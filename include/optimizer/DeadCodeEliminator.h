@@ -0,0 +1,31 @@
+/**
+ * @file DeadCodeEliminator.h
+ * @brief Defines the dead code elimination pass of the Funk optimizer.
+ */
+#pragma once
+
+#include "optimizer/Pass.h"
+
+namespace funk
+{
+
+/**
+ * @brief Removes statements that can never run or have no effect.
+ * Branches of if statements with a literal condition are resolved, loops with a false literal condition and
+ * statements after a return are removed, as are literal statements such as the ones left by empty statements.
+ */
+class DeadCodeEliminator : public Pass
+{
+public:
+    /**
+     * @brief Constructs the pass, named "dce".
+     */
+    DeadCodeEliminator();
+
+protected:
+    Node* rewrite_block(BlockNode* node) override;
+    Node* rewrite_if(IfNode* node) override;
+    Node* rewrite_while(WhileNode* node) override;
+};
+
+} // namespace funk
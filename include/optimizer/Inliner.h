@@ -0,0 +1,68 @@
+/**
+ * @file Inliner.h
+ * @brief Defines the function inlining pass of the Funk optimizer.
+ */
+#pragma once
+
+#include "optimizer/Pass.h"
+
+namespace funk
+{
+
+/**
+ * @brief Replaces calls to small functions with the expression the function returns.
+ * A function is inlined if its body is a single return of a small expression without declarations, it does not call
+ * itself, it is not mutable, pattern matching or a generator, and it can't be redefined: it is the only function with
+ * its name and is declared before any other statement of the program runs.
+ * The arguments replace the parameters in a copy of the returned expression. The copy keeps the source locations of
+ * the function body, so errors are reported where they were before. An argument that is not a literal or a variable
+ * is only substituted if it is evaluated exactly once and in the same order as before.
+ */
+class Inliner : public Pass
+{
+public:
+    /**
+     * @brief Largest number of nodes in a returned expression that is inlined.
+     */
+    static const size_t MAX_NODES = 24;
+
+    /**
+     * @brief Constructs the pass, named "inline".
+     */
+    Inliner();
+
+protected:
+    void prepare(Node* root) override;
+    Node* rewrite_call(CallNode* node) override;
+    Node* rewrite_pipe(PipeNode* node) override;
+
+private:
+    HashMap<String, FunctionNode*> candidates{}; ///< Functions that can be inlined by name
+
+    /**
+     * @brief Checks if the body of a function can be inlined.
+     * @param function The function to check
+     * @return bool True if the function can be inlined
+     */
+    bool is_inlinable(const FunctionNode* function) const;
+
+    /**
+     * @brief Copies the returned expression of a function, replacing its parameters with the arguments of a call.
+     * @param function The called function
+     * @param call The call to replace
+     * @return ExpressionNode* The copy, or nullptr if the call can't be inlined
+     */
+    ExpressionNode* substitute(const FunctionNode* function, const CallNode* call) const;
+
+    /**
+     * @brief Copies an expression.
+     * @param expr The expression to copy
+     * @param params The parameter names of the function
+     * @param args The arguments that replace the parameters, copied for every use
+     * @return ExpressionNode* The copy
+     */
+    ExpressionNode* copy(const ExpressionNode* expr, const Vector<Pair<TokenType, String>>& params,
+        const Vector<ExpressionNode*>& args) const;
+};
+
+} // namespace funk
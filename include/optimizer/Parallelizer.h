@@ -0,0 +1,44 @@
+/**
+ * @file Parallelizer.h
+ * @brief Defines the pass of the Funk optimizer that marks binary operations whose calls can run in parallel.
+ */
+#pragma once
+
+#include "optimizer/Pass.h"
+
+namespace funk
+{
+
+/**
+ * @brief Marks binary operations of two independent calls to pure functions for parallel evaluation.
+ * A function is pure if it only reads its parameters and its own declarations, only assigns its own declarations, and
+ * only calls pure functions. Like for inlining, all functions with its name must be declared before any other
+ * statement of the program runs and none of them may be mutable, so the call can't reach another function.
+ *
+ * Forking a call only pays off if it does enough work, so only calls to functions that may recurse or loop are
+ * parallel. Their arguments must be free of effects too, since they are evaluated before the left operand.
+ */
+class Parallelizer : public Pass
+{
+public:
+    /**
+     * @brief Constructs the pass, named "parallel".
+     */
+    Parallelizer();
+
+protected:
+    void prepare(Node* root) override;
+    Node* rewrite_binary_op(BinaryOpNode* node) override;
+
+private:
+    HashMap<String, bool> pure{}; ///< Pure functions by name, mapped to true if calls to them are worth forking
+
+    /**
+     * @brief Checks if an operand is a call to a pure function that is worth forking with arguments free of effects.
+     * @param expr The operand
+     * @return bool True if the call can be forked
+     */
+    bool is_forkable(const ExpressionNode* expr) const;
+};
+
+} // namespace funk
@@ -0,0 +1,58 @@
+/**
+ * @file Pass.h
+ * @brief Defines the base class of all optimization passes of the Funk optimizer.
+ */
+#pragma once
+
+#include "ast/NodeRewriter.h"
+#include "utils/Common.h"
+
+namespace funk
+{
+
+/**
+ * @brief A named rewrite over the whole AST that counts the nodes it changes.
+ * Passes are run by the PassManager between parsing and evaluation.
+ */
+class Pass : public NodeRewriter
+{
+public:
+    /**
+     * @brief Constructs a pass.
+     * @param name The name of the pass, used by --dump-after and in reports
+     */
+    explicit Pass(const String& name);
+
+    /**
+     * @brief Runs the pass over a tree.
+     * @param root The root of the tree
+     * @return Node* The root of the rewritten tree
+     */
+    Node* run(Node* root);
+
+    /**
+     * @brief Gets the name of the pass.
+     * @return const String& The name of the pass
+     */
+    const String& get_name() const;
+
+    /**
+     * @brief Gets the number of nodes that were changed by the last run.
+     * @return size_t Number of changed nodes
+     */
+    size_t get_changed() const;
+
+protected:
+    size_t changed{0}; ///< Number of nodes changed by the current run
+
+    /**
+     * @brief Prepares a run over a tree, clearing the state of a previous run.
+     * @param root The root of the tree that is about to be rewritten
+     */
+    virtual void prepare(Node* /* root */) {}
+
+private:
+    String name; ///< The name of the pass
+};
+
+} // namespace funk
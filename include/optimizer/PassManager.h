@@ -0,0 +1,101 @@
+/**
+ * @file PassManager.h
+ * @brief Defines the PassManager that runs the optimization passes of the Funk optimizer.
+ */
+#pragma once
+
+#include "optimizer/Pass.h"
+#include "utils/Common.h"
+
+namespace funk
+{
+
+/**
+ * @brief Runs the optimization passes between parsing and evaluation.
+ * The passes are chosen by the optimization level, each run is timed and its number of changed nodes recorded.
+ */
+class PassManager
+{
+public:
+    /**
+     * @brief Default optimization level.
+     */
+    static const int DEFAULT_LEVEL = 1;
+
+    /**
+     * @brief Highest optimization level.
+     */
+    static const int MAX_LEVEL = 2;
+
+    /**
+     * @brief Constructs a pass manager with the passes of an optimization level.
+     * Level 0 runs no passes, level 1 folds constants and removes dead code, level 2 also inlines small functions and
+     * folds constants again. With parallel set, calls to pure functions are marked for parallel evaluation last.
+     * @param level The optimization level, between 0 and MAX_LEVEL
+     * @param parallel True to run the parallel pass
+     */
+    explicit PassManager(int level = DEFAULT_LEVEL, bool parallel = false);
+
+    /**
+     * @brief Deletes all registered passes.
+     */
+    ~PassManager();
+
+    PassManager(const PassManager&) = delete;
+    PassManager& operator=(const PassManager&) = delete;
+
+    /**
+     * @brief Registers a pass to run after the already registered passes.
+     * @param pass The pass, owned by the pass manager
+     */
+    void add(Pass* pass);
+
+    /**
+     * @brief Checks if a pass with the given name is registered.
+     * @param name The name of the pass
+     * @return bool True if the pass is registered
+     */
+    bool has_pass(const String& name) const;
+
+    /**
+     * @brief Gets the names of the registered passes in the order they run.
+     * @return Vector<String> The names of the passes
+     */
+    Vector<String> get_pass_names() const;
+
+    /**
+     * @brief Logs the tree after a pass has run, the same way as --ast does.
+     * @param name The name of the pass
+     */
+    void dump_after(const String& name);
+
+    /**
+     * @brief Runs all registered passes over a tree.
+     * @param root The root of the tree
+     * @return Node* The root of the optimized tree
+     */
+    Node* run(Node* root);
+
+    /**
+     * @brief Formats the timing and changed nodes of every pass of the last run.
+     * @return String Multi-line report
+     */
+    String report() const;
+
+private:
+    /**
+     * @brief Timing and result of a single pass.
+     */
+    struct PassResult
+    {
+        String name;         ///< Name of the pass
+        double milliseconds; ///< Time taken by the pass
+        size_t changed;      ///< Number of nodes changed by the pass
+    };
+
+    Vector<Pass*> passes{};       ///< Registered passes in the order they run
+    Vector<PassResult> results{}; ///< Results of the last run
+    String dump{};                ///< Name of the pass to dump the tree after, empty for none
+};
+
+} // namespace funk
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "ast/expression/CallNode.h"
+#include "ast/expression/ListNode.h"
 #include "ast/expression/LiteralNode.h"
+#include "ast/expression/StreamNode.h"
+#include "io/Reader.h"
+#include "io/Writer.h"
 #include "logging/LogMacros.h"
+#include "runtime/Channel.h"
 
 namespace funk
 {
@@ -16,8 +21,22 @@ class BuiltIn
 public:
     static Node* print(const CallNode& call, const Vector<ExpressionNode*>& args);
     static Node* read(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* read_all(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* read_lines(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* stdin_lines(const CallNode& call, const Vector<ExpressionNode*>& args);
     static Node* fast_exit(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* flush(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* write_file(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* append_file(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* channel(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* send(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* recv(const CallNode& call, const Vector<ExpressionNode*>& args);
+    static Node* close(const CallNode& call, const Vector<ExpressionNode*>& args);
 
     static HashMap<String, Node* (*)(const CallNode&, const Vector<ExpressionNode*>&)> functions;
+
+private:
+    static Node* to_file(const CallNode& call, const Vector<ExpressionNode*>& args, bool append);
+    static std::shared_ptr<Channel> to_channel(const CallNode& call, ExpressionNode* arg);
 };
 } // namespace funk
@@ -10,14 +10,18 @@
 #include "ast/Node.h"
 #include "ast/control/IfNode.h"
 #include "ast/control/WhileNode.h"
+#include "ast/control/YieldNode.h"
 #include "ast/declaration/DeclarationNode.h"
 #include "ast/expression/AssignmentNode.h"
+#include "ast/expression/AwaitNode.h"
 #include "ast/expression/BinaryOpNode.h"
 #include "ast/expression/CallNode.h"
 #include "ast/expression/ListNode.h"
+#include "ast/expression/MapNode.h"
 #include "ast/expression/LiteralNode.h"
 #include "ast/expression/MethodCallNode.h"
 #include "ast/expression/PipeNode.h"
+#include "ast/expression/SpawnNode.h"
 #include "ast/expression/UnaryOpNode.h"
 #include "ast/expression/VariableNode.h"
 #include "lexer/Lexer.h"
@@ -69,10 +73,20 @@ public:
      */
     static Parser load(String filename);
 
+    /**
+     * @brief Creates the declaration of the ARGS variable that holds the arguments passed to a program
+     * @param args The arguments passed to the program
+     * @param filename The name of the source file
+     * @return Node* The declaration, owned by the caller
+     */
+    static Node* declare_args(const Vector<String>& args, const String& filename);
+
 private:
     Vector<Token> tokens; ///< The token stream to parse
     String filename;      ///< The name of the source file
     int index{0};         ///< Current index in the token stream
+    int functions{0};     ///< Number of function bodies the parser is in
+    bool yields{false};   ///< True if the innermost function body has a yield statement
 
     /**
      * @brief Advances the index and returns the token at the new index
@@ -149,6 +163,13 @@ private:
      */
     Node* parse_function_declaration(bool is_mutable);
 
+    /**
+     * @brief Parses the body of a function
+     * @param generator Set to true if the body has a yield statement
+     * @return BlockNode* The AST node representing the body
+     */
+    BlockNode* parse_function_body(bool& generator);
+
     /**
      * @brief Parses a block of statements
      * @return Node* The AST node representing the block
@@ -179,6 +200,12 @@ private:
      */
     Node* parse_return();
 
+    /**
+     * @brief Parses a yield statement, which makes the function it is in a generator
+     * @return Node* The AST node representing the yield statement
+     */
+    Node* parse_yield();
+
     /**
      * @brief Parses an expression
      * @return Node* The AST node representing the expression
@@ -234,7 +261,7 @@ private:
     Node* parse_multiplicative();
 
     /**
-     * @brief Parses a unary expression
+     * @brief Parses a unary expression, including spawning and awaiting tasks
      * @return Node* The AST node representing the unary expression
      */
     Node* parse_unary();
@@ -274,5 +301,11 @@ private:
      * @return Node* The AST node representing the list expression
      */
     Node* parse_list();
+
+    /**
+     * @brief Parses a map literal, like { "a": 1, "b": 2 }
+     * @return Node* The AST node representing the map literal
+     */
+    Node* parse_map();
 };
 } // namespace funk
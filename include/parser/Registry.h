@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ast/declaration/FunctionNode.h"
+#include <memory>
+#include <shared_mutex>
 
 namespace funk
 {
@@ -10,10 +12,23 @@ namespace funk
  */
 class FunctionNode;
 
+// Functions are shared by all tasks. The overloads of a name are copied on write, so a lookup only holds the lock
+// while it finds them and not while it matches patterns, which evaluates the arguments.
 class Registry
 {
 public:
+    // Gets the registry of the calling thread, the one of the program it runs or else the global one
     static Registry& instance();
+    // Makes a registry the one of the calling thread, returns the previous one or nullptr for the global one
+    static Registry* enter(Registry* registry);
+    // Checks if the calling thread runs a program with a registry of its own, one that shares the process with others
+    static bool is_isolated() { return current != nullptr; }
+
+    // Programs that run side by side in one process get registries of their own
+    Registry() = default;
+    ~Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
 
     bool add_function(FunctionNode* node);
     FunctionNode* get_function(const String& identifier, const Vector<ExpressionNode*>& arguments) const;
@@ -21,10 +36,14 @@ public:
     bool contains(const String& identifier) const;
 
 private:
-    Registry() = default;
-    ~Registry() = default;
+    using Overloads = std::shared_ptr<const Vector<FunctionNode*>>;
+
+    Overloads get_overloads(const String& identifier) const;
+
+    static thread_local Registry* current; ///< Registry of the program run by the thread, nullptr for the global one
 
-    HashMap<String, Vector<FunctionNode*>> functions;
+    HashMap<String, Overloads> functions;
+    mutable std::shared_mutex lock;
 };
 
 } // namespace funk
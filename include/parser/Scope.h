@@ -12,21 +12,62 @@ namespace funk
 class Scope
 {
 public:
+    // Gets the scope stack of the calling thread, the one of the task it runs or else the global one
     static Scope& instance();
+    // Makes a scope stack the one of the calling thread, returns the previous one or nullptr for the global one
+    static Scope* enter(Scope* scope);
     static const int MAX_DEPTH = 1000;
 
-    void push();
+    // Tasks get scope stacks of their own, the global one is only used through instance()
+    Scope();
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // Pushes a new scope with room for the given number of symbols
+    void push(size_t slots = 0);
     void pop();
 
     void add(const String& name, Node* node);
     Node* get(const String& name) const;
     bool contains(const String& name) const;
     bool contains_in_current_scope(const String& name) const;
+    int get_depth() const { return depth; }
+    // Gets all symbols visible from the current scope, a symbol hides those with the same name in outer scopes
+    Vector<Pair<String, Node*>> visible() const;
+    // Pushes a scope with the symbols visible in the scope stack of the calling thread. Variables holding a value are
+    // copied, the copies are added to copies and owned by the caller. Functions and other nodes are shared.
+    void capture(Vector<Node*>& copies);
 
 private:
-    Scope();
-    ~Scope();
-    Vector<HashMap<String, Node*>> scopes;
+    // Symbols of one scope. Small scopes are searched linearly, an index is only built for large ones.
+    // Clearing keeps the capacity, so a recycled frame doesn't allocate for names that fit in it.
+    class Frame
+    {
+    public:
+        static const size_t INDEX_THRESHOLD = 16;
+
+        Node* find(const String& name) const;
+        void set(const String& name, Node* node);
+        void reserve(size_t slots);
+        void clear();
+        void delete_nodes();
+        size_t count() const { return size; }
+        const Pair<String, Node*>& at(size_t i) const { return symbols[i]; }
+
+    private:
+        Vector<Pair<String, Node*>> symbols;
+        HashMap<String, size_t> index;
+        size_t size{0};
+    };
+
+    static thread_local Scope* current; ///< Scope stack of the task run by the thread, nullptr for the global one
+
+    // Gets the node a captured symbol is added as, a copy for variables holding a value and otherwise the node itself
+    static Node* capture(Node* node, Vector<Node*>& copies);
+
+    // Frames [0, depth) are in use, the rest are kept for reuse by later pushes
+    Vector<Frame> frames;
     int depth{0};
 };
 
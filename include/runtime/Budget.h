@@ -0,0 +1,152 @@
+/**
+ * @file Budget.h
+ * @brief Defines the Budget that limits the steps, memory and time of a run.
+ */
+#pragma once
+
+#include "utils/Common.h"
+#include "utils/Exception.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace funk
+{
+
+/**
+ * @brief Limits on the work of a run, checked while it runs.
+ * A step is a loop iteration or a function call, and memory is the size of the nodes and values that a run allocated
+ * and didn't release yet. Threads count both in counters of their own and charge them to the budget they work for
+ * every CHECK_INTERVAL steps, which is also when the clock is read, so a step stays a decrement and a limit is noticed
+ * at most CHECK_INTERVAL steps late. Once a limit is exceeded every check of the run fails with a RuntimeError.
+ *
+ * The same countdown ends the slices of fibers. Like scope stacks and registries, a budget is entered by the threads
+ * that work for its run: tasks keep the budget of the code that spawned them and fibers put theirs aside while they
+ * are suspended.
+ */
+class Budget
+{
+public:
+    /**
+     * @brief Limits of a run, a limit of 0 is no limit.
+     */
+    struct Limits
+    {
+        uint64_t steps{0};                    ///< Loop iterations and calls that a run may take
+        uint64_t memory{0};                   ///< Bytes of nodes and values that a run may hold
+        std::chrono::milliseconds timeout{0}; ///< Wall-clock time that a run may take
+
+        /**
+         * @brief Checks if any limit is set.
+         * @return bool True if a run with these limits needs a budget
+         */
+        bool any() const { return steps > 0 || memory > 0 || timeout.count() > 0; }
+    };
+
+    static const uint64_t CHECK_INTERVAL = 1024; ///< Steps between two charges of the counters of a thread
+
+    /**
+     * @brief Creates a budget, its clock starts right away.
+     * @param limits The limits of the run
+     */
+    explicit Budget(const Limits& limits);
+
+    Budget(const Budget&) = delete;
+    Budget& operator=(const Budget&) = delete;
+
+    /**
+     * @brief Makes a budget the one of the calling thread, charging the counts of the thread to the previous one.
+     * @param budget The budget, or nullptr for none
+     * @return Budget* The previous budget, or nullptr if there was none
+     */
+    static Budget* enter(Budget* budget);
+
+    /**
+     * @brief Gets the budget of the calling thread.
+     * @return Budget* The budget, or nullptr if the thread works without one
+     */
+    static Budget* get_current() { return current; }
+
+    /**
+     * @brief Counts a step of the calling thread, checking the limits once every CHECK_INTERVAL steps.
+     * @param location Location of the loop or call, reported if a limit is exceeded
+     * @throws RuntimeError if the budget of the thread is exceeded
+     */
+    static void step(const SourceLocation& location)
+    {
+        if (--countdown == 0) { checkpoint(location); }
+    }
+
+    /**
+     * @brief Counts memory allocated by the calling thread.
+     * @param bytes Number of bytes
+     */
+    static void allocated(size_t bytes) { unsettled_bytes += static_cast<int64_t>(bytes); }
+
+    /**
+     * @brief Counts memory released by the calling thread.
+     * @param bytes Number of bytes
+     */
+    static void released(size_t bytes) { unsettled_bytes -= static_cast<int64_t>(bytes); }
+
+    /**
+     * @brief Restarts the countdown of the calling thread, after the budget or the fiber it runs changed.
+     */
+    static void arm();
+
+    /**
+     * @brief Gets the steps charged to the budget.
+     * @return uint64_t Number of steps
+     */
+    uint64_t get_steps() const { return steps.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the memory charged to the budget.
+     * @return int64_t Number of bytes, negative if the run released memory allocated before it started
+     */
+    int64_t get_memory() const { return memory.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the time since the budget was created.
+     * @return std::chrono::milliseconds The elapsed time
+     */
+    std::chrono::milliseconds get_elapsed() const;
+
+    /**
+     * @brief Describes what the run used so far.
+     * @return String The steps, time and memory
+     */
+    String usage() const;
+
+private:
+    static thread_local Budget* current;         ///< Budget of the run the thread works for, nullptr for none
+    static thread_local uint64_t countdown;      ///< Steps left before the next checkpoint
+    static thread_local uint64_t armed;          ///< Steps the countdown started from
+    static thread_local int64_t unsettled_bytes; ///< Memory allocated less memory released since the last charge
+
+    Limits limits;                                 ///< Limits of the run
+    std::chrono::steady_clock::time_point started; ///< When the budget was created
+    std::atomic<uint64_t> steps{0};                ///< Steps charged so far
+    std::atomic<int64_t> memory{0};                ///< Memory charged so far
+
+    /**
+     * @brief Charges the steps of the countdown, checks the limits and ends the slice of the running fiber.
+     * @param location Location of the loop or call that took the last step
+     */
+    static void checkpoint(const SourceLocation& location);
+
+    /**
+     * @brief Charges the counts of the calling thread to its budget, if any, and clears them.
+     * @param used Steps taken since the countdown was armed
+     */
+    static void settle(uint64_t used);
+
+    /**
+     * @brief Checks the limits against what was charged.
+     * @param location Location reported if a limit is exceeded
+     * @throws RuntimeError if a limit is exceeded
+     */
+    void check(const SourceLocation& location) const;
+};
+
+} // namespace funk
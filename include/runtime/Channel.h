@@ -0,0 +1,160 @@
+/**
+ * @file Channel.h
+ * @brief Defines the Channel object that tasks pass values through.
+ */
+#pragma once
+
+#include "ast/NodeValue.h"
+#include "runtime/Object.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace funk
+{
+
+/**
+ * @brief Bounded first-in first-out queue of values shared by tasks.
+ * The values are kept in a ring of slots that senders and receivers claim with atomic counters, so neither side takes
+ * a lock while the channel is neither full nor empty. With a single sender and a single receiver every claim succeeds
+ * at once. A sender blocks while the channel is full and a receiver while it is empty. The ring has at least two slots,
+ * as a single slot would be ready for the next send the moment it is filled, so a channel of one value also checks how
+ * many values it holds before a send.
+ *
+ * The first value sent fixes the type of the channel. After close() no values can be sent, but those already in the
+ * channel can still be received. A send that checked the channel was open before close() is still delivered: senders
+ * count themselves in sending until their value is stored, and receivers only take a closed channel for ended once
+ * it is empty and no send is under way.
+ */
+class Channel : public Object
+{
+public:
+    /**
+     * @brief Capacity of channels created without one.
+     */
+    static const size_t DEFAULT_CAPACITY = 64;
+
+    /**
+     * @brief Constructs an empty channel.
+     * @param capacity Number of values the channel holds before senders block, at least one
+     */
+    explicit Channel(size_t capacity = DEFAULT_CAPACITY);
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    /**
+     * @brief Gets the channel a value refers to.
+     * @param value The value
+     * @return std::shared_ptr<Channel> The channel, or nullptr if the value is not a channel
+     */
+    static std::shared_ptr<Channel> from(const NodeValue& value);
+
+    /**
+     * @brief Gets the TokenType of channel values.
+     * @return TokenType::CHANNEL
+     */
+    TokenType get_token_type() const override { return TokenType::CHANNEL; }
+
+    /**
+     * @brief Converts the channel to a string representation.
+     * @return String representation of the channel
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Sends a value, blocking while the channel is full.
+     * @param value The value to send
+     * @throws TypeError if the value has another type than the values sent before, or is none
+     * @throws RuntimeError if the channel is closed
+     */
+    void send(const NodeValue& value);
+
+    /**
+     * @brief Receives the oldest value, blocking while the channel is empty and open.
+     * @param value Receives the value
+     * @return bool False if the channel is closed and empty
+     */
+    bool recv(NodeValue& value);
+
+    /**
+     * @brief Checks if the channel has no more values, blocking while it is empty and open.
+     * With a single receiver, a recv() after a check that gave false gets a value without blocking.
+     * @return bool True if the channel is closed and empty
+     */
+    bool is_done();
+
+    /**
+     * @brief Closes the channel and wakes all blocked senders and receivers.
+     */
+    void close();
+
+    /**
+     * @brief Checks if the channel is closed.
+     * @return bool True after close()
+     */
+    bool is_closed() const { return closed.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Gets the number of values the channel holds before senders block.
+     * @return size_t The capacity
+     */
+    size_t get_capacity() const { return capacity; }
+
+private:
+    /**
+     * @brief Slot of the ring.
+     * The sequence tells whose turn it is: it equals the position of the next send into the slot while the slot is
+     * free, and that position plus one once the value is stored.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0}; ///< Position the slot is ready for
+        NodeValue value{};               ///< Value stored in the slot
+    };
+
+    size_t capacity;                              ///< Number of values the channel holds
+    size_t ring;                                  ///< Number of slots, at least two
+    std::unique_ptr<Slot[]> slots;                ///< Ring of slots
+    std::atomic<size_t> head{0};                  ///< Position of the next receive
+    std::atomic<size_t> tail{0};                  ///< Position of the next send
+    std::atomic<bool> closed{false};              ///< True after close()
+    std::atomic<size_t> sending{0};               ///< Number of sends between their check of closed and their store
+    std::atomic<TokenType> type{TokenType::NONE}; ///< Type of the values, NONE until the first send
+
+    std::atomic<int> waiting{0};     ///< Number of threads blocked on the channel
+    std::mutex lock;                 ///< Used by blocked threads to wait
+    std::condition_variable changed; ///< Notified when a value is sent or received, or the channel closed
+
+    /**
+     * @brief Stores a value unless the channel is full.
+     * @return bool True if the value was stored
+     */
+    bool try_send(const NodeValue& value);
+
+    /**
+     * @brief Takes the oldest value unless the channel is empty.
+     * @return bool True if a value was taken
+     */
+    bool try_recv(NodeValue& value);
+
+    /**
+     * @brief Checks if the channel is closed and holds no value, nor will once the sends under way are stored.
+     * @return bool True if the channel has ended
+     */
+    bool has_ended() const;
+
+    /**
+     * @brief Blocks the calling thread until it can continue.
+     * @param ready Checks if the thread can continue
+     */
+    template <typename Ready> void block(Ready ready);
+
+    /**
+     * @brief Wakes the blocked threads, if there are any.
+     */
+    void notify();
+};
+
+} // namespace funk
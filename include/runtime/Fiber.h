@@ -0,0 +1,116 @@
+/**
+ * @file Fiber.h
+ * @brief Defines the Fiber that suspends a running program at its preemption points.
+ */
+#pragma once
+
+#include "utils/Common.h"
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <ucontext.h>
+
+namespace funk
+{
+
+class Budget;
+class Reader;
+class Registry;
+class Scope;
+class Writer;
+
+/**
+ * @brief Green thread that runs a body on a stack of its own and gives up its thread after a number of steps.
+ * The interpreter counts a step at every loop iteration and function call, see Budget::step(). A fiber is resumed with
+ * a slice of steps, and once the slice is used the fiber is suspended and returns to the thread that resumed it, so a
+ * loop that never ends can't keep other fibers from running.
+ *
+ * The scope stack, registry, budget, reader and writer that the body entered are put aside while the fiber is suspended. Everything
+ * else the thread keeps, like its statistics, is shared by all fibers it runs, so a fiber must always be resumed by
+ * the same thread.
+ */
+class Fiber
+{
+public:
+    using Body = std::function<void()>;
+
+    static const size_t STACK_SIZE = 8 * 1024 * 1024; ///< Bytes reserved for the stack, only used pages are committed
+
+    /**
+     * @brief Creates a fiber that runs a body once it is resumed.
+     * @param body The code to run, errors it throws are rethrown by resume()
+     */
+    explicit Fiber(Body body);
+
+    /**
+     * @brief Releases the stack, the fiber must not be suspended in the middle of its body.
+     */
+    ~Fiber();
+
+    Fiber(const Fiber&) = delete;
+    Fiber& operator=(const Fiber&) = delete;
+
+    /**
+     * @brief Runs the body until it is done or it used a slice of steps.
+     * @param slice Number of steps the body may take before it is suspended, at least one
+     * @throws The error that the body failed with
+     */
+    void resume(uint64_t slice);
+
+    /**
+     * @brief Checks if the body has finished, successfully or not.
+     * @return bool True if the fiber can't be resumed anymore
+     */
+    bool is_done() const { return done; }
+
+    /**
+     * @brief Gets the steps left in the slice of the running fiber.
+     * @return uint64_t Number of steps, UINT64_MAX outside of fibers
+     */
+    static uint64_t remaining();
+
+    /**
+     * @brief Counts steps against the slice of the running fiber, a used slice starts over for the next turn.
+     * @param steps Number of steps, at most the remaining ones
+     * @return bool True if the slice was used and the fiber should be suspended
+     */
+    static bool elapse(uint64_t steps);
+
+    /**
+     * @brief Suspends the running fiber until it is resumed, does nothing outside of fibers.
+     */
+    static void suspend();
+
+    /**
+     * @brief Gets the fiber that the calling thread runs.
+     * @return Fiber* The fiber, or nullptr outside of fibers
+     */
+    static Fiber* get_running() { return running; }
+
+private:
+    static thread_local Fiber* running;      ///< Fiber that the thread runs, nullptr outside of fibers
+    static thread_local uint64_t slice_left; ///< Steps left before the running fiber is suspended
+
+    Body body;                          ///< Code that the fiber runs
+    void* stack{nullptr};               ///< Lowest address of the stack, below it is a guard page
+    ucontext_t context{};               ///< Registers of the suspended fiber
+    ucontext_t caller{};                ///< Registers of the thread that resumed the fiber
+    const void* caller_bottom{nullptr}; ///< Stack of the thread that resumed the fiber, for the address sanitizer
+    size_t caller_size{0};              ///< Size of the stack of the thread that resumed the fiber
+    Scope* scope{nullptr};              ///< Scope stack of the suspended fiber, nullptr for the global one
+    Registry* registry{nullptr};        ///< Registry of the suspended fiber, nullptr for the global one
+    Budget* budget{nullptr};            ///< Budget of the suspended fiber, nullptr for none
+    Reader* reader{nullptr};            ///< Reader of the suspended fiber, nullptr for the standard input one
+    Writer* writer{nullptr};            ///< Writer of the suspended fiber, nullptr for the standard output one
+    uint64_t slice{0};                  ///< Steps in the current turn of the fiber
+    bool started{false};                ///< True once the body was entered
+    bool done{false};                   ///< True once the body has returned or thrown
+    std::exception_ptr error{};         ///< Error that the body failed with, if any
+
+    /**
+     * @brief Entry point of the stack, runs the body of the fiber that the thread resumed.
+     */
+    static void start();
+};
+
+} // namespace funk
@@ -0,0 +1,125 @@
+/**
+ * @file Generator.h
+ * @brief Defines the Generator object that calling a function with yield statements creates.
+ */
+#pragma once
+
+#include "ast/control/WhileNode.h"
+#include "ast/declaration/FunctionNode.h"
+#include "parser/Scope.h"
+#include "runtime/Object.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace funk
+{
+
+/**
+ * @brief Lazy sequence of the values a function yields.
+ * The body of the function only runs when the next value is pulled, up to the next yield statement. Where it stopped
+ * is kept on the heap instead of the native stack: a stack of frames holds the position in every block the body is
+ * in, and a scope stack of its own holds the variables. Only blocks, if and while statements are run frame by frame,
+ * so yield statements may appear in them but not in expressions. Other statements, including calls, run to completion
+ * as usual.
+ *
+ * Like a task, a generator starts with a copy of the variables visible where it was created, followed by its
+ * parameters. The sequence ends when the body ends or runs a return statement.
+ */
+class Generator : public Object
+{
+public:
+    /**
+     * @brief Constructs a generator that has not run any of the function body yet.
+     * @param function The function, owned by the program
+     * @param arguments Values of the parameters of the function
+     */
+    Generator(const FunctionNode* function, const Vector<NodeValue>& arguments);
+
+    /**
+     * @brief Deletes the variables of the function body and the copies of the captured variables.
+     */
+    ~Generator() override;
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    /**
+     * @brief Gets the generator a value refers to.
+     * @param value The value
+     * @return std::shared_ptr<Generator> The generator, or nullptr if the value is not a generator
+     */
+    static std::shared_ptr<Generator> from(const NodeValue& value);
+
+    /**
+     * @brief Gets the TokenType of generator values.
+     * @return TokenType::GENERATOR
+     */
+    TokenType get_token_type() const override { return TokenType::GENERATOR; }
+
+    /**
+     * @brief Converts the generator to a string representation.
+     * @return String representation of the generator
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Runs the function body up to the next yield statement.
+     * @param value Receives the yielded value
+     * @return bool False if the body ended without yielding another value
+     * @throws The error that the function body failed with, which also ends the sequence
+     */
+    bool next(NodeValue& value);
+
+    /**
+     * @brief Checks if the sequence has ended, running the body up to the next yield statement to find out.
+     * @return bool True if next() will not produce another value
+     */
+    bool is_done();
+
+private:
+    /**
+     * @brief Position in one block of the function body.
+     */
+    struct Frame
+    {
+        Vector<Node*> statements{};     ///< Statements of the block
+        size_t next{0};                 ///< Index of the next statement to run
+        size_t slots{0};                ///< Number of symbols the block declares
+        bool scoped{false};             ///< True if a scope was pushed for the block
+        const WhileNode* loop{nullptr}; ///< The loop whose body the block is, run again while its condition holds
+    };
+
+    const FunctionNode* function; ///< Function whose body is run
+    Scope scope;                  ///< Scope stack the body is run on
+    Vector<Node*> owned{};        ///< Parameters and copies of the captured variables, owned by the generator
+    Vector<Frame> frames{};       ///< Blocks the body is in, innermost last
+    int base_depth{0};            ///< Depth of the scope stack with the captured variables and the parameters
+
+    NodeValue peeked{};        ///< Value yielded ahead of next() by is_done()
+    bool has_peeked{false};    ///< True if peeked holds a value not returned by next() yet
+    bool running{false};       ///< True while the body runs, a generator can't resume itself
+    std::recursive_mutex lock; ///< Serializes resuming the generator, held by the thread running the body
+
+    /**
+     * @brief Runs the body until it yields a value or ends.
+     * @param value Receives the yielded value
+     * @return bool False if the body ended
+     */
+    bool resume(NodeValue& value);
+
+    /**
+     * @brief Enters a block, pushing a scope if it declares symbols.
+     * @param statements Statements of the block
+     * @param slots Number of symbols the block declares
+     * @param loop The loop whose body the block is, if any
+     */
+    void enter(const Vector<Node*>& statements, size_t slots, const WhileNode* loop = nullptr);
+
+    /**
+     * @brief Leaves the innermost block, popping its scope.
+     */
+    void leave();
+};
+
+} // namespace funk
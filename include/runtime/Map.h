@@ -0,0 +1,225 @@
+/**
+ * @file Map.h
+ * @brief Defines the Map object that map literals create.
+ */
+#pragma once
+
+#include "ast/NodeValue.h"
+#include "runtime/Object.h"
+#include <memory>
+
+namespace funk
+{
+
+/**
+ * @brief Hash table from keys to values, kept in insertion order.
+ * The table is split in two like the dictionaries of CPython: the entries are stored in insertion order in one
+ * array, and an open addressing index of 32-bit slots, probed linearly, points into it. The index is small enough
+ * that a probe rarely leaves its cache line, and iterating walks the entries without touching the index. Removing a
+ * key leaves a hole in the entries that the next resize of the index compacts.
+ *
+ * Updated copies, made by with() and without(), hold their entries in a hash array mapped trie instead: a tree of
+ * nodes with up to 32 children, indexed by five bits of the hash at each level. A copy only replaces the nodes on the
+ * path to the changed key and shares all others with the map it was made from, so it takes O(log n) time and memory.
+ * A node that only one map holds is changed in place instead of being copied. A map keeps the trie of its table once
+ * it was made, so that further copies of the same map are cheap, and goes back to a table when it is changed in place.
+ *
+ * The first key and value fix the types of all keys and values, neither may be none. Numbs and texts are hashed and
+ * compared directly, other keys compare like ==, except that objects compare by identity.
+ *
+ * A map is not synchronized: values that share a map must not change it, a changed map is copied first (see
+ * LiteralNode::own_map()). Copies made by with() and without() may be made from a shared map.
+ */
+class Map : public Object
+{
+public:
+    /**
+     * @brief Constructs an empty map.
+     */
+    Map() = default;
+
+    /**
+     * @brief Copies the entries of another map, sharing its trie if it has one.
+     * @param other The map to copy
+     */
+    Map(const Map& other);
+
+    /**
+     * @brief Releases the memory of the table from the budget of the run.
+     */
+    ~Map() override;
+
+    Map& operator=(const Map&) = delete;
+
+    /**
+     * @brief Gets the map a value refers to.
+     * @param value The value
+     * @return std::shared_ptr<Map> The map, or nullptr if the value is not a map
+     */
+    static std::shared_ptr<Map> from(const NodeValue& value);
+
+    /**
+     * @brief Gets the TokenType of map values.
+     * @return TokenType::MAP
+     */
+    TokenType get_token_type() const override { return TokenType::MAP; }
+
+    /**
+     * @brief Converts the map to a string representation, the entries in insertion order.
+     * @return String representation of the map, like { "a": 1, "b": 2 }
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Looks up the value of a key.
+     * @param key The key
+     * @return const NodeValue* The value, or nullptr if the map has no such key
+     */
+    const NodeValue* find(const NodeValue& key) const;
+
+    /**
+     * @brief Sets the value of a key, adding the key after all others if it is new.
+     * @param key The key
+     * @param value The value
+     * @throws TypeError if the key or value is none or not of the type of the other keys or values
+     */
+    void set(const NodeValue& key, const NodeValue& value);
+
+    /**
+     * @brief Removes a key and its value.
+     * @param key The key
+     * @return bool False if the map has no such key
+     */
+    bool remove(const NodeValue& key);
+
+    /**
+     * @brief Makes a copy with the value of a key set, sharing all other entries with this map.
+     * @param key The key
+     * @param value The value
+     * @return std::shared_ptr<Map> The copy
+     * @throws TypeError if the key or value is none or not of the type of the other keys or values
+     */
+    std::shared_ptr<Map> with(const NodeValue& key, const NodeValue& value) const;
+
+    /**
+     * @brief Makes a copy without a key, sharing all other entries with this map.
+     * @param key The key
+     * @return std::shared_ptr<Map> The copy
+     */
+    std::shared_ptr<Map> without(const NodeValue& key) const;
+
+    /**
+     * @brief Gets the number of keys.
+     * @return size_t The number of keys
+     */
+    size_t size() const { return count; }
+
+    /**
+     * @brief Gets a map to iterate over with next(), which only maps with a table support.
+     * @param map The map to iterate over
+     * @return std::shared_ptr<Map> The map itself, or a copy with a table if its entries are in a trie
+     */
+    static std::shared_ptr<Map> iterable(const std::shared_ptr<Map>& map);
+
+    /**
+     * @brief Gets the entry at or after a position in insertion order, for iterating over the map.
+     * @param position Position to start at, receives the position after the entry
+     * @param key Receives the key
+     * @param value Receives the value
+     * @return bool False if there are no more entries, or if the entries are in a trie
+     */
+    bool next(size_t& position, NodeValue& key, NodeValue& value) const;
+
+private:
+    /**
+     * @brief Key and value with the hash of the key, a removed entry holds none.
+     */
+    struct Entry
+    {
+        NodeValue key{};   ///< The key
+        NodeValue value{}; ///< The value
+        uint64_t hash{0};  ///< Hash of the key
+        uint64_t order{0}; ///< Position in insertion order, only kept in tries
+    };
+
+    /**
+     * @brief Node of a hash array mapped trie, defined in Map.cc.
+     */
+    struct Trie;
+    using TrieRef = std::shared_ptr<Trie>;
+
+    static constexpr int32_t EMPTY = -1;   ///< Index slot that never held an entry, ends a probe
+    static constexpr int32_t REMOVED = -2; ///< Index slot whose entry was removed, probes continue past it
+    static constexpr size_t MIN_SLOTS = 8; ///< Size of the index of a map with few keys
+
+    Vector<Entry> entries{};               ///< Entries in insertion order
+    Vector<int32_t> slots{};               ///< Index into entries, a power of two in size
+    size_t count{0};                       ///< Number of entries that are not removed
+    TokenType key_type{TokenType::NONE};   ///< Type of the keys, fixed by the first key
+    TokenType value_type{TokenType::NONE}; ///< Type of the values, fixed by the first value
+    size_t bytes{0};                       ///< Memory of the table counted against the budget
+    bool persistent{false};                ///< True if the entries are in the trie instead of the table
+    mutable TrieRef root{};                ///< The trie, or the trie made of the table if persistent is false
+    uint64_t next_order{0};                ///< Position in insertion order of the next new key of the trie
+
+    /**
+     * @brief Hashes a key, equal keys hash equally.
+     */
+    static uint64_t hash(const NodeValue& key);
+
+    /**
+     * @brief Checks if two keys are the same key.
+     */
+    static bool same(const NodeValue& lhs, const NodeValue& rhs);
+
+    /**
+     * @brief Finds the index slot that points to the entry of a key.
+     * @return size_t Position of the slot, or slots.size() if the map has no such key
+     */
+    size_t probe(const NodeValue& key, uint64_t key_hash) const;
+
+    /**
+     * @brief Compacts the entries and rebuilds the index with room for a number of keys.
+     * @param capacity Number of keys the index must have room for
+     */
+    void rehash(size_t capacity);
+
+    /**
+     * @brief Counts a change in the memory of the table against the budget of the run.
+     */
+    void count_memory();
+
+    /**
+     * @brief Checks that a key and value may be stored in the map.
+     * @throws TypeError if the key or value is none or not of the type of the other keys or values
+     */
+    void check(const NodeValue& key, const NodeValue& value) const;
+
+    /**
+     * @brief Adds a new key to the table, which must not have the key already.
+     */
+    void insert(const NodeValue& key, const NodeValue& value, uint64_t key_hash);
+
+    /**
+     * @brief Gets the trie of the entries, making it from the table the first time.
+     */
+    TrieRef get_trie() const;
+
+    /**
+     * @brief Moves the entries from the trie back into a table, to change them in place.
+     */
+    void thaw();
+
+    /**
+     * @brief Starts a copy that is changed in the trie, sharing the trie of this map.
+     */
+    std::shared_ptr<Map> persistent_copy() const;
+
+    // Operations on tries, shift is the position in the hash of the bits that index the children of a node
+    static const NodeValue* find_in(const Trie* node, const NodeValue& key, uint64_t key_hash, unsigned shift);
+    static bool insert_into(TrieRef& node, Entry entry, unsigned shift);
+    static void erase_from(TrieRef& node, const NodeValue& key, uint64_t key_hash, unsigned shift);
+    static void collect(const Trie* node, Vector<const Entry*>& out);
+};
+
+} // namespace funk
@@ -0,0 +1,74 @@
+/**
+ * @file Multiplexer.h
+ * @brief Defines the Multiplexer that runs many programs as fibers on a few threads.
+ */
+#pragma once
+
+#include "runtime/Fiber.h"
+#include "utils/Common.h"
+#include "utils/Stats.h"
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace funk
+{
+
+/**
+ * @brief Runs bodies as fibers on a fixed number of threads, taking turns by slices of steps.
+ * Every thread keeps the fibers it started in a round-robin queue: it resumes the one at the front for a slice and
+ * puts it back at the end unless it is done. Before each turn a thread starts one more body from the shared queue,
+ * so waiting bodies are started soon while started ones keep getting their turns. A body that finishes within a
+ * slice waits at most one slice for every fiber ahead of it on its thread.
+ *
+ * Fibers stay on the thread that started them. A body that blocks, on a task or a channel, blocks the other fibers of
+ * its thread until it continues.
+ */
+class Multiplexer
+{
+public:
+    static const uint64_t DEFAULT_SLICE = 10000; ///< Steps a fiber takes before another one gets a turn
+
+    /**
+     * @brief Creates a multiplexer without bodies.
+     * @param threads Number of threads that run the fibers, at least one
+     * @param slice Number of steps in a turn, at least one
+     */
+    Multiplexer(size_t threads, uint64_t slice = DEFAULT_SLICE);
+
+    /**
+     * @brief Queues a body to run in a fiber of its own.
+     * @param body The code to run, it should handle its own errors
+     */
+    void add(Fiber::Body body);
+
+    /**
+     * @brief Runs all queued bodies and blocks until they are done.
+     * The statistics of the threads are added to those of the calling thread.
+     * @throws The first error that a body failed with, after all other bodies are done
+     */
+    void run();
+
+private:
+    size_t threads;                             ///< Number of threads that run the fibers
+    uint64_t slice;                             ///< Number of steps in a turn
+    std::deque<std::unique_ptr<Fiber>> waiting; ///< Fibers that no thread has started yet
+    std::exception_ptr error{};                 ///< First error that a body failed with
+    std::mutex lock;                            ///< Protects the waiting fibers, the error and the totals
+    Stats* totals{nullptr};                     ///< Statistics that the threads add theirs to
+
+    /**
+     * @brief Runs fibers until none are waiting or started.
+     */
+    void work();
+
+    /**
+     * @brief Takes the fiber that has waited longest.
+     * @return std::unique_ptr<Fiber> The fiber, or nullptr if none is waiting
+     */
+    std::unique_ptr<Fiber> take();
+};
+
+} // namespace funk
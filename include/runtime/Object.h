@@ -0,0 +1,45 @@
+/**
+ * @file Object.h
+ * @brief Defines the base class of runtime objects that values refer to, like tasks.
+ */
+#pragma once
+
+#include "token/TokenType.h"
+#include "utils/Common.h"
+#include <memory>
+
+namespace funk
+{
+
+/**
+ * @brief Base class of runtime objects held by values.
+ * Unlike the other types of a value, an object is not copied with the value: every copy refers to the same object,
+ * which lives until the last reference to it is gone. Two values are only equal if they refer to the same object.
+ */
+class Object
+{
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup of derived classes.
+     */
+    virtual ~Object() = default;
+
+    /**
+     * @brief Gets the TokenType of values that hold this kind of object.
+     * @return The value token type, e.g. TokenType::TASK
+     */
+    virtual TokenType get_token_type() const = 0;
+
+    /**
+     * @brief Converts the object to a string representation.
+     * @return String representation of the object
+     */
+    virtual String to_s() const = 0;
+};
+
+/**
+ * @brief Shared reference to a runtime object, the type a NodeValue holds objects as.
+ */
+using ObjectRef = std::shared_ptr<Object>;
+
+} // namespace funk
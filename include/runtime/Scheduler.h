@@ -0,0 +1,147 @@
+/**
+ * @file Scheduler.h
+ * @brief Defines the Scheduler that runs spawned tasks on a pool of worker threads.
+ */
+#pragma once
+
+#include "runtime/Task.h"
+#include "utils/Common.h"
+#include "utils/Stats.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace funk
+{
+
+/**
+ * @brief Work-stealing pool of worker threads that runs the tasks of the interpreter.
+ * Every worker has a queue of its own. A task spawned by a worker goes to the back of the worker's queue, which the
+ * worker takes tasks from first, so nested tasks run depth first on the thread that spawned them. A worker without
+ * tasks steals from the front of the other queues, where the oldest and usually largest tasks are. Tasks spawned by
+ * other threads go to a shared queue that every worker steals from.
+ *
+ * A thread that awaits a task no worker has started runs it itself. A worker that blocks, on a task or a channel, may
+ * leave queued tasks without a thread to run them, among them the ones it waits for, so an extra worker is started
+ * whenever all workers are blocked while tasks are queued. Extra workers exit as soon as they find no queued task, and
+ * at most MAX_EXTRA_WORKERS of them run at once: beyond that, queued tasks wait for a blocked worker to continue. The
+ * workers are started by the first spawned task and run until shutdown().
+ */
+class Scheduler
+{
+public:
+    /**
+     * @brief Number of extra workers that may run at once, on top of the workers of the pool.
+     */
+    static const size_t MAX_EXTRA_WORKERS = 256;
+
+    /**
+     * @brief Returns the scheduler of the interpreter.
+     * @return Scheduler& Reference to the scheduler instance
+     */
+    static Scheduler& instance();
+
+    /**
+     * @brief Sets the number of worker threads, only used by workers started after the call.
+     * @param count Number of workers, at least one
+     */
+    void set_workers(size_t count);
+
+    /**
+     * @brief Gets the number of worker threads that are started by the next task.
+     * @return size_t Number of workers, one per core by default
+     */
+    size_t get_workers() const;
+
+    /**
+     * @brief Queues a task, starting the workers if they are not running.
+     * @param task The task to run
+     */
+    void submit(const std::shared_ptr<Task>& task);
+
+    /**
+     * @brief Blocks until a task is done, running it on the calling thread if no worker has started it.
+     * @param task The task to wait for
+     */
+    void wait(Task& task);
+
+    /**
+     * @brief Checks if a newly queued task would be started right away, used to decide if work is worth forking.
+     * @return bool True if more workers are idle than tasks are queued, or the workers are not started yet
+     */
+    bool has_idle_worker() const;
+
+    /**
+     * @brief Tells the scheduler that the calling thread is about to block, call unblocked() when it continues.
+     */
+    void blocking();
+
+    /**
+     * @brief Tells the scheduler that the calling thread continues after blocking().
+     */
+    void unblocked();
+
+    /**
+     * @brief Runs all remaining tasks, stops the workers and adds their statistics to those of the calling thread.
+     * Spawning a task after a shutdown starts new workers.
+     */
+    void shutdown();
+
+private:
+    /**
+     * @brief Queue of tasks waiting to run.
+     */
+    struct Queue
+    {
+        std::mutex lock;                          ///< Protects the tasks
+        std::deque<std::shared_ptr<Task>> tasks;  ///< Tasks in the order they were queued
+    };
+
+    Scheduler();
+    ~Scheduler();
+
+    size_t workers;                          ///< Number of workers to start
+    Vector<std::unique_ptr<Queue>> queues{}; ///< One queue per worker, followed by the shared queue
+    Vector<std::thread> threads{};           ///< Workers of the pool, extra workers are detached
+    std::atomic<bool> started{false};        ///< True while the workers run
+    std::atomic<size_t> pending{0};          ///< Number of queued tasks
+    std::atomic<size_t> running{0};          ///< Number of running workers, including extra ones
+    std::atomic<size_t> extra{0};            ///< Number of running extra workers
+    std::atomic<size_t> blocked{0};          ///< Number of blocked workers
+    std::atomic<size_t> idle{0};             ///< Number of workers waiting for tasks
+    std::mutex start_lock;                   ///< Serializes starting workers
+    std::mutex sleep_lock;                   ///< Protects stopping and the statistics, used by idle workers
+    std::condition_variable wake;            ///< Notified when a task is queued or the workers stop
+    std::condition_variable retired;         ///< Notified when an extra worker exits
+    bool stopping{false};                    ///< True when idle workers should exit
+    Stats* totals{nullptr};                  ///< Statistics that stopping workers add theirs to
+    std::unique_ptr<Stats> retired_stats{};  ///< Statistics of extra workers that exited since the last shutdown
+
+    /**
+     * @brief Starts the workers unless they are already running.
+     */
+    void start();
+
+    /**
+     * @brief Starts an extra worker if every worker is blocked while tasks are queued.
+     */
+    void compensate();
+
+    /**
+     * @brief Runs tasks until the scheduler stops, or for an extra worker until no task is queued.
+     * @param index Index of the worker's queue
+     * @param is_extra True for an extra worker
+     */
+    void work(size_t index, bool is_extra);
+
+    /**
+     * @brief Takes a task from the queue of the calling thread, or else steals one from another queue.
+     * @return std::shared_ptr<Task> The task, or nullptr if no task is queued
+     */
+    std::shared_ptr<Task> take();
+};
+
+} // namespace funk
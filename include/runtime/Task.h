@@ -0,0 +1,117 @@
+/**
+ * @file Task.h
+ * @brief Defines the Task object that spawn creates and await reads.
+ */
+#pragma once
+
+#include "ast/expression/ExpressionNode.h"
+#include "parser/Scope.h"
+#include "runtime/Object.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace funk
+{
+
+class Budget;
+class Reader;
+class Registry;
+class TaskGroup;
+class Writer;
+
+/**
+ * @brief Expression that is evaluated concurrently with the code that spawned it.
+ * A task evaluates its expression on a scope stack of its own. The stack starts with the variables visible where the
+ * task was spawned: variables holding a value are copied, so the task and the spawning code never see each other's
+ * assignments, while functions and other nodes of the program are shared. Calls look functions up in the registry of
+ * the program that spawned the task, its steps count against the budget of that program and it reads and prints
+ * through the reader and writer of that program. The task counts in the task group of that program until it has
+ * finished, or is deleted without having run.
+ */
+class Task : public Object
+{
+public:
+    /**
+     * @brief Constructs a task and captures the variables visible in the current scope.
+     * @param expression The expression to evaluate, owned by the program
+     */
+    explicit Task(const ExpressionNode* expression);
+
+    /**
+     * @brief Constructs a task that captures no variables, for expressions that only read their own nodes.
+     * @param expression The expression to evaluate, owned by the task
+     */
+    explicit Task(std::unique_ptr<ExpressionNode> expression);
+
+    /**
+     * @brief Deletes the copies of the captured variables and the owned expression, leaving the group if never run.
+     */
+    ~Task() override;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    /**
+     * @brief Gets the TokenType of task values.
+     * @return TokenType::TASK
+     */
+    TokenType get_token_type() const override { return TokenType::TASK; }
+
+    /**
+     * @brief Converts the task to a string representation.
+     * @return String representation of the task
+     */
+    String to_s() const override;
+
+    /**
+     * @brief Claims the task for running, only the first claim succeeds.
+     * @return bool True if the caller must run the task
+     */
+    bool claim() { return !claimed.exchange(true, std::memory_order_acq_rel); }
+
+    /**
+     * @brief Evaluates the expression on the scope stack of the task, only called after a successful claim().
+     */
+    void run();
+
+    /**
+     * @brief Checks if the task has finished, successfully or not.
+     * @return bool True if the result is available
+     */
+    bool is_done() const { return done.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Blocks until the task has finished.
+     */
+    void wait() const;
+
+    /**
+     * @brief Gets the value of the expression, the task must have finished.
+     * @return NodeValue The value
+     * @throws The error that the evaluation of the expression failed with
+     */
+    NodeValue get_result() const;
+
+private:
+    const ExpressionNode* expression;      ///< Expression evaluated by the task
+    std::unique_ptr<ExpressionNode> owned; ///< The expression if the task owns it
+    Scope scope;                           ///< Scope stack the expression is evaluated on
+    Registry* registry;                    ///< Registry of the program that spawned the task
+    Budget* budget;                        ///< Budget of the program that spawned the task, nullptr for none
+    Reader* reader;                        ///< Reader of the program that spawned the task
+    Writer* writer;                        ///< Writer of the program that spawned the task
+    TaskGroup* group;                      ///< Task group of the program that spawned the task, nullptr for none
+    Vector<Node*> captured{};              ///< Copies of the captured variables, owned by the task
+    NodeValue result{};                    ///< Value of the expression
+    std::exception_ptr error{};            ///< Error the evaluation failed with, if any
+
+    std::atomic<bool> claimed{false};         ///< True once a thread has started the task
+    std::atomic<bool> done{false};            ///< True once result or error is set
+    mutable std::mutex lock;                  ///< Protects waiting for the task
+    mutable std::condition_variable finished; ///< Notified when the task is done
+};
+
+} // namespace funk
@@ -0,0 +1,65 @@
+/**
+ * @file TaskGroup.h
+ * @brief Defines the TaskGroup that counts the unfinished tasks of a run.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace funk
+{
+
+/**
+ * @brief Counts the tasks spawned by a run that have not finished yet.
+ * Tasks keep the registry, budget, reader and writer of the run that spawned them, so a run whose context is deleted
+ * when it ends, like the run of a server client, waits for its tasks first. Like budgets, a group is entered by the
+ * threads that work for its run and tasks join the group of the code that spawned them, tasks spawned by tasks
+ * included. Runs without a group leave their tasks to Scheduler::shutdown().
+ */
+class TaskGroup
+{
+public:
+    TaskGroup() = default;
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief Makes a group the one of the calling thread.
+     * @param group The group, or nullptr for none
+     * @return TaskGroup* The previous group, or nullptr if there was none
+     */
+    static TaskGroup* enter(TaskGroup* group);
+
+    /**
+     * @brief Gets the group of the calling thread.
+     * @return TaskGroup* The group, or nullptr if the thread works without one
+     */
+    static TaskGroup* get_current() { return current; }
+
+    /**
+     * @brief Counts a new task.
+     */
+    void add();
+
+    /**
+     * @brief Counts a task as finished, waking the threads that wait for the group once none are left.
+     */
+    void finish();
+
+    /**
+     * @brief Blocks until every task of the group has finished.
+     */
+    void wait();
+
+private:
+    static thread_local TaskGroup* current; ///< Group of the run the thread works for, nullptr for none
+
+    size_t unfinished{0};              ///< Number of tasks that have not finished
+    std::mutex lock;                   ///< Protects unfinished
+    std::condition_variable finished;  ///< Notified when the last task finishes
+};
+
+} // namespace funk
@@ -17,7 +17,7 @@ namespace funk
  * @brief Variant type for storing different possible token values
  * TokenValue can hold any of the primitive types used in the Funk language aswell as the None type.
  */
-using TokenValue = std::variant<int, double, bool, char, String, None>;
+using TokenValue = std::variant<Numb, double, bool, char, String, None>;
 
 /**
  * @brief Class representing a lexical token in the Funk language
@@ -30,6 +30,9 @@ enum class TokenType
     CASE,   ///< The 'case' keyword
     NONE,   ///< The 'none' keyword
     RETURN, ///< The 'return' keyword
+    SPAWN,  ///< The 'spawn' keyword used to start a task
+    AWAIT,  ///< The 'await' keyword used to wait for the result of a task
+    YIELD,  ///< The 'yield' keyword used to produce the next value of a generator
 
     // Literals
     NUMB, ///< Whole number literal (integer)
@@ -37,6 +40,10 @@ enum class TokenType
     BOOL, ///< Boolean literal (bool)
     CHAR, ///< Single character literal (char)
     TEXT, ///< String literal (std::string)
+    TASK,      ///< Task value, only created at runtime by 'spawn'
+    CHANNEL,   ///< Channel value, only created at runtime by channel()
+    GENERATOR, ///< Generator value, only created at runtime by calling a function that yields
+    MAP,       ///< Map value, created by a map literal
 
     // Types
     NUMB_TYPE, ///< The 'numb' type keyword
@@ -44,6 +51,10 @@ enum class TokenType
     BOOL_TYPE, ///< The 'bool' type keyword
     CHAR_TYPE, ///< The 'char' type keyword
     TEXT_TYPE, ///< The 'text' type keyword
+    TASK_TYPE,      ///< The 'task' type keyword
+    CHANNEL_TYPE,   ///< The 'chan' type keyword
+    GENERATOR_TYPE, ///< The 'gen' type keyword
+    MAP_TYPE,       ///< The 'map' type keyword
 
     // Identifiers
     IDENTIFIER, ///< Identifier for variables, functions, etc.
@@ -114,4 +125,11 @@ String token_type_to_s(TokenType token);
  * @return The corresponding value token type
  */
 TokenType type_token_to_value_token(TokenType token);
+
+/**
+ * @brief Converts a compound assignment TokenType to the operator it applies
+ * @param token The token type to convert, e.g. PLUS_ASSIGN
+ * @return The corresponding operator token type, e.g. PLUS, or the token itself if it is not a compound assignment
+ */
+TokenType compound_assign_to_operator(TokenType token);
 } // namespace funk
@@ -19,8 +19,9 @@ public:
      * @brief Constructs a parser from command-line arguments.
      * @param argc Number of arguments
      * @param argv Array of argument strings
+     * @param valued Short options that take a value, given as the next argument or right after the option like -j4
      */
-    ArgParser(int argc, char* argv[]);
+    ArgParser(int argc, char* argv[], const Vector<String>& valued = {});
 
     /**
      * @brief Default destructor.
@@ -0,0 +1,122 @@
+/**
+ * @file BigInt.h
+ * @brief Defines the arbitrary precision integer used when numbs are promoted on overflow.
+ */
+#pragma once
+
+#include "utils/Common.h"
+#include <cstdint>
+
+namespace funk
+{
+
+/**
+ * @brief Arbitrary precision signed integer.
+ * The magnitude is stored as 32-bit limbs, least significant first, without leading zero limbs. Division truncates
+ * towards zero and the remainder has the sign of the dividend, like the division of numbs.
+ */
+class BigInt
+{
+public:
+    /**
+     * @brief Constructs a big integer with the value zero.
+     */
+    BigInt() = default;
+
+    /**
+     * @brief Constructs a big integer from a numb.
+     * @param value The value
+     */
+    BigInt(Numb value);
+
+    /**
+     * @brief Checks if the value fits in a numb.
+     * @return bool True if to_numb() returns the exact value
+     */
+    bool fits_numb() const;
+
+    /**
+     * @brief Converts the value to a numb, the value must fit.
+     * @return Numb The value
+     */
+    Numb to_numb() const;
+
+    /**
+     * @brief Converts the value to the nearest real.
+     * @return double The value
+     */
+    double to_double() const;
+
+    /**
+     * @brief Formats the value in decimal.
+     * @return String The decimal digits, prefixed by '-' if negative
+     */
+    String to_s() const;
+
+    /**
+     * @brief Checks if the value is zero.
+     * @return bool True if the value is zero
+     */
+    bool is_zero() const { return limbs.empty(); }
+
+    /**
+     * @brief Raises a value to a non-negative power.
+     * @param base The base
+     * @param exponent The exponent, at least zero
+     * @return BigInt The power
+     */
+    static BigInt pow(const BigInt& base, Numb exponent);
+
+    /**
+     * @brief Compares two values.
+     * @return int Negative, zero or positive if lhs is less than, equal to or greater than rhs
+     */
+    static int compare(const BigInt& lhs, const BigInt& rhs);
+
+    BigInt operator-() const;
+
+    friend BigInt operator+(const BigInt& lhs, const BigInt& rhs);
+    friend BigInt operator-(const BigInt& lhs, const BigInt& rhs);
+    friend BigInt operator*(const BigInt& lhs, const BigInt& rhs);
+    friend BigInt operator/(const BigInt& lhs, const BigInt& rhs);
+    friend BigInt operator%(const BigInt& lhs, const BigInt& rhs);
+
+    friend bool operator==(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) == 0; }
+    friend bool operator!=(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) != 0; }
+    friend bool operator<(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) < 0; }
+    friend bool operator<=(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) <= 0; }
+    friend bool operator>(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) > 0; }
+    friend bool operator>=(const BigInt& lhs, const BigInt& rhs) { return compare(lhs, rhs) >= 0; }
+
+private:
+    bool negative{false};     ///< Sign, false for zero
+    Vector<uint32_t> limbs{}; ///< Magnitude, least significant limb first
+
+    /**
+     * @brief Removes leading zero limbs and clears the sign of zero.
+     */
+    void trim();
+
+    static int compare_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs);
+    static Vector<uint32_t> add_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs);
+
+    /**
+     * @brief Subtracts magnitudes, lhs must not be smaller than rhs.
+     */
+    static Vector<uint32_t> subtract_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs);
+
+    /**
+     * @brief Divides magnitudes, rhs must not be zero.
+     * @param quotient Receives the quotient
+     * @param remainder Receives the remainder
+     */
+    static void divide_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs, Vector<uint32_t>& quotient,
+        Vector<uint32_t>& remainder);
+
+    /**
+     * @brief Adds values with signs, the sign of rhs is flipped if subtract is true.
+     */
+    static BigInt add(const BigInt& lhs, const BigInt& rhs, bool subtract);
+};
+
+} // namespace funk
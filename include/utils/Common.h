@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 
@@ -31,6 +32,11 @@ namespace funk
  */
 using String = std::string;
 
+/**
+ * @brief Integer type of numb values.
+ */
+using Numb = int64_t;
+
 /**
  * @brief Represents an empty or "none" value using std::monostate.
  */
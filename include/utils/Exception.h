@@ -137,4 +137,27 @@ public:
     FileError(const String& message) : std::runtime_error(message) {}
 };
 
+/**
+ * @brief Exception class for exit() in a program that shares its process with others.
+ * Unwinds the program instead of ending the process, so that only the program ends.
+ */
+class ProgramExit : public std::runtime_error
+{
+public:
+    /**
+     * @brief Constructs a ProgramExit with the status of the program.
+     * @param status Exit status passed to exit()
+     */
+    ProgramExit(int status) : std::runtime_error("exit(" + std::to_string(status) + ")"), status(status) {}
+
+    /**
+     * @brief Gets the exit status of the program.
+     * @return int The status
+     */
+    int get_status() const { return status; }
+
+private:
+    int status; ///< Exit status passed to exit()
+};
+
 } // namespace funk
@@ -0,0 +1,160 @@
+/**
+ * @file Stats.h
+ * @brief Runtime statistics collected by the Funk interpreter.
+ * The counters are plain integer increments so that they can stay enabled in production builds.
+ */
+#pragma once
+
+#include "ast/NodeKind.h"
+#include "utils/Common.h"
+#include <array>
+#include <cstdint>
+
+namespace funk
+{
+
+/**
+ * @brief Per-interpreter counters describing what the runtime did during a run.
+ * Every counter is updated with a single increment, reporting is done by to_s() and to_json(). Each thread counts in
+ * its own instance, so tasks never contend on the counters, and the counts of worker threads are merged into the
+ * instance of the main thread when the workers stop.
+ */
+class Stats
+{
+public:
+    /**
+     * @brief Returns the statistics of the calling thread.
+     * @return Stats& Reference to the statistics instance
+     */
+    static Stats& instance()
+    {
+        static thread_local Stats stats;
+        return stats;
+    }
+
+    /**
+     * @brief Resets all counters to zero.
+     */
+    void reset();
+
+    /**
+     * @brief Adds the counters of another instance to this one.
+     * @param other The statistics to add, e.g. those of a worker thread
+     */
+    void merge(const Stats& other);
+
+    /**
+     * @brief Records the evaluation of a node.
+     * @param kind The kind of the evaluated node
+     */
+    void evaluated(NodeKind kind) { ++nodes_evaluated[static_cast<size_t>(kind)]; }
+
+    /**
+     * @brief Records a scope push.
+     * @param depth The scope depth after the push
+     */
+    void scope_pushed(int depth)
+    {
+        ++scope_pushes;
+        if (depth > max_scope_depth) { max_scope_depth = depth; }
+    }
+
+    /**
+     * @brief Records a scope pop.
+     */
+    void scope_popped() { ++scope_pops; }
+
+    /**
+     * @brief Records a symbol lookup in the scope chain.
+     * @param walked Number of scopes that were searched
+     */
+    void scope_lookup(uint64_t walked)
+    {
+        ++scope_gets;
+        scope_chain_walked += walked;
+    }
+
+    /**
+     * @brief Records a function lookup in the registry.
+     */
+    void function_lookup() { ++registry_lookups; }
+
+    /**
+     * @brief Records an overload that was considered during a function lookup.
+     */
+    void overload_scanned() { ++overloads_scanned; }
+
+    /**
+     * @brief Records a pattern match attempt against a function.
+     */
+    void pattern_matched() { ++pattern_matches; }
+
+    /**
+     * @brief Records the allocation of an AST node.
+     */
+    void node_allocated() { ++nodes_allocated; }
+
+    /**
+     * @brief Records a node that specialized itself on the types of its operands.
+     */
+    void node_specialized() { ++specializations; }
+
+    /**
+     * @brief Records a specialized node that fell back to its generic version.
+     */
+    void node_deoptimized() { ++deoptimizations; }
+
+    /**
+     * @brief Records a task that was spawned.
+     */
+    void task_spawned() { ++tasks_spawned; }
+
+    /**
+     * @brief Records a task that was stolen from the queue of another thread.
+     */
+    void task_stolen() { ++tasks_stolen; }
+
+    /**
+     * @brief Records a fiber that was suspended because it used its slice of ticks.
+     */
+    void fiber_preempted() { ++preemptions; }
+
+    /**
+     * @brief Formats the counters as human readable text.
+     * @return String Multi-line report
+     */
+    String to_s() const;
+
+    /**
+     * @brief Formats the counters as a JSON object.
+     * @return String JSON document
+     */
+    String to_json() const;
+
+private:
+    Stats() = default;
+
+    std::array<uint64_t, static_cast<size_t>(NodeKind::COUNT)> nodes_evaluated{}; ///< Evaluations per node kind
+    uint64_t scope_pushes{0};       ///< Number of Scope::push calls
+    uint64_t scope_pops{0};         ///< Number of Scope::pop calls
+    int max_scope_depth{0};         ///< Deepest scope stack seen
+    uint64_t scope_gets{0};         ///< Number of Scope::get calls
+    uint64_t scope_chain_walked{0}; ///< Total scopes searched by Scope::get
+    uint64_t registry_lookups{0};   ///< Number of Registry::get_function calls
+    uint64_t overloads_scanned{0};  ///< Total overloads considered by Registry::get_function
+    uint64_t pattern_matches{0};    ///< Number of FunctionNode::matches evaluations
+    uint64_t nodes_allocated{0};    ///< Number of AST nodes allocated
+    uint64_t specializations{0};    ///< Number of nodes specialized on their operand types
+    uint64_t deoptimizations{0};    ///< Number of specialized nodes that fell back to their generic version
+    uint64_t tasks_spawned{0};      ///< Number of tasks spawned
+    uint64_t tasks_stolen{0};       ///< Number of tasks run by another thread than the one that queued them
+    uint64_t preemptions{0};        ///< Number of fibers suspended at a preemption point
+
+    /**
+     * @brief Computes the average number of scopes searched per lookup.
+     * @return double Average chain length
+     */
+    double average_chain() const;
+};
+
+} // namespace funk
@@ -2,9 +2,13 @@
 
 namespace funk
 {
-BlockNode::BlockNode(const SourceLocation& loc) : Node(loc), statements{} {}
+BlockNode::BlockNode(const SourceLocation& loc) : Node(loc, NodeKind::BLOCK), statements{} {}
 
-BlockNode::BlockNode(const SourceLocation& loc, const Vector<Node*>& statements) : Node(loc), statements{statements} {}
+BlockNode::BlockNode(const SourceLocation& loc, const Vector<Node*>& statements) :
+    Node(loc, NodeKind::BLOCK), statements{statements}
+{
+    for (Node* statement : statements) { count_slots(statement); }
+}
 
 BlockNode::~BlockNode()
 {
@@ -19,6 +23,7 @@ void BlockNode::add(Node* statement)
         return;
     }
     statements.push_back(statement);
+    count_slots(statement);
 }
 
 Vector<Node*> BlockNode::get_statements() const
@@ -26,31 +31,53 @@ Vector<Node*> BlockNode::get_statements() const
     return statements;
 }
 
-Node* BlockNode::evaluate() const
+void BlockNode::set_statements(const Vector<Node*>& new_statements)
 {
-    bool push_scope{false};
+    statements = new_statements;
+    slot_count = 0;
+    for (Node* statement : statements) { count_slots(statement); }
+}
 
-    for (Node* statement : statements)
+size_t BlockNode::get_slot_count() const
+{
+    return slot_count;
+}
+
+void BlockNode::count_slots(const Node* statement)
+{
+    switch (statement->get_kind())
     {
-        if (dynamic_cast<DeclarationNode*>(statement) || dynamic_cast<FunctionNode*>(statement))
-        {
-            push_scope = true;
-            break;
-        }
+    case NodeKind::DECLARATION:
+    case NodeKind::FUNCTION: slot_count++; break;
+    default: break;
     }
+}
 
-    if (push_scope) { Scope::instance().push(); }
-    Node* result{};
+Node* BlockNode::evaluate() const
+{
+    Stats::instance().evaluated(NodeKind::BLOCK);
+    if (slot_count == 0) { return run(); }
+
+    Scope::instance().push(slot_count);
+    Node* result{run()};
+    Scope::instance().pop();
+    return result;
+}
 
+Node* BlockNode::evaluate_in_frame() const
+{
+    Stats::instance().evaluated(NodeKind::BLOCK);
+    return run();
+}
+
+Node* BlockNode::run() const
+{
     for (Node* statement : statements)
     {
-        result = statement->evaluate();
-        if (dynamic_cast<ReturnNode*>(statement)) { break; }
-        result = nullptr;
+        Node* result{statement->evaluate()};
+        if (statement->get_kind() == NodeKind::RETURN) { return result; }
     }
-
-    if (push_scope) { Scope::instance().pop(); }
-    return result;
+    return nullptr;
 }
 
 Node* BlockNode::evaluate_same_scope() const
@@ -1,9 +1,25 @@
 #include "ast/Node.h"
+#include "runtime/Budget.h"
 
 namespace funk
 {
 
-Node::Node(const SourceLocation& loc) : location(loc) {}
+Node::Node(const SourceLocation& loc, NodeKind kind) : location(loc), kind(kind)
+{
+    Stats::instance().node_allocated();
+}
+
+void* Node::operator new(size_t size)
+{
+    Budget::allocated(size);
+    return ::operator new(size);
+}
+
+void Node::operator delete(void* memory, size_t size)
+{
+    Budget::released(size);
+    ::operator delete(memory);
+}
 
 SourceLocation Node::get_location() const
 {
@@ -0,0 +1,36 @@
+#include "ast/NodeKind.h"
+
+namespace funk
+{
+
+String node_kind_to_s(NodeKind kind)
+{
+    switch (kind)
+    {
+    case NodeKind::BLOCK: return "block";
+    case NodeKind::IF: return "if";
+    case NodeKind::WHILE: return "while";
+    case NodeKind::RETURN: return "return";
+    case NodeKind::YIELD: return "yield";
+    case NodeKind::DECLARATION: return "declaration";
+    case NodeKind::FUNCTION: return "function";
+    case NodeKind::ASSIGNMENT: return "assignment";
+    case NodeKind::BINARY_OP: return "binary_op";
+    case NodeKind::UNARY_OP: return "unary_op";
+    case NodeKind::CALL: return "call";
+    case NodeKind::METHOD_CALL: return "method_call";
+    case NodeKind::PIPE: return "pipe";
+    case NodeKind::LIST: return "list";
+    case NodeKind::MAP: return "map";
+    case NodeKind::STREAM: return "stream";
+    case NodeKind::SPAWN: return "spawn";
+    case NodeKind::AWAIT: return "await";
+    case NodeKind::LITERAL: return "literal";
+    case NodeKind::VARIABLE: return "variable";
+    case NodeKind::COUNT: break;
+    }
+
+    return "unknown";
+}
+
+} // namespace funk
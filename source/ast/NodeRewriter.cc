@@ -0,0 +1,169 @@
+#include "ast/NodeRewriter.h"
+
+namespace funk
+{
+
+Node* NodeRewriter::rewrite(Node* node)
+{
+    if (!node) { return nullptr; }
+
+    switch (node->get_kind())
+    {
+    case NodeKind::BLOCK: return rewrite_block(static_cast<BlockNode*>(node));
+    case NodeKind::IF: return rewrite_if(static_cast<IfNode*>(node));
+    case NodeKind::WHILE: return rewrite_while(static_cast<WhileNode*>(node));
+    case NodeKind::RETURN: return rewrite_return(static_cast<ReturnNode*>(node));
+    case NodeKind::YIELD: return rewrite_yield(static_cast<YieldNode*>(node));
+    case NodeKind::DECLARATION: return rewrite_declaration(static_cast<DeclarationNode*>(node));
+    case NodeKind::FUNCTION: return rewrite_function(static_cast<FunctionNode*>(node));
+    case NodeKind::ASSIGNMENT: return rewrite_assignment(static_cast<AssignmentNode*>(node));
+    case NodeKind::BINARY_OP: return rewrite_binary_op(static_cast<BinaryOpNode*>(node));
+    case NodeKind::UNARY_OP: return rewrite_unary_op(static_cast<UnaryOpNode*>(node));
+    case NodeKind::CALL: return rewrite_call(static_cast<CallNode*>(node));
+    case NodeKind::METHOD_CALL: return rewrite_method_call(static_cast<MethodCallNode*>(node));
+    case NodeKind::PIPE: return rewrite_pipe(static_cast<PipeNode*>(node));
+    case NodeKind::LIST: return rewrite_list(static_cast<ListNode*>(node));
+    case NodeKind::MAP: return rewrite_map(static_cast<MapNode*>(node));
+    case NodeKind::STREAM: return rewrite_stream(static_cast<StreamNode*>(node));
+    case NodeKind::SPAWN: return rewrite_spawn(static_cast<SpawnNode*>(node));
+    case NodeKind::AWAIT: return rewrite_await(static_cast<AwaitNode*>(node));
+    case NodeKind::LITERAL: return rewrite_literal(static_cast<LiteralNode*>(node));
+    case NodeKind::VARIABLE: return rewrite_variable(static_cast<VariableNode*>(node));
+    case NodeKind::COUNT: break;
+    }
+
+    return node;
+}
+
+void NodeRewriter::rewrite_children(Node* node)
+{
+    switch (node->get_kind())
+    {
+    case NodeKind::BLOCK:
+    {
+        auto block = static_cast<BlockNode*>(node);
+        Vector<Node*> statements{};
+        for (Node* statement : block->get_statements())
+        {
+            if (Node* result = rewrite(statement)) { statements.push_back(result); }
+        }
+        block->set_statements(statements);
+        break;
+    }
+    case NodeKind::IF:
+    {
+        auto if_node = static_cast<IfNode*>(node);
+        if_node->set_condition(rewrite_as(if_node->get_condition()));
+        if_node->set_body(rewrite_as(if_node->get_body()));
+        if_node->set_else_branch(rewrite(if_node->get_else_branch()));
+        break;
+    }
+    case NodeKind::WHILE:
+    {
+        auto while_node = static_cast<WhileNode*>(node);
+        while_node->set_condition(rewrite_as(while_node->get_condition()));
+        while_node->set_body(rewrite_as(while_node->get_body()));
+        break;
+    }
+    case NodeKind::RETURN:
+    {
+        auto return_node = static_cast<ReturnNode*>(node);
+        return_node->set_value(rewrite_as(return_node->get_value()));
+        break;
+    }
+    case NodeKind::YIELD:
+    {
+        auto yield_node = static_cast<YieldNode*>(node);
+        yield_node->set_value(rewrite_as(yield_node->get_value()));
+        break;
+    }
+    case NodeKind::DECLARATION:
+    {
+        auto declaration = static_cast<DeclarationNode*>(node);
+        declaration->set_initializer(rewrite_as(node_cast<ExpressionNode>(declaration->get_initializer())));
+        break;
+    }
+    case NodeKind::FUNCTION:
+    {
+        auto function = static_cast<FunctionNode*>(node);
+        function->set_body(rewrite_as(function->get_body()));
+        break;
+    }
+    case NodeKind::ASSIGNMENT:
+    {
+        // The left side names the assigned variable and is never rewritten
+        auto assignment = static_cast<AssignmentNode*>(node);
+        assignment->set_right(rewrite_as(assignment->get_right()));
+        break;
+    }
+    case NodeKind::BINARY_OP:
+    {
+        auto binary = static_cast<BinaryOpNode*>(node);
+        binary->set_left(rewrite_as(binary->get_left()));
+        binary->set_right(rewrite_as(binary->get_right()));
+        break;
+    }
+    case NodeKind::UNARY_OP:
+    {
+        auto unary = static_cast<UnaryOpNode*>(node);
+        unary->set_expr(rewrite_as(unary->get_expr()));
+        break;
+    }
+    case NodeKind::METHOD_CALL:
+    {
+        auto method_call = static_cast<MethodCallNode*>(node);
+        method_call->set_object(rewrite_as(method_call->get_object()));
+        [[fallthrough]];
+    }
+    case NodeKind::CALL:
+    {
+        auto call = static_cast<CallNode*>(node);
+        for (size_t i{0}; i < call->get_args().size(); i++) { call->set_arg(i, rewrite_as(call->get_args()[i])); }
+        break;
+    }
+    case NodeKind::PIPE:
+    {
+        auto pipe = static_cast<PipeNode*>(node);
+        pipe->set_source(rewrite_as(pipe->get_source()));
+        pipe->set_target(rewrite_as(pipe->get_target()));
+        break;
+    }
+    case NodeKind::LIST:
+    {
+        auto list = static_cast<ListNode*>(node);
+        for (size_t i{0}; i < list->get_elements().size(); i++)
+        {
+            list->set_element(i, rewrite_as(list->get_elements()[i]));
+        }
+        break;
+    }
+    case NodeKind::MAP:
+    {
+        auto map = static_cast<MapNode*>(node);
+        for (size_t i{0}; i < map->get_entries().size(); i++)
+        {
+            map->set_key(i, rewrite_as(map->get_entries()[i].first));
+            map->set_value(i, rewrite_as(map->get_entries()[i].second));
+        }
+        break;
+    }
+    case NodeKind::SPAWN:
+    {
+        auto spawn = static_cast<SpawnNode*>(node);
+        spawn->set_expr(rewrite_as(spawn->get_expr()));
+        break;
+    }
+    case NodeKind::AWAIT:
+    {
+        auto await = static_cast<AwaitNode*>(node);
+        await->set_expr(rewrite_as(await->get_expr()));
+        break;
+    }
+    case NodeKind::STREAM:
+    case NodeKind::LITERAL:
+    case NodeKind::VARIABLE:
+    case NodeKind::COUNT: break;
+    }
+}
+
+} // namespace funk
@@ -1,17 +1,76 @@
 #include "ast/NodeValue.h"
+#include "runtime/Budget.h"
+#include <array>
+#include <functional>
+#include <limits>
 
 namespace funk
 {
 
-template <typename T> bool NodeValue::is_a() const
+static bool promotion{false}; ///< True if numb arithmetic that overflows gives big numbs
+
+NodeValue::NodeValue(const BigInt& v) : bits(box(NONE_TAG, 0))
+{
+    if (v.fits_numb()) { *this = NodeValue{v.to_numb()}; }
+    else { bits = share(BIG_TAG, new Cell<BigInt>{{1}, v}); }
+}
+
+NodeValue::NodeValue(const Variant& v) : NodeValue(std::visit([](const auto& x) { return NodeValue(x); }, v)) {}
+
+void NodeValue::set_numb_promotion(bool enabled)
+{
+    promotion = enabled;
+}
+
+bool NodeValue::numb_promotion()
+{
+    return promotion;
+}
+
+void* NodeValue::Counted::operator new(size_t size)
+{
+    Budget::allocated(size);
+    return ::operator new(size);
+}
+
+void NodeValue::Counted::operator delete(void* memory, size_t size)
+{
+    Budget::released(size);
+    ::operator delete(memory);
+}
+
+NodeValue::Counted* NodeValue::text_cell(const String& v)
 {
-    return std::holds_alternative<T>(value);
+    Budget::allocated(v.size());
+    return new Cell<String>{{1}, v};
+}
+
+void NodeValue::destroy()
+{
+    switch ((bits >> TYPE_SHIFT) & TYPE_MASK)
+    {
+    case TEXT_TAG:
+        Budget::released(cell<String>()->value.size());
+        delete cell<String>();
+        break;
+    case BIG_TAG: delete cell<BigInt>(); break;
+    case OBJECT_TAG: delete cell<ObjectRef>(); break;
+    default: delete cell<Numb>(); break;
+    }
 }
 
 template <typename T> T NodeValue::get() const
 {
     if (!is_a<T>()) { throw TypeError("Unexpected type"); }
-    return std::get<T>(value);
+
+    if constexpr (std::is_same_v<T, Numb>) { return as_numb(); }
+    else if constexpr (std::is_same_v<T, double>) { return as_real(); }
+    else if constexpr (std::is_same_v<T, bool>) { return as_bool(); }
+    else if constexpr (std::is_same_v<T, char>) { return as_char(); }
+    else if constexpr (std::is_same_v<T, String>) { return as_text(); }
+    else if constexpr (std::is_same_v<T, BigInt>) { return as_big(); }
+    else if constexpr (std::is_same_v<T, ObjectRef>) { return as_object(); }
+    else { return None{}; }
 }
 
 template <typename T> T NodeValue::cast() const
@@ -21,8 +80,8 @@ template <typename T> T NodeValue::cast() const
 
     if constexpr (std::is_same_v<T, String>)
     {
-        if (is_a<int>())
-            return std::to_string(get<int>());
+        if (is_a<Numb>())
+            return std::to_string(get<Numb>());
         else if (is_a<double>())
             return std::to_string(get<double>());
         else if (is_a<bool>())
@@ -31,30 +90,36 @@ template <typename T> T NodeValue::cast() const
             return String(1, get<char>());
         else if (is_a<None>())
             return "none";
+        else if (is_a<BigInt>())
+            return as_big().to_s();
+        else if (is_a<ObjectRef>())
+            return as_object()->to_s();
     }
-    else if constexpr (std::is_same_v<T, int>)
+    else if constexpr (std::is_same_v<T, Numb>)
     {
-        if (is_a<double>()) { return static_cast<int>(get<double>()); }
+        if (is_a<double>()) { return static_cast<Numb>(get<double>()); }
         else if (is_a<bool>()) { return get<bool>() ? 1 : 0; }
         else if (is_a<char>()) { return get<char>(); }
     }
     else if constexpr (std::is_same_v<T, double>)
     {
-        if (is_a<int>()) { return static_cast<double>(get<int>()); }
+        if (is_a<Numb>()) { return static_cast<double>(get<Numb>()); }
         else if (is_a<bool>()) { return get<bool>() ? 1.0 : 0.0; }
         else if (is_a<char>()) { return static_cast<double>(get<char>()); }
+        else if (is_a<BigInt>()) { return as_big().to_double(); }
     }
     else if constexpr (std::is_same_v<T, bool>)
     {
-        if (is_a<int>()) { return get<int>() != 0; }
+        if (is_a<Numb>()) { return get<Numb>() != 0; }
         else if (is_a<double>()) { return get<double>() != 0.0; }
         else if (is_a<char>()) { return get<char>() != '\0'; }
         else if (is_a<String>()) { return !get<String>().empty(); }
         else if (is_a<None>()) { return false; }
+        else if (is_a<BigInt>()) { return true; }
     }
     else if constexpr (std::is_same_v<T, char>)
     {
-        if (is_a<int>()) { return static_cast<char>(get<int>()); }
+        if (is_a<Numb>()) { return static_cast<char>(get<Numb>()); }
     }
 
     throw TypeError("Cannot cast to type");
@@ -62,7 +127,22 @@ template <typename T> T NodeValue::cast() const
 
 bool NodeValue::is_numeric() const
 {
-    return is_a<int>() || is_a<double>();
+    return is_a<Numb>() || is_a<double>() || is_a<BigInt>();
+}
+
+NodeValue::Variant NodeValue::get_variant() const
+{
+    switch (type_index())
+    {
+    case INT_TYPE: return as_numb();
+    case REAL_TYPE: return as_real();
+    case BOOL_TYPE: return as_bool();
+    case CHAR_TYPE: return as_char();
+    case TEXT_TYPE: return as_text();
+    case BIG_TYPE: return as_big();
+    case OBJECT_TYPE: return as_object();
+    default: return None{};
+    }
 }
 
 bool NodeValue::is_nothing() const
@@ -72,182 +152,433 @@ bool NodeValue::is_nothing() const
 
 TokenType NodeValue::get_token_type() const
 {
-    if (is_a<int>()) return TokenType::NUMB;
+    if (is_a<Numb>() || is_a<BigInt>()) return TokenType::NUMB;
     if (is_a<double>()) return TokenType::REAL;
     if (is_a<bool>()) return TokenType::BOOL;
     if (is_a<String>()) return TokenType::TEXT;
     if (is_a<char>()) return TokenType::CHAR;
+    if (is_a<ObjectRef>()) return as_object()->get_token_type();
     return TokenType::NONE;
 }
 
 bool NodeValue::type_as(const NodeValue& other) const
 {
-    if (is_a<int>() && other.is_a<int>()) { return true; }
-    if (is_a<double>() && other.is_a<double>()) { return true; }
-    if (is_a<bool>() && other.is_a<bool>()) { return true; }
-    if (is_a<char>() && other.is_a<char>()) { return true; }
-    if (is_a<String>() && other.is_a<String>()) { return true; }
-
-    return false;
+    TokenType type{get_token_type()};
+    return type != TokenType::NONE && type == other.get_token_type();
 }
 
-template <typename Op> NodeValue numeric_op(const NodeValue& lhs, const NodeValue& rhs, Op op)
+void NodeValue::append(const NodeValue& suffix)
 {
-    if (!lhs.is_numeric() || !rhs.is_numeric())
+    if (!is_a<String>()) { throw TypeError("Cannot append to " + token_type_to_s(get_token_type())); }
+    if (!suffix.is_a<String>() && !suffix.is_a<char>())
     {
-        throw TypeError("Cannot perform arithmetic operation on " + lhs.cast<String>() + " and " + rhs.cast<String>());
+        throw TypeError("Cannot append " + token_type_to_s(suffix.get_token_type()) + " to TEXT");
     }
 
-    if (lhs.is_a<int>() && rhs.is_a<int>()) { return op(lhs.get<int>(), rhs.get<int>()); }
-    else { return op(lhs.cast<double>(), rhs.cast<double>()); }
+    // Other values keep the text they share with this one
+    if (is_shared()) { *this = NodeValue{as_text()}; }
+
+    String& characters{cell<String>()->value};
+    size_t before{characters.size()};
+    if (suffix.is_a<String>()) { characters += suffix.as_text(); }
+    else { characters += suffix.as_char(); }
+    Budget::allocated(characters.size() - before);
+}
+
+/**
+ * @brief Number of types a NodeValue can hold.
+ */
+static constexpr size_t TYPE_COUNT{std::variant_size_v<NodeValue::Variant>};
+
+/**
+ * @brief Gets the value held by a NodeValue whose type is already known.
+ */
+template <typename T> static decltype(auto) unwrap(const NodeValue& value)
+{
+    if constexpr (std::is_same_v<T, Numb>) { return value.as_numb(); }
+    else if constexpr (std::is_same_v<T, double>) { return value.as_real(); }
+    else if constexpr (std::is_same_v<T, bool>) { return value.as_bool(); }
+    else if constexpr (std::is_same_v<T, char>) { return value.as_char(); }
+    else if constexpr (std::is_same_v<T, String>) { return value.as_text(); }
+    else if constexpr (std::is_same_v<T, BigInt>) { return value.as_big(); }
+    else if constexpr (std::is_same_v<T, ObjectRef>) { return value.as_object(); }
+    else { return None{}; }
 }
 
-template <typename Op> NodeValue comparison(const NodeValue& lhs, const NodeValue& rhs, Op op)
+template <typename T> static constexpr bool is_integral_v = std::is_same_v<T, Numb> || std::is_same_v<T, BigInt>;
+template <typename T> static constexpr bool is_number_v = is_integral_v<T> || std::is_same_v<T, double>;
+template <typename T> static constexpr bool is_textual_v = std::is_same_v<T, String> || std::is_same_v<T, char>;
+template <typename T> static constexpr bool is_object_v = std::is_same_v<T, ObjectRef>;
+template <typename F>
+static constexpr bool is_equality_v = std::is_same_v<F, std::equal_to<>> || std::is_same_v<F, std::not_equal_to<>>;
+
+/**
+ * @brief Gets a numb or big numb whose type is already known as a big numb.
+ */
+template <typename T> static BigInt to_big(const NodeValue& value)
 {
-    if (lhs.is_a<int>() && rhs.is_a<int>()) { return op(lhs.get<int>(), rhs.get<int>()); }
-    else if (lhs.is_a<double>() && rhs.is_a<double>()) { return op(lhs.get<double>(), rhs.get<double>()); }
-    else if (lhs.is_a<bool>() && rhs.is_a<bool>()) { return op(lhs.get<bool>(), rhs.get<bool>()); }
-    else if (lhs.is_a<char>() && rhs.is_a<char>()) { return op(lhs.get<char>(), rhs.get<char>()); }
-    else if (lhs.is_a<String>() && rhs.is_a<String>()) { return op(lhs.get<String>(), rhs.get<String>()); }
-    else if (lhs.is_numeric() && rhs.is_numeric()) { return op(lhs.cast<double>(), rhs.cast<double>()); }
+    return BigInt{unwrap<T>(value)};
+}
 
-    throw TypeError("Cannot compare values of types " + lhs.cast<String>() + " and " + rhs.cast<String>());
+/**
+ * @brief Gets a number whose type is already known as a real.
+ */
+template <typename T> static double to_real(const NodeValue& value)
+{
+    if constexpr (std::is_same_v<T, BigInt>) { return value.as_big().to_double(); }
+    else { return static_cast<double>(unwrap<T>(value)); }
 }
 
-NodeValue operator+(const NodeValue& lhs, const NodeValue& rhs)
+/**
+ * @brief Checks if a value whose type is already known is a zero divisor.
+ */
+template <typename T> static bool is_zero(const NodeValue& value)
+{
+    if constexpr (std::is_same_v<T, BigInt>) { return value.as_big().is_zero(); }
+    else if constexpr (is_number_v<T>) { return unwrap<T>(value) == 0; }
+    else { return false; }
+}
+
+/**
+ * @brief Gives the exact result of numb arithmetic that overflowed, if numb promotion is enabled.
+ * @throws RuntimeError if numb promotion is disabled
+ */
+static NodeValue overflowed(const BigInt& exact)
+{
+    if (!promotion) { throw RuntimeError("Numb overflow"); }
+    return exact;
+}
+
+// Arithmetic on numbs reports overflow, big numbs and reals are exact or rounded
+
+struct Sum
+{
+    static bool numb(Numb a, Numb b, Numb* result) { return __builtin_add_overflow(a, b, result); }
+    static BigInt big(const BigInt& a, const BigInt& b) { return a + b; }
+    static double real(double a, double b) { return a + b; }
+};
+
+struct Difference
+{
+    static bool numb(Numb a, Numb b, Numb* result) { return __builtin_sub_overflow(a, b, result); }
+    static BigInt big(const BigInt& a, const BigInt& b) { return a - b; }
+    static double real(double a, double b) { return a - b; }
+};
+
+struct Product
+{
+    static bool numb(Numb a, Numb b, Numb* result) { return __builtin_mul_overflow(a, b, result); }
+    static BigInt big(const BigInt& a, const BigInt& b) { return a * b; }
+    static double real(double a, double b) { return a * b; }
+};
+
+struct Quotient
 {
-    if ((lhs.is_a<String>() || lhs.is_a<char>()) && (rhs.is_a<String>() || rhs.is_a<char>()))
+    static bool numb(Numb a, Numb b, Numb* result)
     {
-        String left{lhs.is_a<String>() ? lhs.get<String>() : String(1, lhs.get<char>())};
-        String right{rhs.is_a<String>() ? rhs.get<String>() : String(1, rhs.get<char>())};
+        if (a == std::numeric_limits<Numb>::min() && b == -1) { return true; }
+        *result = a / b;
+        return false;
+    }
+    static BigInt big(const BigInt& a, const BigInt& b) { return a / b; }
+    static double real(double a, double b) { return a / b; }
+};
 
-        return left + right;
+struct Remainder
+{
+    static bool numb(Numb a, Numb b, Numb* result)
+    {
+        *result = b == -1 ? 0 : a % b;
+        return false;
     }
-    return numeric_op(lhs, rhs, [](auto a, auto b)
+    static BigInt big(const BigInt& a, const BigInt& b) { return a % b; }
+};
+
+/**
+ * @brief Applies an arithmetic operation, numbs stay numbs unless mixed with reals or they overflow.
+ */
+template <typename L, typename R, typename Op> static NodeValue arithmetic(const NodeValue& lhs, const NodeValue& rhs)
+{
+    if constexpr (std::is_same_v<L, Numb> && std::is_same_v<R, Numb>)
     {
-        return a + b;
-    });
+        Numb result;
+        if (!Op::numb(lhs.as_numb(), rhs.as_numb(), &result)) { return result; }
+        return overflowed(Op::big(BigInt{lhs.as_numb()}, BigInt{rhs.as_numb()}));
+    }
+    else if constexpr (is_integral_v<L> && is_integral_v<R>) { return Op::big(to_big<L>(lhs), to_big<R>(rhs)); }
+    else if constexpr (is_number_v<L> && is_number_v<R>) { return Op::real(to_real<L>(lhs), to_real<R>(rhs)); }
+    else
+    {
+        throw TypeError("Cannot perform arithmetic operation on " + lhs.cast<String>() + " and " + rhs.cast<String>());
+    }
 }
 
-NodeValue operator-(const NodeValue& lhs, const NodeValue& rhs)
+/**
+ * @brief Applies a comparison to values of the same type, or to mixed numbers.
+ */
+template <typename L, typename R, typename F> static NodeValue compare(const NodeValue& lhs, const NodeValue& rhs, F f)
 {
-    return numeric_op(lhs, rhs, [](auto a, auto b)
+    if constexpr (is_object_v<L> || is_object_v<R>)
+    {
+        // Objects have no order, they are only equal to themselves
+        if constexpr (std::is_same_v<L, R> && is_equality_v<F>)
+        {
+            return f(unwrap<L>(lhs), unwrap<R>(rhs));
+        }
+        else { throw TypeError("Cannot compare values of types " + lhs.cast<String>() + " and " + rhs.cast<String>()); }
+    }
+    else if constexpr (std::is_same_v<L, R> && !std::is_same_v<L, None> && std::is_invocable_v<F, const L&, const R&>)
+    {
+        return f(unwrap<L>(lhs), unwrap<R>(rhs));
+    }
+    else if constexpr (is_integral_v<L> && is_integral_v<R> && std::is_invocable_v<F, const BigInt&, const BigInt&>)
     {
-        return a - b;
-    });
+        return f(to_big<L>(lhs), to_big<R>(rhs));
+    }
+    else if constexpr (is_number_v<L> && is_number_v<R>) { return f(to_real<L>(lhs), to_real<R>(rhs)); }
+    else { throw TypeError("Cannot compare values of types " + lhs.cast<String>() + " and " + rhs.cast<String>()); }
 }
 
-NodeValue operator*(const NodeValue& lhs, const NodeValue& rhs)
+/**
+ * @brief Raises a numb to a numb power.
+ */
+static NodeValue numb_power(Numb base, Numb exponent)
 {
-    return numeric_op(lhs, rhs, [](auto a, auto b)
+    if (exponent < 0)
+    {
+        if (base == 0) { throw RuntimeError("Division by zero"); }
+        if (base == 1 || base == -1) { return exponent % 2 == 0 ? Numb{1} : base; }
+        return Numb{0};
+    }
+
+    Numb result{1};
+    Numb square{base};
+    for (Numb rest{exponent}; rest > 0; rest >>= 1)
     {
-        return a * b;
-    });
+        bool overflow{(rest & 1) && __builtin_mul_overflow(result, square, &result)};
+        if (!overflow && rest > 1) { overflow = __builtin_mul_overflow(square, square, &square); }
+        if (overflow) { return overflowed(BigInt::pow(BigInt{base}, exponent)); }
+    }
+    return result;
 }
 
-NodeValue operator/(const NodeValue& lhs, const NodeValue& rhs)
+// Every operator applies itself to one pair of operand types, chosen at compile time
+
+struct Add
 {
-    if ((rhs.is_a<int>() && rhs.get<int>() == 0) || (rhs.is_a<double>() && rhs.get<double>() == 0.0))
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
     {
-        throw RuntimeError("Division by zero");
+        if constexpr (is_textual_v<L> && is_textual_v<R>) { return String{} + unwrap<L>(lhs) + unwrap<R>(rhs); }
+        else { return arithmetic<L, R, Sum>(lhs, rhs); }
     }
+};
 
-    return numeric_op(lhs, rhs, [](auto a, auto b)
+struct Subtract
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
     {
-        return a / b;
-    });
-}
+        return arithmetic<L, R, Difference>(lhs, rhs);
+    }
+};
 
-NodeValue operator%(const NodeValue& lhs, const NodeValue& rhs)
+struct Multiply
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
+    {
+        return arithmetic<L, R, Product>(lhs, rhs);
+    }
+};
+
+struct Divide
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
+    {
+        if (is_zero<R>(rhs)) { throw RuntimeError("Division by zero"); }
+        return arithmetic<L, R, Quotient>(lhs, rhs);
+    }
+};
+
+struct Modulo
 {
-    if (lhs.is_a<int>() && rhs.is_a<int>())
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
     {
-        if (rhs.get<int>() == 0) { throw RuntimeError("Modulo by zero"); }
-        return lhs.get<int>() % rhs.get<int>();
+        if constexpr (is_integral_v<L> && is_integral_v<R>)
+        {
+            if (is_zero<R>(rhs)) { throw RuntimeError("Modulo by zero"); }
+            return arithmetic<L, R, Remainder>(lhs, rhs);
+        }
+        else { throw TypeError("Modulo operation requires integer operands"); }
     }
+};
+
+struct Power
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
+    {
+        if constexpr (std::is_same_v<L, Numb> && std::is_same_v<R, Numb>)
+        {
+            return numb_power(lhs.as_numb(), rhs.as_numb());
+        }
+        else if constexpr (std::is_same_v<L, BigInt> && std::is_same_v<R, Numb>)
+        {
+            // A big numb is larger than any numb, so a negative power truncates to zero
+            if (rhs.as_numb() < 0) { return Numb{0}; }
+            return BigInt::pow(lhs.as_big(), rhs.as_numb());
+        }
+        else if constexpr (is_integral_v<L> && is_integral_v<R>)
+        {
+            // A big exponent only gives a result that fits in memory for a base of -1, 0 or 1
+            bool negative{rhs.as_big() < BigInt{0}};
+            if constexpr (std::is_same_v<L, Numb>)
+            {
+                if (lhs.as_numb() >= -1 && lhs.as_numb() <= 1)
+                {
+                    Numb exponent{(rhs.as_big() % BigInt{2}).is_zero() ? 2 : 1};
+                    return numb_power(lhs.as_numb(), negative ? -exponent : exponent);
+                }
+            }
+            if (negative) { return Numb{0}; }
+            throw RuntimeError("Numb overflow");
+        }
+        else if constexpr (is_number_v<L> && is_number_v<R>) { return std::pow(to_real<L>(lhs), to_real<R>(rhs)); }
+        else { throw TypeError("Cannot raise non-numeric value to a power"); }
+    }
+};
+
+struct Equal
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
+    {
+        if constexpr (std::is_same_v<L, None> || std::is_same_v<R, None>) { return std::is_same_v<L, R>; }
+        else { return compare<L, R>(lhs, rhs, std::equal_to<>{}); }
+    }
+};
+
+template <typename F> struct Comparison
+{
+    template <typename L, typename R> static NodeValue apply(const NodeValue& lhs, const NodeValue& rhs)
+    {
+        return compare<L, R>(lhs, rhs, F{});
+    }
+};
+
+/**
+ * @brief Signature of the entries of an operator table.
+ */
+using BinaryHandler = NodeValue (*)(const NodeValue&, const NodeValue&);
+
+/**
+ * @brief Builds the row of an operator table for one left-hand side type.
+ */
+template <typename Op, size_t L, size_t... R>
+static constexpr std::array<BinaryHandler, TYPE_COUNT> make_row(std::index_sequence<R...>)
+{
+    return {&Op::template apply<std::variant_alternative_t<L, NodeValue::Variant>,
+        std::variant_alternative_t<R, NodeValue::Variant>>...};
+}
+
+/**
+ * @brief Builds the table of an operator, indexed by the types of the left-hand and right-hand sides.
+ */
+template <typename Op, size_t... L>
+static constexpr std::array<std::array<BinaryHandler, TYPE_COUNT>, TYPE_COUNT> make_table(std::index_sequence<L...>)
+{
+    return {make_row<Op, L>(std::make_index_sequence<TYPE_COUNT>{})...};
+}
 
-    throw TypeError("Modulo operation requires integer operands");
+template <typename Op>
+static constexpr std::array<std::array<BinaryHandler, TYPE_COUNT>, TYPE_COUNT> table{
+    make_table<Op>(std::make_index_sequence<TYPE_COUNT>{})};
+
+/**
+ * @brief Applies an operator with a single lookup in its table.
+ */
+template <typename Op> static NodeValue dispatch(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return table<Op>[lhs.type_index()][rhs.type_index()](lhs, rhs);
+}
+
+NodeValue operator+(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return dispatch<Add>(lhs, rhs);
+}
+
+NodeValue operator-(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return dispatch<Subtract>(lhs, rhs);
+}
+
+NodeValue operator*(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return dispatch<Multiply>(lhs, rhs);
+}
+
+NodeValue operator/(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return dispatch<Divide>(lhs, rhs);
+}
+
+NodeValue operator%(const NodeValue& lhs, const NodeValue& rhs)
+{
+    return dispatch<Modulo>(lhs, rhs);
 }
 
 NodeValue operator==(const NodeValue& lhs, const NodeValue& rhs)
 {
-    if (lhs.is_a<None>() || rhs.is_a<None>()) { return lhs.is_a<None>() && rhs.is_a<None>(); }
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a == b;
-    });
+    return dispatch<Equal>(lhs, rhs);
 }
 
 NodeValue operator!=(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a != b;
-    });
+    return dispatch<Comparison<std::not_equal_to<>>>(lhs, rhs);
 }
 
 NodeValue operator<(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a < b;
-    });
+    return dispatch<Comparison<std::less<>>>(lhs, rhs);
 }
 
 NodeValue operator<=(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a <= b;
-    });
+    return dispatch<Comparison<std::less_equal<>>>(lhs, rhs);
 }
 
 NodeValue operator>(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a > b;
-    });
+    return dispatch<Comparison<std::greater<>>>(lhs, rhs);
 }
 
 NodeValue operator>=(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a >= b;
-    });
+    return dispatch<Comparison<std::greater_equal<>>>(lhs, rhs);
 }
 
 NodeValue operator&&(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a && b;
-    });
+    return dispatch<Comparison<std::logical_and<>>>(lhs, rhs);
 }
 
 NodeValue operator||(const NodeValue& lhs, const NodeValue& rhs)
 {
-    return comparison(lhs, rhs, [](auto a, auto b)
-    {
-        return a || b;
-    });
+    return dispatch<Comparison<std::logical_or<>>>(lhs, rhs);
 }
 
 NodeValue pow(const NodeValue& lhs, const NodeValue& rhs)
 {
-    if (!lhs.is_numeric() || !rhs.is_numeric()) { throw TypeError("Cannot raise non-numeric value to a power"); }
-
-    if (lhs.is_a<int>() && rhs.is_a<int>()) { return static_cast<int>(std::pow(lhs.get<int>(), rhs.get<int>())); }
-    else { return std::pow(lhs.cast<double>(), rhs.cast<double>()); }
+    return dispatch<Power>(lhs, rhs);
 }
 
 NodeValue operator-(const NodeValue& val)
 {
-    if (!val.is_numeric()) { throw TypeError("Cannot negate non-numeric value"); }
+    if (val.is_a<Numb>())
+    {
+        if (val.as_numb() == std::numeric_limits<Numb>::min()) { return overflowed(-BigInt{val.as_numb()}); }
+        return -val.as_numb();
+    }
+    if (val.is_a<BigInt>()) { return -val.as_big(); }
+    if (val.is_a<double>()) { return -val.as_real(); }
 
-    if (val.is_a<int>()) { return -val.get<int>(); }
-    return -val.cast<double>();
+    throw TypeError("Cannot negate non-numeric value");
 }
 
 NodeValue operator!(const NodeValue& val)
@@ -256,21 +587,16 @@ NodeValue operator!(const NodeValue& val)
     return !val.get<bool>();
 }
 
-template bool NodeValue::is_a<int>() const;
-template bool NodeValue::is_a<double>() const;
-template bool NodeValue::is_a<bool>() const;
-template bool NodeValue::is_a<char>() const;
-template bool NodeValue::is_a<String>() const;
-template bool NodeValue::is_a<None>() const;
-
-template int NodeValue::get<int>() const;
+template Numb NodeValue::get<Numb>() const;
 template double NodeValue::get<double>() const;
 template bool NodeValue::get<bool>() const;
 template char NodeValue::get<char>() const;
 template String NodeValue::get<String>() const;
 template None NodeValue::get<None>() const;
+template BigInt NodeValue::get<BigInt>() const;
+template ObjectRef NodeValue::get<ObjectRef>() const;
 
-template int NodeValue::cast<int>() const;
+template Numb NodeValue::cast<Numb>() const;
 template double NodeValue::cast<double>() const;
 template bool NodeValue::cast<bool>() const;
 template char NodeValue::cast<char>() const;
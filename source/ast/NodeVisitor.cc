@@ -0,0 +1,113 @@
+#include "ast/NodeVisitor.h"
+
+namespace funk
+{
+
+void NodeVisitor::visit(Node* node)
+{
+    if (!node) { return; }
+
+    switch (node->get_kind())
+    {
+    case NodeKind::BLOCK: visit_block(static_cast<BlockNode*>(node)); break;
+    case NodeKind::IF: visit_if(static_cast<IfNode*>(node)); break;
+    case NodeKind::WHILE: visit_while(static_cast<WhileNode*>(node)); break;
+    case NodeKind::RETURN: visit_return(static_cast<ReturnNode*>(node)); break;
+    case NodeKind::YIELD: visit_yield(static_cast<YieldNode*>(node)); break;
+    case NodeKind::DECLARATION: visit_declaration(static_cast<DeclarationNode*>(node)); break;
+    case NodeKind::FUNCTION: visit_function(static_cast<FunctionNode*>(node)); break;
+    case NodeKind::ASSIGNMENT: visit_assignment(static_cast<AssignmentNode*>(node)); break;
+    case NodeKind::BINARY_OP: visit_binary_op(static_cast<BinaryOpNode*>(node)); break;
+    case NodeKind::UNARY_OP: visit_unary_op(static_cast<UnaryOpNode*>(node)); break;
+    case NodeKind::CALL: visit_call(static_cast<CallNode*>(node)); break;
+    case NodeKind::METHOD_CALL: visit_method_call(static_cast<MethodCallNode*>(node)); break;
+    case NodeKind::PIPE: visit_pipe(static_cast<PipeNode*>(node)); break;
+    case NodeKind::LIST: visit_list(static_cast<ListNode*>(node)); break;
+    case NodeKind::MAP: visit_map(static_cast<MapNode*>(node)); break;
+    case NodeKind::STREAM: visit_stream(static_cast<StreamNode*>(node)); break;
+    case NodeKind::SPAWN: visit_spawn(static_cast<SpawnNode*>(node)); break;
+    case NodeKind::AWAIT: visit_await(static_cast<AwaitNode*>(node)); break;
+    case NodeKind::LITERAL: visit_literal(static_cast<LiteralNode*>(node)); break;
+    case NodeKind::VARIABLE: visit_variable(static_cast<VariableNode*>(node)); break;
+    case NodeKind::COUNT: break;
+    }
+}
+
+void NodeVisitor::visit_children(Node* node)
+{
+    switch (node->get_kind())
+    {
+    case NodeKind::BLOCK:
+        for (Node* statement : static_cast<BlockNode*>(node)->get_statements()) { visit(statement); }
+        break;
+    case NodeKind::IF:
+    {
+        auto if_node = static_cast<IfNode*>(node);
+        visit(if_node->get_condition());
+        visit(if_node->get_body());
+        visit(if_node->get_else_branch());
+        break;
+    }
+    case NodeKind::WHILE:
+    {
+        auto while_node = static_cast<WhileNode*>(node);
+        visit(while_node->get_condition());
+        visit(while_node->get_body());
+        break;
+    }
+    case NodeKind::RETURN: visit(static_cast<ReturnNode*>(node)->get_value()); break;
+    case NodeKind::YIELD: visit(static_cast<YieldNode*>(node)->get_value()); break;
+    case NodeKind::DECLARATION: visit(static_cast<DeclarationNode*>(node)->get_initializer()); break;
+    case NodeKind::FUNCTION:
+    {
+        auto function = static_cast<FunctionNode*>(node);
+        for (ExpressionNode* value : function->get_pattern_values()) { visit(value); }
+        visit(function->get_body());
+        break;
+    }
+    case NodeKind::ASSIGNMENT:
+    {
+        auto assignment = static_cast<AssignmentNode*>(node);
+        visit(assignment->get_left());
+        visit(assignment->get_right());
+        break;
+    }
+    case NodeKind::BINARY_OP:
+    {
+        auto binary = static_cast<BinaryOpNode*>(node);
+        visit(binary->get_left());
+        visit(binary->get_right());
+        break;
+    }
+    case NodeKind::UNARY_OP: visit(static_cast<UnaryOpNode*>(node)->get_expr()); break;
+    case NodeKind::METHOD_CALL: visit(static_cast<MethodCallNode*>(node)->get_object()); [[fallthrough]];
+    case NodeKind::CALL:
+        for (ExpressionNode* arg : static_cast<CallNode*>(node)->get_args()) { visit(arg); }
+        break;
+    case NodeKind::PIPE:
+    {
+        auto pipe = static_cast<PipeNode*>(node);
+        visit(pipe->get_source());
+        visit(pipe->get_target());
+        break;
+    }
+    case NodeKind::LIST:
+        for (ExpressionNode* element : static_cast<ListNode*>(node)->get_elements()) { visit(element); }
+        break;
+    case NodeKind::MAP:
+        for (const MapNode::Entry& entry : static_cast<MapNode*>(node)->get_entries())
+        {
+            visit(entry.first);
+            visit(entry.second);
+        }
+        break;
+    case NodeKind::SPAWN: visit(static_cast<SpawnNode*>(node)->get_expr()); break;
+    case NodeKind::AWAIT: visit(static_cast<AwaitNode*>(node)->get_expr()); break;
+    case NodeKind::STREAM:
+    case NodeKind::LITERAL:
+    case NodeKind::VARIABLE:
+    case NodeKind::COUNT: break;
+    }
+}
+
+} // namespace funk
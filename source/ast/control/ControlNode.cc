@@ -2,7 +2,7 @@
 
 namespace funk
 {
-ControlNode::ControlNode(const SourceLocation& loc) : Node(loc) {}
+ControlNode::ControlNode(const SourceLocation& loc, NodeKind kind) : Node(loc, kind) {}
 
 ControlNode::~ControlNode() = default;
 } // namespace funk
@@ -3,7 +3,7 @@
 namespace funk
 {
 IfNode::IfNode(ExpressionNode* condition, BlockNode* body, Node* else_branch) :
-    ControlNode(condition->get_location()), condition(condition), body(body), else_branch(else_branch)
+    ControlNode(condition->get_location(), NodeKind::IF), condition(condition), body(body), else_branch(else_branch)
 {
 }
 
@@ -17,8 +17,9 @@ IfNode::~IfNode()
 
 Node* IfNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::IF);
     LOG_DEBUG("Evaluating if statement");
-    if (dynamic_cast<ExpressionNode*>(condition->evaluate())->get_value().cast<bool>()) { return body->evaluate(); }
+    if (condition->get_value().cast<bool>()) { return body->evaluate(); }
     else if (else_branch) { return else_branch->evaluate(); }
     return nullptr;
 }
@@ -29,4 +30,34 @@ String IfNode::to_s() const
     if (else_branch) { result += "\n} else {\n" + else_branch->to_s() + "}"; }
     return result;
 }
+
+ExpressionNode* IfNode::get_condition() const
+{
+    return condition;
+}
+
+BlockNode* IfNode::get_body() const
+{
+    return body;
+}
+
+Node* IfNode::get_else_branch() const
+{
+    return else_branch;
+}
+
+void IfNode::set_condition(ExpressionNode* new_condition)
+{
+    condition = new_condition;
+}
+
+void IfNode::set_body(BlockNode* new_body)
+{
+    body = new_body;
+}
+
+void IfNode::set_else_branch(Node* new_else_branch)
+{
+    else_branch = new_else_branch;
+}
 } // namespace funk
@@ -4,7 +4,7 @@
 namespace funk
 {
 
-ReturnNode::ReturnNode(const SourceLocation& location, ExpressionNode* value) : ControlNode(location), value(value) {}
+ReturnNode::ReturnNode(const SourceLocation& location, ExpressionNode* value) : ControlNode(location, NodeKind::RETURN), value(value) {}
 
 ReturnNode::~ReturnNode()
 {
@@ -13,6 +13,7 @@ ReturnNode::~ReturnNode()
 
 Node* ReturnNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::RETURN);
     return value ? value->evaluate() : nullptr;
 }
 
@@ -27,4 +28,9 @@ ExpressionNode* ReturnNode::get_value() const
     return value;
 }
 
+void ReturnNode::set_value(ExpressionNode* new_value)
+{
+    value = new_value;
+}
+
 } // namespace funk
@@ -1,9 +1,10 @@
 #include "ast/control/WhileNode.h"
+#include "runtime/Budget.h"
 
 namespace funk
 {
 WhileNode::WhileNode(ExpressionNode* condition, BlockNode* body) :
-    ControlNode(condition->get_location()), condition(condition), body(body)
+    ControlNode(condition->get_location(), NodeKind::WHILE), condition(condition), body(body)
 {
 }
 
@@ -15,8 +16,14 @@ WhileNode::~WhileNode()
 
 Node* WhileNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::WHILE);
     LOG_DEBUG("Evaluating while loop");
-    while (dynamic_cast<ExpressionNode*>(condition->evaluate())->get_value().cast<bool>()) { body->evaluate(); }
+    while (condition->get_value().cast<bool>())
+    {
+        body->evaluate();
+        // The back-edge is a step, so a loop that never ends can't hold on to its thread or exceed its budget
+        Budget::step(location);
+    }
     return nullptr;
 }
 
@@ -24,4 +31,24 @@ String WhileNode::to_s() const
 {
     return "while ( " + condition->to_s() + " ) {\n" + body->to_s() + "}";
 }
+
+ExpressionNode* WhileNode::get_condition() const
+{
+    return condition;
+}
+
+BlockNode* WhileNode::get_body() const
+{
+    return body;
+}
+
+void WhileNode::set_condition(ExpressionNode* new_condition)
+{
+    condition = new_condition;
+}
+
+void WhileNode::set_body(BlockNode* new_body)
+{
+    body = new_body;
+}
 } // namespace funk
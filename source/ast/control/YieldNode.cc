@@ -0,0 +1,37 @@
+#include "ast/control/YieldNode.h"
+#include "utils/Common.h"
+
+namespace funk
+{
+
+YieldNode::YieldNode(const SourceLocation& location, ExpressionNode* value) :
+    ControlNode(location, NodeKind::YIELD), value(value)
+{
+}
+
+YieldNode::~YieldNode()
+{
+    delete value;
+}
+
+Node* YieldNode::evaluate() const
+{
+    throw RuntimeError(location, "Yield outside of a generator");
+}
+
+String YieldNode::to_s() const
+{
+    return "yield " + value->to_s();
+}
+
+ExpressionNode* YieldNode::get_value() const
+{
+    return value;
+}
+
+void YieldNode::set_value(ExpressionNode* new_value)
+{
+    value = new_value;
+}
+
+} // namespace funk
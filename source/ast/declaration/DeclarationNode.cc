@@ -4,15 +4,15 @@ namespace funk
 {
 DeclarationNode::DeclarationNode(const SourceLocation& location, bool is_mutable, TokenType type,
     const String& identifier, ExpressionNode* initializer) :
-    Node{location}, is_mutable{is_mutable}, type{type_token_to_value_token(type)}, identifier{identifier},
-    initializer{initializer}, has_initializer{true}
+    Node{location, NodeKind::DECLARATION}, is_mutable{is_mutable}, type{type_token_to_value_token(type)},
+    identifier{identifier}, initializer{initializer}, has_initializer{true}
 {
 }
 
 DeclarationNode::DeclarationNode(
     const SourceLocation& location, bool is_mutable, TokenType type, const String& identifier) :
-    Node{location}, is_mutable{is_mutable}, type{type}, identifier{identifier}, initializer{nullptr},
-    has_initializer{false}
+    Node{location, NodeKind::DECLARATION}, is_mutable{is_mutable}, type{type}, identifier{identifier},
+    initializer{nullptr}, has_initializer{false}
 {
 }
 
@@ -37,16 +37,32 @@ String DeclarationNode::to_s() const
     return "Declaration: " + identifier;
 }
 
+void DeclarationNode::set_initializer(ExpressionNode* new_initializer)
+{
+    initializer = new_initializer;
+}
+
 String DeclarationNode::get_type() const
 {
     return token_type_to_s(type);
 }
 
+TokenType DeclarationNode::get_token_type() const
+{
+    return type;
+}
+
+bool DeclarationNode::is_mutable_variable() const
+{
+    return is_mutable;
+}
+
 Node* DeclarationNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::DECLARATION);
     Node* result = has_initializer ? initializer->evaluate() : new LiteralNode(get_location(), NodeValue{});
 
-    ExpressionNode* initial_value = dynamic_cast<ExpressionNode*>(result);
+    ExpressionNode* initial_value = node_cast<ExpressionNode>(result);
     if (!initial_value)
     {
         if (result) { delete result; }
@@ -63,6 +79,20 @@ Node* DeclarationNode::evaluate() const
         }
     }
 
+    // A variable initializer evaluates to the declared variable, use the value it holds instead
+    while (auto var = node_cast<VariableNode>(initial_value))
+    {
+        if (!var->get_value_node()) { break; }
+        initial_value = var->get_value_node();
+    }
+
+    // Variables own a copy of literal values, so the AST and other variables are never changed through them
+    auto literal = node_cast<LiteralNode>(initial_value);
+    if (has_initializer && literal)
+    {
+        initial_value = new LiteralNode(literal->get_location(), literal->get_value());
+    }
+
     VariableNode* var = new VariableNode(get_location(), identifier, is_mutable, type, initial_value);
 
     Scope::instance().add(identifier, var);
@@ -1,19 +1,21 @@
 #include "ast/declaration/FunctionNode.h"
+#include "runtime/Budget.h"
+#include "runtime/Generator.h"
 
 namespace funk
 {
 
 FunctionNode::FunctionNode(const SourceLocation& location, bool is_mutable, const String& identifier,
     const Vector<Pair<TokenType, String>>& parameters, BlockNode* body) :
-    Node(location), is_mutable(is_mutable), is_pattern(false), identifier(identifier), parameters(parameters),
-    body(body)
+    Node(location, NodeKind::FUNCTION), is_mutable(is_mutable), is_pattern(false), identifier(identifier),
+    parameters(parameters), body(body)
 {
 }
 
 FunctionNode::FunctionNode(const SourceLocation& location, bool is_mutable, const String& identifier,
     const Vector<ExpressionNode*>& pattern_values, BlockNode* body) :
-    Node(location), is_mutable(is_mutable), is_pattern(true), identifier(identifier), pattern_values(pattern_values),
-    body(body)
+    Node(location, NodeKind::FUNCTION), is_mutable(is_mutable), is_pattern(true), identifier(identifier),
+    pattern_values(pattern_values), body(body)
 {
 }
 
@@ -28,6 +30,7 @@ FunctionNode::~FunctionNode()
 
 Node* FunctionNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::FUNCTION);
     // Check if the function is built-in
     if (BuiltIn::functions.find(identifier) != BuiltIn::functions.end())
     {
@@ -69,14 +72,29 @@ String FunctionNode::to_s() const
 
 Node* FunctionNode::call(const Vector<ExpressionNode*>& arguments) const
 {
-    // Push new scope
-    Scope::instance().push();
+    // Calls are steps, so recursion that never ends can't hold on to its thread or exceed its budget either
+    Budget::step(location);
+
+    // Evaluate the arguments in the scope of the caller
+    Vector<ExpressionNode*> values{evaluate_arguments(arguments)};
+
+    if (generator)
+    {
+        // The body runs later on a scope stack of the generator, which keeps the values of the arguments
+        Vector<NodeValue> argument_values{};
+        for (ExpressionNode* value : values) { argument_values.push_back(value->get_value()); }
+        auto created = std::make_shared<Generator>(this, argument_values);
+        return new LiteralNode(location, NodeValue{ObjectRef{created}});
+    }
+
+    // Push one scope for the parameters and the declarations of the body
+    Scope::instance().push(values.size() + body->get_slot_count());
     try
     {
         // Add parameters to current scope
-        init_param_scope(arguments);
-        // Evaluate body
-        Node* result{body->evaluate()};
+        init_param_scope(values);
+        // Evaluate body in the same scope
+        Node* result{body->evaluate_in_frame()};
         // Pop scope
         Scope::instance().pop();
         return result;
@@ -109,13 +127,35 @@ BlockNode* FunctionNode::get_body() const
     return body;
 }
 
+void FunctionNode::set_body(BlockNode* new_body)
+{
+    body = new_body;
+}
+
+const Vector<ExpressionNode*>& FunctionNode::get_pattern_values() const
+{
+    return pattern_values;
+}
+
 bool FunctionNode::is_pattern_matching() const
 {
     return is_pattern;
 }
 
+bool FunctionNode::is_generator() const
+{
+    return generator;
+}
+
+void FunctionNode::set_generator(bool value)
+{
+    generator = value;
+}
+
 bool FunctionNode::matches(const Vector<ExpressionNode*>& arguments) const
 {
+    Stats::instance().pattern_matched();
+
     // Only match if it's a pattern matching function and the number of arguments matches the number of pattern values
     if (!is_pattern || arguments.size() != pattern_values.size()) { return false; }
 
@@ -130,11 +170,11 @@ bool FunctionNode::matches(const Vector<ExpressionNode*>& arguments) const
     return true;
 }
 
-void FunctionNode::init_param_scope(const Vector<ExpressionNode*>& arguments) const
+Vector<ExpressionNode*> FunctionNode::evaluate_arguments(const Vector<ExpressionNode*>& arguments) const
 {
     // For pattern matching functions, don't add parameters to the scope
     // Pattern is already checked in matches()
-    if (is_pattern) { return; }
+    if (is_pattern) { return {}; }
 
     size_t p_count{parameters.size()};
     size_t a_count{arguments.size()};
@@ -146,14 +186,25 @@ void FunctionNode::init_param_scope(const Vector<ExpressionNode*>& arguments) co
             "Function '" + identifier + "' expects " + to_str(p_count) + " arguments, but got " + to_str(a_count));
     }
 
+    Vector<ExpressionNode*> values{};
+    values.reserve(p_count);
     for (size_t i{0}; i < p_count; i++)
     {
         // Evaluate argument
-        ExpressionNode* expr{dynamic_cast<ExpressionNode*>(arguments[i]->evaluate())};
+        ExpressionNode* expr{node_cast<ExpressionNode>(arguments[i]->evaluate())};
         // Check if the argument is an expression
         if (!expr) { throw RuntimeError(location, "Argument " + to_str(i) + " did not evaluate to an expression"); }
+        values.push_back(expr);
+    }
+    return values;
+}
+
+void FunctionNode::init_param_scope(const Vector<ExpressionNode*>& values) const
+{
+    for (size_t i{0}; i < values.size(); i++)
+    {
         // Add argument to scope
-        VariableNode* var{new VariableNode(location, parameters[i].second, false, parameters[i].first, expr)};
+        VariableNode* var{new VariableNode(location, parameters[i].second, false, parameters[i].first, values[i])};
         Scope::instance().add(parameters[i].second, var);
     }
 }
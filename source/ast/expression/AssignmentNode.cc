@@ -4,8 +4,40 @@ namespace funk
 {
 
 AssignmentNode::AssignmentNode(Node* left, const Token& op, ExpressionNode* right) :
-    ExpressionNode(left->get_location()), left(left), op(op), right(right)
+    ExpressionNode(left->get_location(), NodeKind::ASSIGNMENT), left(left), op(op), right(right)
 {
+    find_appended();
+}
+
+void AssignmentNode::find_appended()
+{
+    appended.clear();
+    auto var = node_cast<VariableNode>(left);
+    if (!var) { return; }
+
+    if (op.get_type() == TokenType::PLUS_ASSIGN)
+    {
+        appended.push_back(right);
+        return;
+    }
+
+    // Find the operands of 'x = x + a + b', which is parsed as '((x + a) + b)'
+    Vector<ExpressionNode*> operands{};
+    ExpressionNode* current{right};
+    while (auto binary = node_cast<BinaryOpNode>(current))
+    {
+        if (binary->get_op().get_type() != TokenType::PLUS) { return; }
+        operands.push_back(binary->get_right());
+        current = binary->get_left();
+    }
+
+    auto self = node_cast<VariableNode>(current);
+    if (operands.empty() || !self || self->get_value_node() || self->get_identifier() != var->get_identifier())
+    {
+        return;
+    }
+
+    appended.assign(operands.rbegin(), operands.rend());
 }
 
 Node* AssignmentNode::get_left() const
@@ -21,22 +53,75 @@ ExpressionNode* AssignmentNode::get_right() const
     return right;
 }
 
+void AssignmentNode::set_right(ExpressionNode* new_right)
+{
+    right = new_right;
+    find_appended();
+}
+
 Node* AssignmentNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::ASSIGNMENT);
+
+    auto var = node_cast<VariableNode>(left->evaluate());
+    if (!var) { throw RuntimeError(get_location(), "Can only assign to variables"); }
+    if (!var->get_mutable())
+    {
+        throw RuntimeError(get_location(), "Cannot assign to immutable variable '" + var->get_identifier() + "'");
+    }
+
+    // Text is extended in place instead of being copied on every concatenation
+    if (!appended.empty() && var->get_type() == TokenType::TEXT) { return append(var); }
+
     NodeValue value{right->get_value()};
-    auto var = dynamic_cast<VariableNode*>(left->evaluate());
-    if (var->get_mutable())
+    if (op.get_type() != TokenType::ASSIGN)
     {
-        if (var->get_type() != right->get_value().get_token_type())
+        try
+        {
+            value = BinaryOpNode::apply(compound_assign_to_operator(op.get_type()), var->get_value(), value);
+        }
+        catch (const TypeError& e)
+        {
+            throw TypeError(get_location(), e.what());
+        }
+        catch (const RuntimeError& e)
         {
-            throw TypeError(get_location(), "Cannot assign " + token_type_to_s(right->get_value().get_token_type()) +
-                                                " to " + token_type_to_s(var->get_type()));
+            throw RuntimeError(get_location(), e.what());
         }
-        var->set_value(new LiteralNode(get_location(), value));
     }
-    else { throw RuntimeError(get_location(), "Cannot assign to immutable variable '" + var->get_identifier() + "'"); }
-    return new LiteralNode(get_location(), value);
+
+    TokenType value_type{value.get_token_type()};
+    if (var->get_type() != value_type)
+    {
+        throw TypeError(get_location(),
+            "Cannot assign " + token_type_to_s(value_type) + " to " + token_type_to_s(var->get_type()));
+    }
+
+    // The variable's value is updated in place and returned, so no nodes are allocated
+    var->assign(value);
+    return var->get_value_node();
 }
+
+Node* AssignmentNode::append(VariableNode* var) const
+{
+    // Evaluate every operand before changing the variable, so a failing operand leaves it untouched
+    Vector<NodeValue> values{};
+    values.reserve(appended.size());
+    for (ExpressionNode* operand : appended)
+    {
+        NodeValue value{operand->get_value()};
+        if (!value.is_a<String>() && !value.is_a<char>())
+        {
+            throw TypeError(operand->get_location(), "Cannot append " + token_type_to_s(value.get_token_type()) +
+                                                         " to " + token_type_to_s(var->get_type()));
+        }
+        values.push_back(value);
+    }
+
+    for (const NodeValue& value : values) { var->append(value); }
+    return var->get_value_node();
+}
+
 String AssignmentNode::to_s() const
 {
     return String();
@@ -46,4 +131,4 @@ NodeValue AssignmentNode::get_value() const
     return NodeValue();
 }
 
-} // namespace funk
\ No newline at end of file
+} // namespace funk
@@ -0,0 +1,52 @@
+#include "ast/expression/AwaitNode.h"
+#include "runtime/Scheduler.h"
+
+namespace funk
+{
+
+AwaitNode::AwaitNode(const SourceLocation& loc, ExpressionNode* expr) :
+    ExpressionNode(loc, NodeKind::AWAIT), expr(expr)
+{
+}
+
+AwaitNode::~AwaitNode()
+{
+    delete expr;
+}
+
+Node* AwaitNode::evaluate() const
+{
+    return new LiteralNode(location, get_value());
+}
+
+String AwaitNode::to_s() const
+{
+    return "await " + expr->to_s();
+}
+
+NodeValue AwaitNode::get_value() const
+{
+    Stats::instance().evaluated(NodeKind::AWAIT);
+    NodeValue value{expr->get_value()};
+
+    if (value.get_token_type() != TokenType::TASK)
+    {
+        throw TypeError(location, "Can only await a task, got " + token_type_to_s(value.get_token_type()));
+    }
+
+    auto task = std::static_pointer_cast<Task>(value.as_object());
+    Scheduler::instance().wait(*task);
+    return task->get_result();
+}
+
+ExpressionNode* AwaitNode::get_expr() const
+{
+    return expr;
+}
+
+void AwaitNode::set_expr(ExpressionNode* new_expr)
+{
+    expr = new_expr;
+}
+
+} // namespace funk
@@ -1,10 +1,43 @@
 #include "ast/expression/BinaryOpNode.h"
+#include "ast/expression/CallNode.h"
+#include "runtime/Scheduler.h"
 
 namespace funk
 {
 
+/**
+ * @brief Queues a call with its arguments evaluated on the calling thread, if a worker is idle to run it.
+ * @param expr The call, whose function only reads its own parameters and locals
+ * @return std::shared_ptr<Task> The task, or nullptr if the call should be evaluated on the calling thread
+ */
+static std::shared_ptr<Task> fork_call(const ExpressionNode* expr)
+{
+    Scheduler& scheduler{Scheduler::instance()};
+    if (!scheduler.has_idle_worker()) { return nullptr; }
+
+    auto call = static_cast<const CallNode*>(expr);
+    Vector<ExpressionNode*> args{};
+    try
+    {
+        for (const ExpressionNode* arg : call->get_args())
+        {
+            args.push_back(new LiteralNode(arg->get_location(), arg->get_value()));
+        }
+    }
+    catch (...)
+    {
+        // Evaluating the operands in order reports the errors in order
+        for (ExpressionNode* arg : args) { delete arg; }
+        return nullptr;
+    }
+
+    auto task = std::make_shared<Task>(std::make_unique<CallNode>(call->get_identifier(), args));
+    scheduler.submit(task);
+    return task;
+}
+
 BinaryOpNode::BinaryOpNode(ExpressionNode* left, const Token& op, ExpressionNode* right) :
-    ExpressionNode(op.get_location()), op(op), left(left), right(right)
+    ExpressionNode(op.get_location(), NodeKind::BINARY_OP), op(op), left(left), right(right)
 {
 }
 
@@ -16,55 +49,197 @@ BinaryOpNode::~BinaryOpNode()
 
 Node* BinaryOpNode::evaluate() const
 {
+    return new LiteralNode(location, get_value());
+}
+
+NodeValue BinaryOpNode::apply(TokenType op, const NodeValue& left_value, const NodeValue& right_value)
+{
+    switch (op)
+    {
+    case TokenType::PLUS: return left_value + right_value;
+    case TokenType::MINUS: return left_value - right_value;
+    case TokenType::MULTIPLY: return left_value * right_value;
+    case TokenType::DIVIDE: return left_value / right_value;
+    case TokenType::MODULO: return left_value % right_value;
+    case TokenType::POWER: return pow(left_value, right_value);
+    case TokenType::EQUAL: return left_value == right_value;
+    case TokenType::NOT_EQUAL: return left_value != right_value;
+    case TokenType::LESS: return left_value < right_value;
+    case TokenType::LESS_EQUAL: return left_value <= right_value;
+    case TokenType::GREATER: return left_value > right_value;
+    case TokenType::GREATER_EQUAL: return left_value >= right_value;
+    case TokenType::AND: return left_value && right_value;
+    case TokenType::OR: return left_value || right_value;
+    default: throw RuntimeError("Invalid binary operator");
+    }
+}
+
+String BinaryOpNode::to_s() const
+{
+    return "(" + left->to_s() + " " + op.get_lexeme() + " " + right->to_s() + ")";
+}
+
+NodeValue BinaryOpNode::get_value() const
+{
+    Stats::instance().evaluated(NodeKind::BINARY_OP);
+
+    if (parallel)
+    {
+        // Both calls are pure, evaluating the right one first or at the same time can't be observed
+        if (std::shared_ptr<Task> task = fork_call(right))
+        {
+            NodeValue left_value{left->get_value()};
+            Scheduler::instance().wait(*task);
+            return apply_generic(left_value, task->get_result());
+        }
+    }
+
     NodeValue left_value{left->get_value()};
     NodeValue right_value{right->get_value()};
 
-    NodeValue result{};
+    Specialization state{specialization.load(std::memory_order_relaxed)};
+    if (state == Specialization::UNSPECIALIZED) { state = specialize(left_value, right_value); }
 
-    try
+    switch (state)
     {
-        switch (op.get_type())
+    case Specialization::NUMB_NUMB:
+        if (left_value.is_a<Numb>() && right_value.is_a<Numb>())
         {
-        case TokenType::PLUS: result = left_value + right_value; break;
-        case TokenType::MINUS: result = left_value - right_value; break;
-        case TokenType::MULTIPLY: result = left_value * right_value; break;
-        case TokenType::DIVIDE: result = left_value / right_value; break;
-        case TokenType::MODULO: result = left_value % right_value; break;
-        case TokenType::POWER: result = pow(left_value, right_value); break;
-        case TokenType::EQUAL: result = left_value == right_value; break;
-        case TokenType::NOT_EQUAL: result = left_value != right_value; break;
-        case TokenType::LESS: result = left_value < right_value; break;
-        case TokenType::LESS_EQUAL: result = left_value <= right_value; break;
-        case TokenType::GREATER: result = left_value > right_value; break;
-        case TokenType::GREATER_EQUAL: result = left_value >= right_value; break;
-        case TokenType::AND: result = left_value && right_value; break;
-        case TokenType::OR: result = left_value || right_value; break;
-        default: throw RuntimeError(location, "Invalid binary operator");
+            return apply_numb(left_value.as_numb(), right_value.as_numb());
         }
+        break;
+    case Specialization::REAL_REAL:
+        if (left_value.is_a<double>() && right_value.is_a<double>())
+        {
+            return apply_real(left_value.as_real(), right_value.as_real());
+        }
+        break;
+    case Specialization::TEXT_TEXT:
+        if (left_value.is_a<String>() && right_value.is_a<String>())
+        {
+            return apply_text(left_value.as_text(), right_value.as_text());
+        }
+        break;
+    default: return apply_generic(left_value, right_value);
     }
-    catch (const TypeError& e)
+
+    // The operand types changed, the generic operators handle every combination from now on
+    specialization.store(Specialization::GENERIC, std::memory_order_relaxed);
+    Stats::instance().node_deoptimized();
+    return apply_generic(left_value, right_value);
+}
+
+BinaryOpNode::Specialization BinaryOpNode::specialize(const NodeValue& left_value, const NodeValue& right_value) const
+{
+    TokenType type{op.get_type()};
+    bool comparison{type == TokenType::EQUAL || type == TokenType::NOT_EQUAL || type == TokenType::LESS ||
+                    type == TokenType::LESS_EQUAL || type == TokenType::GREATER || type == TokenType::GREATER_EQUAL};
+
+    Specialization state{Specialization::GENERIC};
+    if (left_value.type_index() == right_value.type_index())
     {
-        throw TypeError(location, e.what());
+        // Operators that fail on the operand types stay generic so they keep their error messages
+        if (left_value.is_a<Numb>()) { state = Specialization::NUMB_NUMB; }
+        else if (left_value.is_a<double>() && type != TokenType::MODULO) { state = Specialization::REAL_REAL; }
+        else if (left_value.is_a<String>() && (comparison || type == TokenType::PLUS))
+        {
+            state = Specialization::TEXT_TEXT;
+        }
     }
-    catch (const RuntimeError& e)
+
+    if (state != Specialization::GENERIC) { Stats::instance().node_specialized(); }
+    specialization.store(state, std::memory_order_relaxed);
+    return state;
+}
+
+NodeValue BinaryOpNode::apply_numb(Numb lhs, Numb rhs) const
+{
+    // Overflow and powers are left to the generic operators
+    Numb result;
+    switch (op.get_type())
     {
-        throw RuntimeError(location, e.what());
+    case TokenType::PLUS:
+        if (__builtin_add_overflow(lhs, rhs, &result)) { break; }
+        return result;
+    case TokenType::MINUS:
+        if (__builtin_sub_overflow(lhs, rhs, &result)) { break; }
+        return result;
+    case TokenType::MULTIPLY:
+        if (__builtin_mul_overflow(lhs, rhs, &result)) { break; }
+        return result;
+    case TokenType::DIVIDE:
+        if (rhs == 0) { throw RuntimeError(location, "Division by zero"); }
+        if (rhs == -1) { break; }
+        return lhs / rhs;
+    case TokenType::MODULO:
+        if (rhs == 0) { throw RuntimeError(location, "Modulo by zero"); }
+        if (rhs == -1) { return Numb{0}; }
+        return lhs % rhs;
+    case TokenType::EQUAL: return lhs == rhs;
+    case TokenType::NOT_EQUAL: return lhs != rhs;
+    case TokenType::LESS: return lhs < rhs;
+    case TokenType::LESS_EQUAL: return lhs <= rhs;
+    case TokenType::GREATER: return lhs > rhs;
+    case TokenType::GREATER_EQUAL: return lhs >= rhs;
+    case TokenType::AND: return lhs && rhs;
+    case TokenType::OR: return lhs || rhs;
+    default: break;
     }
-
-    return new LiteralNode(location, result);
+    return apply_generic(lhs, rhs);
 }
 
-String BinaryOpNode::to_s() const
+NodeValue BinaryOpNode::apply_real(double lhs, double rhs) const
 {
-    return "(" + left->to_s() + " " + op.get_lexeme() + " " + right->to_s() + ")";
+    switch (op.get_type())
+    {
+    case TokenType::PLUS: return lhs + rhs;
+    case TokenType::MINUS: return lhs - rhs;
+    case TokenType::MULTIPLY: return lhs * rhs;
+    case TokenType::DIVIDE:
+        if (rhs == 0.0) { throw RuntimeError(location, "Division by zero"); }
+        return lhs / rhs;
+    case TokenType::POWER: return std::pow(lhs, rhs);
+    case TokenType::EQUAL: return lhs == rhs;
+    case TokenType::NOT_EQUAL: return lhs != rhs;
+    case TokenType::LESS: return lhs < rhs;
+    case TokenType::LESS_EQUAL: return lhs <= rhs;
+    case TokenType::GREATER: return lhs > rhs;
+    case TokenType::GREATER_EQUAL: return lhs >= rhs;
+    case TokenType::AND: return lhs && rhs;
+    case TokenType::OR: return lhs || rhs;
+    default: return apply_generic(lhs, rhs);
+    }
 }
 
-NodeValue BinaryOpNode::get_value() const
+NodeValue BinaryOpNode::apply_text(const String& lhs, const String& rhs) const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
-    if (!result) { throw RuntimeError(location, "Binary operation did not evaluate to an expression"); }
+    switch (op.get_type())
+    {
+    case TokenType::PLUS: return lhs + rhs;
+    case TokenType::EQUAL: return lhs == rhs;
+    case TokenType::NOT_EQUAL: return lhs != rhs;
+    case TokenType::LESS: return lhs < rhs;
+    case TokenType::LESS_EQUAL: return lhs <= rhs;
+    case TokenType::GREATER: return lhs > rhs;
+    case TokenType::GREATER_EQUAL: return lhs >= rhs;
+    default: return apply_generic(lhs, rhs);
+    }
+}
 
-    return result->get_value();
+NodeValue BinaryOpNode::apply_generic(const NodeValue& left_value, const NodeValue& right_value) const
+{
+    try
+    {
+        return apply(op.get_type(), left_value, right_value);
+    }
+    catch (const TypeError& e)
+    {
+        throw TypeError(location, e.what());
+    }
+    catch (const RuntimeError& e)
+    {
+        throw RuntimeError(location, e.what());
+    }
 }
 
 Token BinaryOpNode::get_op() const
@@ -82,4 +257,31 @@ ExpressionNode* BinaryOpNode::get_right() const
     return right;
 }
 
+void BinaryOpNode::set_left(ExpressionNode* new_left)
+{
+    left = new_left;
+    specialization = Specialization::UNSPECIALIZED;
+}
+
+void BinaryOpNode::set_right(ExpressionNode* new_right)
+{
+    right = new_right;
+    specialization = Specialization::UNSPECIALIZED;
+}
+
+BinaryOpNode::Specialization BinaryOpNode::get_specialization() const
+{
+    return specialization.load(std::memory_order_relaxed);
+}
+
+void BinaryOpNode::set_parallel(bool value)
+{
+    parallel = value;
+}
+
+bool BinaryOpNode::is_parallel() const
+{
+    return parallel;
+}
+
 } // namespace funk
@@ -3,7 +3,12 @@
 namespace funk
 {
 CallNode::CallNode(const Token& identifier, const Vector<ExpressionNode*>& args) :
-    ExpressionNode(identifier.get_location()), identifier(identifier), args(args)
+    CallNode(identifier, args, NodeKind::CALL)
+{
+}
+
+CallNode::CallNode(const Token& identifier, const Vector<ExpressionNode*>& args, NodeKind kind) :
+    ExpressionNode(identifier.get_location(), kind), identifier(identifier), args(args)
 {
 }
 
@@ -13,19 +18,25 @@ CallNode::~CallNode()
 }
 
 Node* CallNode::evaluate() const
+{
+    Stats::instance().evaluated(NodeKind::CALL);
+    return call_with(args);
+}
+
+Node* CallNode::call_with(const Vector<ExpressionNode*>& arguments) const
 {
     LOG_DEBUG("Evaluating call to " + identifier.get_lexeme());
 
     // Check the registry first for pattern matching and overloaded functions
-    FunctionNode* func{Registry::instance().get_function(identifier.get_lexeme(), args)};
+    FunctionNode* func{Registry::instance().get_function(identifier.get_lexeme(), arguments)};
     if (func)
     {
         LOG_DEBUG("Found function in registry: " + func->get_identifier());
-        return func->call(args);
+        return func->call(arguments);
     }
 
     // // Check the current scope next for regular functions
-    // func = dynamic_cast<FunctionNode*>(Scope::instance().get(identifier.get_lexeme()));
+    // func = node_cast<FunctionNode>(Scope::instance().get(identifier.get_lexeme()));
     // if (func)
     // {
     //     LOG_DEBUG("Found function in scope: " + func->get_identifier());
@@ -37,7 +48,7 @@ Node* CallNode::evaluate() const
     if (it != BuiltIn::functions.end())
     {
         LOG_DEBUG("Found built-in function: " + identifier.get_lexeme());
-        return it->second(*this, args);
+        return it->second(*this, arguments);
     }
 
     throw RuntimeError(location, "Unknown function: " + identifier.get_lexeme());
@@ -58,7 +69,7 @@ String CallNode::to_s() const
 
 NodeValue CallNode::get_value() const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
+    ExpressionNode* result{node_cast<ExpressionNode>(evaluate())};
     if (!result) { throw RuntimeError(location, "Call did not evaluate to an expression"); }
 
     return result->get_value();
@@ -74,4 +85,9 @@ const Vector<ExpressionNode*>& CallNode::get_args() const
     return args;
 }
 
+void CallNode::set_arg(size_t index, ExpressionNode* arg)
+{
+    args[index] = arg;
+}
+
 } // namespace funk
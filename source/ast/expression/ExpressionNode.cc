@@ -3,6 +3,6 @@
 namespace funk
 {
 
-ExpressionNode::ExpressionNode(const SourceLocation& loc) : Node(loc) {}
+ExpressionNode::ExpressionNode(const SourceLocation& loc, NodeKind kind) : Node(loc, kind) {}
 
 } // namespace funk
@@ -3,7 +3,7 @@
 namespace funk
 {
 ListNode::ListNode(const SourceLocation& location, const TokenType& type, const Vector<ExpressionNode*>& elements) :
-    ExpressionNode(location), type(type), elements(elements)
+    ExpressionNode(location, NodeKind::LIST), type(type), elements(elements)
 {
 }
 
@@ -14,6 +14,7 @@ ListNode::~ListNode()
 
 Node* ListNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::LIST);
     return const_cast<ListNode*>(this);
 }
 
@@ -31,7 +32,7 @@ String ListNode::to_s() const
 
 NodeValue ListNode::get_value() const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
+    ExpressionNode* result{node_cast<ExpressionNode>(evaluate())};
     if (!result) { throw RuntimeError(location, "List did not evaluate to an expression"); }
     return NodeValue(result->to_s());
 }
@@ -40,4 +41,14 @@ size_t ListNode::length() const
 {
     return elements.size();
 }
+
+const Vector<ExpressionNode*>& ListNode::get_elements() const
+{
+    return elements;
+}
+
+void ListNode::set_element(size_t index, ExpressionNode* element)
+{
+    elements[index] = element;
+}
 } // namespace funk
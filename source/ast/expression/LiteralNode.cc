@@ -1,12 +1,14 @@
 #include "ast/expression/LiteralNode.h"
+#include "runtime/Map.h"
 
 namespace funk
 {
 
-LiteralNode::LiteralNode(const SourceLocation& loc, NodeValue value) : ExpressionNode(loc), value(value) {}
+LiteralNode::LiteralNode(const SourceLocation& loc, NodeValue value) : ExpressionNode(loc, NodeKind::LITERAL), value(value) {}
 
 Node* LiteralNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::LITERAL);
     return const_cast<LiteralNode*>(this);
 }
 
@@ -22,4 +24,24 @@ NodeValue LiteralNode::get_value() const
     return value;
 }
 
+void LiteralNode::set_value(const NodeValue& new_value)
+{
+    value = new_value;
+}
+
+void LiteralNode::append(const NodeValue& suffix)
+{
+    value.append(suffix);
+}
+
+Map& LiteralNode::own_map()
+{
+    std::shared_ptr<Map> map{Map::from(value)};
+    if (!map) { throw TypeError("Expected MAP, got " + token_type_to_s(value.get_token_type())); }
+
+    // Other values, and pipes iterating over the map, keep the map they share with this one
+    if (value.is_shared() || map.use_count() > 2) { value = NodeValue{ObjectRef{std::make_shared<Map>(*map)}}; }
+    return static_cast<Map&>(*value.as_object());
+}
+
 } // namespace funk
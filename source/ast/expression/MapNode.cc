@@ -0,0 +1,75 @@
+#include "ast/expression/MapNode.h"
+#include "ast/expression/LiteralNode.h"
+#include "runtime/Map.h"
+
+namespace funk
+{
+
+MapNode::MapNode(const SourceLocation& loc, const Vector<Entry>& entries) :
+    ExpressionNode(loc, NodeKind::MAP), entries(entries)
+{
+}
+
+MapNode::~MapNode()
+{
+    for (const Entry& entry : entries)
+    {
+        delete entry.first;
+        delete entry.second;
+    }
+}
+
+Node* MapNode::evaluate() const
+{
+    return new LiteralNode(location, get_value());
+}
+
+String MapNode::to_s() const
+{
+    if (entries.empty()) { return "{}"; }
+
+    String result{"{ "};
+    for (size_t i{0}; i < entries.size(); i++)
+    {
+        result += entries[i].first->to_s() + ": " + entries[i].second->to_s();
+        if (i < entries.size() - 1) { result += ", "; }
+    }
+    result += " }";
+    return result;
+}
+
+NodeValue MapNode::get_value() const
+{
+    Stats::instance().evaluated(NodeKind::MAP);
+
+    auto map = std::make_shared<Map>();
+    for (const Entry& entry : entries)
+    {
+        try
+        {
+            map->set(entry.first->get_value(), entry.second->get_value());
+        }
+        catch (const TypeError& e)
+        {
+            throw TypeError(entry.first->get_location(), e.what());
+        }
+    }
+    return NodeValue{ObjectRef{map}};
+}
+
+const Vector<MapNode::Entry>& MapNode::get_entries() const
+{
+    return entries;
+}
+
+void MapNode::set_key(size_t index, ExpressionNode* key)
+{
+    entries[index].first = key;
+}
+
+void MapNode::set_value(size_t index, ExpressionNode* value)
+{
+    entries[index].second = value;
+}
+
+} // namespace funk
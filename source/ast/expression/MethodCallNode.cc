@@ -1,41 +1,236 @@
 #include "ast/expression/MethodCallNode.h"
+#include "ast/expression/StreamNode.h"
+#include "runtime/Channel.h"
+#include "runtime/Generator.h"
+#include "runtime/Map.h"
 
 namespace funk
 {
+
+/**
+ * @brief Checks the number of arguments of a method call.
+ * @throws RuntimeError if there are fewer than min or more than max arguments
+ */
+static void check_arity(const SourceLocation& location, const String& method, size_t given, size_t min, size_t max)
+{
+    if (given >= min && given <= max) { return; }
+
+    String expected{max == 0 ? "no arguments" : to_str(min)};
+    if (max > min) { expected += " or " + to_str(max); }
+    if (max > 0) { expected += max == 1 ? " argument" : " arguments"; }
+    throw RuntimeError(location, method + "() takes " + expected);
+}
 MethodCallNode::MethodCallNode(ExpressionNode* object, const Token& method, const Vector<ExpressionNode*>& args) :
-    CallNode(method, args), object(object)
+    CallNode(method, args, NodeKind::METHOD_CALL), object(object)
 {
 }
 
 MethodCallNode::~MethodCallNode()
 {
+    // The arguments are deleted by the destructor of CallNode, which runs after this one
     delete object;
-    CallNode::~CallNode();
 }
 
 Node* MethodCallNode::evaluate() const
 {
+    VariableNode* variable{nullptr};
+    Node* evaluated_object{evaluate_object(variable)};
+    return call_method(evaluated_object, variable);
+}
+
+Node* MethodCallNode::call_method(Node* evaluated_object, VariableNode* variable) const
+{
+    if (auto list_node = node_cast<ListNode>(evaluated_object))
+    {
+        if (identifier.get_lexeme() == "length")
+        {
+            return new LiteralNode(location, static_cast<Numb>(list_node->length()));
+        }
+    }
+
+    NodeValue result{};
+    if (call_generator(evaluated_object, result) || call_channel(evaluated_object, result) ||
+        call_map(evaluated_object, variable, result))
+    {
+        return new LiteralNode(location, result);
+    }
+
+    // Keys and values of a map are streamed in insertion order, from the map as it was when the stream was created
+    auto literal_node = node_cast<LiteralNode>(evaluated_object);
+    std::shared_ptr<Map> map{literal_node ? Map::from(literal_node->get_value()) : nullptr};
+    const String& method{identifier.get_lexeme()};
+    if (map && (method == "keys" || method == "values"))
+    {
+        check_arity(location, method, args.size(), 0, 0);
+        map = Map::iterable(map);
+        bool keys{method == "keys"};
+        size_t position{0};
+        return new StreamNode(location, method,
+            [map, keys, position](NodeValue& value) mutable
+            {
+                NodeValue key{};
+                NodeValue entry_value{};
+                if (!map->next(position, key, entry_value)) { return false; }
+                value = keys ? key : entry_value;
+                return true;
+            });
+    }
+
+    throw RuntimeError(
+        location, "Unknown method '" + identifier.get_lexeme() + "' for object " + evaluated_object->to_s());
+}
+
+Node* MethodCallNode::evaluate_object(VariableNode*& variable) const
+{
+    Stats::instance().evaluated(NodeKind::METHOD_CALL);
     LOG_DEBUG("Evaluating method call " + identifier.get_lexeme() + " on " + object->to_s());
 
     Node* evaluated_object{object->evaluate()};
     if (!evaluated_object) { throw RuntimeError(location, "Failed to evaluate object for method call"); }
 
-    if (auto var_node = dynamic_cast<VariableNode*>(evaluated_object))
+    variable = node_cast<VariableNode>(evaluated_object);
+
+    // Parameters refer to the variable passed as argument, follow the chain to the value
+    while (auto var_node = node_cast<VariableNode>(evaluated_object))
     {
         Node* var_value = var_node->get_value_node();
-        if (var_value) { evaluated_object = var_value; }
+        if (!var_value) { break; }
+        evaluated_object = var_value;
     }
+    return evaluated_object;
+}
+
+bool MethodCallNode::call_generator(Node* evaluated_object, NodeValue& result) const
+{
+    auto literal_node = node_cast<LiteralNode>(evaluated_object);
+    std::shared_ptr<Generator> generator{literal_node ? Generator::from(literal_node->get_value()) : nullptr};
+    if (!generator) { return false; }
 
-    if (auto list_node = dynamic_cast<ListNode*>(evaluated_object))
+    // An ended generator gives none
+    if (identifier.get_lexeme() == "next")
     {
-        if (identifier.get_lexeme() == "length")
+        generator->next(result);
+        return true;
+    }
+    if (identifier.get_lexeme() == "done")
+    {
+        result = NodeValue{generator->is_done()};
+        return true;
+    }
+    return false;
+}
+
+bool MethodCallNode::call_channel(Node* evaluated_object, NodeValue& result) const
+{
+    auto literal_node = node_cast<LiteralNode>(evaluated_object);
+    std::shared_ptr<Channel> channel{literal_node ? Channel::from(literal_node->get_value()) : nullptr};
+    if (!channel) { return false; }
+
+    // Waits for a value or close(), so a consumer can stop at the end of the stream without recv() giving none
+    if (identifier.get_lexeme() == "done")
+    {
+        check_arity(location, "done", args.size(), 0, 0);
+        result = NodeValue{channel->is_done()};
+        return true;
+    }
+    return false;
+}
+
+bool MethodCallNode::call_map(Node* evaluated_object, VariableNode* variable, NodeValue& result) const
+{
+    auto literal_node = node_cast<LiteralNode>(evaluated_object);
+    if (!literal_node || literal_node->get_value().get_token_type() != TokenType::MAP) { return false; }
+
+    const String& method{identifier.get_lexeme()};
+    try
+    {
+        // The arguments are evaluated first, so the variable only holds the map while it is changed
+        if (method == "set")
+        {
+            check_arity(location, method, args.size(), 2, 2);
+            NodeValue key{args[0]->get_value()};
+            NodeValue value{args[1]->get_value()};
+            own_map(variable).set(key, value);
+            result = NodeValue{};
+            return true;
+        }
+        if (method == "remove")
+        {
+            check_arity(location, method, args.size(), 1, 1);
+            NodeValue key{args[0]->get_value()};
+            result = NodeValue{own_map(variable).remove(key)};
+            return true;
+        }
+
+        NodeValue held{literal_node->get_value()};
+        const Map& map{static_cast<const Map&>(*held.as_object())};
+        if (method == "get")
+        {
+            // A missing key gives the default value, or none without one
+            check_arity(location, method, args.size(), 1, 2);
+            const NodeValue* value{map.find(args[0]->get_value())};
+            if (value) { result = *value; }
+            else { result = args.size() == 2 ? args[1]->get_value() : NodeValue{}; }
+            return true;
+        }
+        if (method == "has")
         {
-            return new LiteralNode(location, static_cast<int>(list_node->length()));
+            check_arity(location, method, args.size(), 1, 1);
+            result = NodeValue{map.find(args[0]->get_value()) != nullptr};
+            return true;
         }
+        if (method == "length")
+        {
+            check_arity(location, method, args.size(), 0, 0);
+            result = NodeValue{static_cast<Numb>(map.size())};
+            return true;
+        }
+
+        // Updated copies leave the map unchanged, so they work on maps in immutable variables too
+        if (method == "with")
+        {
+            check_arity(location, method, args.size(), 2, 2);
+            result = NodeValue{ObjectRef{map.with(args[0]->get_value(), args[1]->get_value())}};
+            return true;
+        }
+        if (method == "without")
+        {
+            check_arity(location, method, args.size(), 1, 1);
+            result = NodeValue{ObjectRef{map.without(args[0]->get_value())}};
+            return true;
+        }
+    }
+    catch (const TypeError& e)
+    {
+        throw TypeError(location, e.what());
+    }
+    return false;
+}
+
+Map& MethodCallNode::own_map(VariableNode* variable) const
+{
+    // Parameters refer to the variable passed as argument, which only the caller may change
+    VariableNode* holder{variable};
+    while (holder && holder->get_mutable())
+    {
+        auto inner = node_cast<VariableNode>(holder->get_value_node());
+        if (!inner) { break; }
+        holder = inner;
     }
 
-    throw RuntimeError(
-        location, "Unknown method '" + identifier.get_lexeme() + "' for object " + evaluated_object->to_s());
+    if (!holder) { throw RuntimeError(location, "Cannot modify a map that is not held by a variable"); }
+    if (!holder->get_mutable())
+    {
+        throw RuntimeError(location, "Cannot modify immutable variable '" + holder->get_identifier() + "'");
+    }
+
+    auto literal_node = node_cast<LiteralNode>(holder->get_value_node());
+    if (!literal_node)
+    {
+        holder->assign(holder->get_value_node()->get_value());
+        literal_node = node_cast<LiteralNode>(holder->get_value_node());
+    }
+    return literal_node->own_map();
 }
 
 String MethodCallNode::to_s() const
@@ -55,9 +250,29 @@ String MethodCallNode::to_s() const
 
 NodeValue MethodCallNode::get_value() const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
+    // Generator, channel and map methods give their value without a node, so pulling many values doesn't allocate
+    VariableNode* variable{nullptr};
+    Node* evaluated_object{evaluate_object(variable)};
+    NodeValue value{};
+    if (call_generator(evaluated_object, value) || call_channel(evaluated_object, value) ||
+        call_map(evaluated_object, variable, value))
+    {
+        return value;
+    }
+
+    ExpressionNode* result{node_cast<ExpressionNode>(call_method(evaluated_object, variable))};
     if (!result) { throw RuntimeError(location, "Method call did not evaluate to an expression"); }
 
     return result->get_value();
 }
+
+ExpressionNode* MethodCallNode::get_object() const
+{
+    return object;
+}
+
+void MethodCallNode::set_object(ExpressionNode* new_object)
+{
+    object = new_object;
+}
 } // namespace funk
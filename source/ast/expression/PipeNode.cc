@@ -3,8 +3,20 @@
 namespace funk
 {
 
+/**
+ * @brief Gets the value a node holds if it is a literal, following variables to their values.
+ */
+static NodeValue held_value(Node* node)
+{
+    // Parameters refer to the variable passed as argument
+    while (auto var = node_cast<VariableNode>(node)) { node = var->get_value_node(); }
+
+    auto literal = node_cast<LiteralNode>(node);
+    return literal ? literal->get_value() : NodeValue{};
+}
+
 PipeNode::PipeNode(const SourceLocation& location, ExpressionNode* source, ExpressionNode* target) :
-    ExpressionNode(location), source(source), target(target)
+    ExpressionNode(location, NodeKind::PIPE), source(source), target(target)
 {
 }
 
@@ -16,32 +28,115 @@ PipeNode::~PipeNode()
 
 Node* PipeNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::PIPE);
+
+    // A chain like a >> f >> g is parsed as ((a >> f) >> g), collect the stages from the innermost pipe outwards
+    Vector<const PipeNode*> stages{this};
+    ExpressionNode* root{source};
+    while (auto pipe = node_cast<PipeNode>(root))
+    {
+        stages.push_back(pipe);
+        root = pipe->source;
+    }
+    std::reverse(stages.begin(), stages.end());
+
+    Vector<std::shared_ptr<Channel>> sinks{};
+    for (const PipeNode* stage : stages) { sinks.push_back(stage->get_sink()); }
+
     // Evaluate the source expression
-    ExpressionNode* current{dynamic_cast<ExpressionNode*>(source->evaluate())};
+    Node* current{root->evaluate()};
+
+    // Streams and channels are pushed through the whole chain one value at a time
+    StreamNode::Producer producer{};
+    if (auto stream = node_cast<StreamNode>(current))
+    {
+        producer = [stream](NodeValue& value) { return stream->next(value); };
+    }
+    else if (std::shared_ptr<Channel> channel = Channel::from(held_value(current)))
+    {
+        // A channel is received from until it is closed
+        producer = [channel](NodeValue& value) { return channel->recv(value); };
+    }
+    else if (std::shared_ptr<Generator> generator = Generator::from(held_value(current)))
+    {
+        // A generator runs until its function ends
+        producer = [generator](NodeValue& value) { return generator->next(value); };
+    }
+    else if (std::shared_ptr<Map> map = Map::from(held_value(current)))
+    {
+        // A map gives its keys in insertion order, holding the map keeps it from changing while it is iterated
+        map = Map::iterable(map);
+        size_t position{0};
+        producer = [map, position](NodeValue& value) mutable
+        {
+            NodeValue entry_value{};
+            return map->next(position, value, entry_value);
+        };
+    }
+
+    if (producer)
+    {
+        NodeValue value{};
+        while (producer(value))
+        {
+            LiteralNode* item{new LiteralNode(root->get_location(), value)};
+            Node* result{item};
+            for (size_t i{0}; i < stages.size(); i++) { result = stages[i]->apply(result, sinks[i].get()); }
+            delete item;
+        }
+        return new LiteralNode(location, None{});
+    }
+
+    for (size_t i{0}; i < stages.size(); i++) { current = stages[i]->apply(current, sinks[i].get()); }
+    return current;
+}
+
+Node* PipeNode::apply(Node* value, Channel* sink) const
+{
+    ExpressionNode* current{node_cast<ExpressionNode>(value)};
     if (!current) { throw RuntimeError(location, "Pipe source did not evaluate to an expression"); }
 
+    if (sink)
+    {
+        try
+        {
+            sink->send(current->get_value());
+        }
+        catch (const TypeError& e)
+        {
+            throw TypeError(location, e.what());
+        }
+        catch (const RuntimeError& e)
+        {
+            throw RuntimeError(location, e.what());
+        }
+        return new LiteralNode(location, None{});
+    }
+
     // Create a list of arguments for the target function, starting with the source expression
     Vector<ExpressionNode*> args{current};
 
-    if (auto call = dynamic_cast<CallNode*>(target))
+    if (auto call = node_cast<CallNode>(target))
     {
-        // Get the function's name and original arguments
-        const String name = call->get_identifier().get_lexeme();
-        const Vector<ExpressionNode*> call_args = call->get_args();
-
         // Add the original call arguments after the piped value
+        const Vector<ExpressionNode*>& call_args = call->get_args();
         args.insert(args.end(), call_args.begin(), call_args.end());
 
-        // Create a new call node with the updated arguments
-        CallNode* new_call{new CallNode(call->get_identifier(), args)};
-
-        // Evaluate the new call node
-        return new_call->evaluate();
+        // Call the function with the updated arguments
+        return call->call_with(args);
     }
-    else if (auto func = dynamic_cast<FunctionNode*>(target)) { return func->call(args); }
+    else if (auto func = node_cast<FunctionNode>(target)) { return func->call(args); }
     else { throw RuntimeError(location, "Pipe target must be a function or function identifier"); }
 }
 
+std::shared_ptr<Channel> PipeNode::get_sink() const
+{
+    auto call = node_cast<CallNode>(target);
+    if (!call || !call->get_args().empty()) { return nullptr; }
+
+    return Channel::from(held_value(Scope::instance().get(call->get_identifier().get_lexeme())));
+}
+
 String PipeNode::to_s() const
 {
     return source->to_s() + " >> " + target->to_s();
@@ -49,7 +144,10 @@ String PipeNode::to_s() const
 
 NodeValue PipeNode::get_value() const
 {
-    return target->get_value();
+    ExpressionNode* result{node_cast<ExpressionNode>(evaluate())};
+    if (!result) { throw RuntimeError(location, "Pipe did not evaluate to an expression"); }
+
+    return result->get_value();
 }
 
 ExpressionNode* PipeNode::get_source() const
@@ -62,4 +160,14 @@ ExpressionNode* PipeNode::get_target() const
     return target;
 }
 
+void PipeNode::set_source(ExpressionNode* new_source)
+{
+    source = new_source;
+}
+
+void PipeNode::set_target(ExpressionNode* new_target)
+{
+    target = new_target;
+}
+
 } // namespace funk
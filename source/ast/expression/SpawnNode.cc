@@ -0,0 +1,45 @@
+#include "ast/expression/SpawnNode.h"
+#include "runtime/Scheduler.h"
+
+namespace funk
+{
+
+SpawnNode::SpawnNode(const SourceLocation& loc, ExpressionNode* expr) :
+    ExpressionNode(loc, NodeKind::SPAWN), expr(expr)
+{
+}
+
+SpawnNode::~SpawnNode()
+{
+    delete expr;
+}
+
+Node* SpawnNode::evaluate() const
+{
+    return new LiteralNode(location, get_value());
+}
+
+String SpawnNode::to_s() const
+{
+    return "spawn " + expr->to_s();
+}
+
+NodeValue SpawnNode::get_value() const
+{
+    Stats::instance().evaluated(NodeKind::SPAWN);
+    auto task = std::make_shared<Task>(expr);
+    Scheduler::instance().submit(task);
+    return NodeValue{ObjectRef{task}};
+}
+
+ExpressionNode* SpawnNode::get_expr() const
+{
+    return expr;
+}
+
+void SpawnNode::set_expr(ExpressionNode* new_expr)
+{
+    expr = new_expr;
+}
+
+} // namespace funk
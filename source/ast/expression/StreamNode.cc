@@ -0,0 +1,32 @@
+#include "ast/expression/StreamNode.h"
+
+namespace funk
+{
+
+StreamNode::StreamNode(const SourceLocation& loc, const String& name, Producer producer) :
+    ExpressionNode(loc, NodeKind::STREAM), name(name), producer(std::move(producer))
+{
+}
+
+Node* StreamNode::evaluate() const
+{
+    Stats::instance().evaluated(NodeKind::STREAM);
+    return const_cast<StreamNode*>(this);
+}
+
+String StreamNode::to_s() const
+{
+    return "<stream " + name + ">";
+}
+
+NodeValue StreamNode::get_value() const
+{
+    return NodeValue(to_s());
+}
+
+bool StreamNode::next(NodeValue& value) const
+{
+    return producer(value);
+}
+
+} // namespace funk
@@ -4,9 +4,9 @@ namespace funk
 {
 
 UnaryOpNode::UnaryOpNode(const Token& op, ExpressionNode* expr) :
-    ExpressionNode(op.get_location()), op(op), expr(expr) {
-
-    };
+    ExpressionNode(op.get_location(), NodeKind::UNARY_OP), op(op), expr(expr)
+{
+}
 
 UnaryOpNode::~UnaryOpNode()
 {
@@ -15,28 +15,17 @@ UnaryOpNode::~UnaryOpNode()
 
 Node* UnaryOpNode::evaluate() const
 {
-    NodeValue expr_value{expr->get_value()};
-    NodeValue result{};
+    return new LiteralNode(location, get_value());
+}
 
-    try
-    {
-        switch (op.get_type())
-        {
-        case TokenType::MINUS: result = -expr_value; break;
-        case TokenType::NOT: result = !expr_value; break;
-        default: throw RuntimeError(location, "Invalid unary operator");
-        }
-    }
-    catch (const TypeError& e)
-    {
-        throw TypeError(location, e.what());
-    }
-    catch (const RuntimeError& e)
+NodeValue UnaryOpNode::apply(TokenType op, const NodeValue& value)
+{
+    switch (op)
     {
-        throw RuntimeError(location, e.what());
+    case TokenType::MINUS: return -value;
+    case TokenType::NOT: return !value;
+    default: throw RuntimeError("Invalid unary operator");
     }
-
-    return new LiteralNode(location, result);
 }
 
 String UnaryOpNode::to_s() const
@@ -46,10 +35,21 @@ String UnaryOpNode::to_s() const
 
 NodeValue UnaryOpNode::get_value() const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
-    if (!result) { throw RuntimeError(location, "Unary operation did not evaluate to an expression"); }
+    Stats::instance().evaluated(NodeKind::UNARY_OP);
+    NodeValue expr_value{expr->get_value()};
 
-    return result->get_value();
+    try
+    {
+        return apply(op.get_type(), expr_value);
+    }
+    catch (const TypeError& e)
+    {
+        throw TypeError(location, e.what());
+    }
+    catch (const RuntimeError& e)
+    {
+        throw RuntimeError(location, e.what());
+    }
 }
 
 Token UnaryOpNode::get_op() const
@@ -62,4 +62,9 @@ ExpressionNode* UnaryOpNode::get_expr() const
     return expr;
 }
 
+void UnaryOpNode::set_expr(ExpressionNode* new_expr)
+{
+    expr = new_expr;
+}
+
 }; // namespace funk
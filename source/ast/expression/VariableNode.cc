@@ -4,12 +4,12 @@ namespace funk
 {
 VariableNode::VariableNode(
     const SourceLocation& location, const String& identifier, bool is_mutable, TokenType type, ExpressionNode* value) :
-    ExpressionNode{location}, identifier{identifier}, is_mutable{is_mutable}, type{type}, value{value}
+    ExpressionNode{location, NodeKind::VARIABLE}, identifier{identifier}, is_mutable{is_mutable}, type{type}, value{value}
 {
 }
 
 VariableNode::VariableNode(const SourceLocation& location, const String& identifier) :
-    ExpressionNode{location}, identifier{identifier}, is_mutable{false}, type{TokenType::NONE}, value{nullptr}
+    ExpressionNode{location, NodeKind::VARIABLE}, identifier{identifier}, is_mutable{false}, type{TokenType::NONE}, value{nullptr}
 {
 }
 
@@ -21,6 +21,7 @@ VariableNode::~VariableNode()
 
 Node* VariableNode::evaluate() const
 {
+    Stats::instance().evaluated(NodeKind::VARIABLE);
     if (value == nullptr)
     {
         Node* result = Scope::instance().get(identifier);
@@ -39,7 +40,7 @@ String VariableNode::to_s() const
 
 NodeValue VariableNode::get_value() const
 {
-    ExpressionNode* result{dynamic_cast<ExpressionNode*>(evaluate())};
+    ExpressionNode* result{node_cast<ExpressionNode>(evaluate())};
     if (!result) { throw RuntimeError(location, "Variable did not evaluate to an expression."); }
 
     return result->get_value();
@@ -74,4 +75,34 @@ void VariableNode::set_value(ExpressionNode* new_value)
     }
     else { throw RuntimeError(get_location(), "Cannot modify immutable variable '" + identifier + "'"); }
 }
+
+void VariableNode::assign(const NodeValue& new_value)
+{
+    if (!is_mutable) { throw RuntimeError(get_location(), "Cannot modify immutable variable '" + identifier + "'"); }
+
+    // Mutable variables own their literal, so it can be updated without allocating a new node
+    if (auto literal = node_cast<LiteralNode>(value))
+    {
+        literal->set_value(new_value);
+        return;
+    }
+
+    set_value(new LiteralNode(get_location(), new_value));
+}
+
+void VariableNode::append(const NodeValue& suffix)
+{
+    if (!is_mutable) { throw RuntimeError(get_location(), "Cannot modify immutable variable '" + identifier + "'"); }
+
+    // Mutable variables own their literal, so the text can grow in place
+    if (auto literal = node_cast<LiteralNode>(value))
+    {
+        literal->append(suffix);
+        return;
+    }
+
+    NodeValue text{get_value()};
+    text.append(suffix);
+    set_value(new LiteralNode(get_location(), text));
+}
 } // namespace funk
@@ -0,0 +1,147 @@
+#include "io/Reader.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace funk
+{
+
+thread_local Reader* Reader::current{nullptr};
+
+Reader::Reader(int fd, size_t capacity) : fd(fd), buffer(std::max<size_t>(capacity, 1))
+{
+    begin = end = buffer.data();
+    map();
+}
+
+Reader::~Reader()
+{
+    if (mapped) { ::munmap(mapped, mapped_size); }
+}
+
+/**
+ * @brief Creates the standard input reader, tied to the standard output writer.
+ * @return Reader& The reader
+ */
+static Reader& standard_input()
+{
+    static Reader reader{STDIN_FILENO};
+    reader.tie(&Writer::standard());
+    return reader;
+}
+
+Reader& Reader::in()
+{
+    // Initialized once by whichever thread reads first, the other threads wait for it
+    static Reader& reader{standard_input()};
+    return current ? *current : reader;
+}
+
+Reader* Reader::enter(Reader* reader)
+{
+    Reader* previous{current};
+    current = reader;
+    return previous;
+}
+
+void Reader::tie(Writer* writer)
+{
+    tied = writer;
+}
+
+bool Reader::read_line(String& line)
+{
+    while (true)
+    {
+        const char* newline{static_cast<const char*>(std::memchr(begin, '\n', end - begin))};
+        if (newline)
+        {
+            line.assign(begin, newline);
+            begin = newline + 1;
+            return true;
+        }
+
+        if (!fill())
+        {
+            if (begin == end) { return false; }
+            line.assign(begin, end);
+            begin = end;
+            return true;
+        }
+    }
+}
+
+String Reader::read_all()
+{
+    String result(begin, end);
+    begin = end;
+
+    while (fill())
+    {
+        result.append(begin, end);
+        begin = end;
+    }
+
+    return result;
+}
+
+bool Reader::done()
+{
+    return begin == end && !fill();
+}
+
+void Reader::map()
+{
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) { return; }
+
+    off_t offset{::lseek(fd, 0, SEEK_CUR)};
+    if (offset < 0 || offset >= info.st_size) { return; }
+
+    void* data{::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    if (data == MAP_FAILED) { return; }
+    ::madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    mapped = static_cast<char*>(data);
+    mapped_size = static_cast<size_t>(info.st_size);
+    begin = mapped + offset;
+    end = mapped + mapped_size;
+    // The whole file is available, there is nothing more to read from the descriptor
+    eof = true;
+}
+
+bool Reader::fill()
+{
+    if (eof) { return false; }
+
+    // Keep the unread part of the buffer, growing it if a single line fills all of it
+    size_t left{static_cast<size_t>(end - begin)};
+    if (left == buffer.size()) { buffer.resize(buffer.size() * 2); }
+    else if (left > 0) { std::memmove(buffer.data(), begin, left); }
+    begin = buffer.data();
+    end = begin + left;
+
+    if (tied) { tied->flush(); }
+
+    while (true)
+    {
+        ssize_t count{::read(fd, buffer.data() + left, buffer.size() - left)};
+        if (count < 0)
+        {
+            if (errno == EINTR) { continue; }
+            throw FileError(String("Failed to read input: ") + std::strerror(errno));
+        }
+        if (count == 0)
+        {
+            eof = true;
+            return false;
+        }
+        end = begin + left + count;
+        return true;
+    }
+}
+
+} // namespace funk
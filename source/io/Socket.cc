@@ -0,0 +1,163 @@
+#include "io/Socket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace funk
+{
+
+/**
+ * @brief Fills in the address of a socket file.
+ * @param path Path of the socket file
+ * @return sockaddr_un The address
+ * @throws FileError if the path is too long for a socket address
+ */
+static sockaddr_un address(const String& path)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+    {
+        throw FileError("Invalid socket path: '" + path + "'");
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+/**
+ * @brief Creates a socket that keeps the boundaries of its messages.
+ * @return int The descriptor
+ * @throws FileError if the socket could not be created
+ */
+static int open_socket()
+{
+    int fd{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+    if (fd < 0) { throw FileError(String("Failed to create socket: ") + std::strerror(errno)); }
+    return fd;
+}
+
+Socket::Socket(int fd, const String& path) : fd(fd), path(path) {}
+
+Socket::Socket(Socket&& other) noexcept : fd(other.fd), path(std::move(other.path))
+{
+    other.fd = -1;
+    other.path.clear();
+}
+
+Socket::~Socket()
+{
+    if (fd >= 0) { ::close(fd); }
+    if (!path.empty()) { ::unlink(path.c_str()); }
+}
+
+Socket Socket::listen(const String& path)
+{
+    sockaddr_un addr{address(path)};
+    Socket socket{open_socket()};
+
+    // A server that was killed leaves its socket file behind, anything else at the path is kept
+    struct stat info{};
+    if (::lstat(path.c_str(), &info) == 0)
+    {
+        if (!S_ISSOCK(info.st_mode)) { throw FileError("Not a socket, refusing to replace: " + path); }
+        Socket probe{open_socket()};
+        if (::connect(probe.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0)
+        {
+            throw FileError("Socket is in use by another server: " + path);
+        }
+        ::unlink(path.c_str());
+    }
+    if (::bind(socket.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(socket.fd, SOMAXCONN) < 0)
+    {
+        throw FileError("Failed to listen on socket: " + path + " (" + std::strerror(errno) + ")");
+    }
+    socket.path = path;
+    return socket;
+}
+
+Socket Socket::connect(const String& path)
+{
+    sockaddr_un addr{address(path)};
+    Socket socket{open_socket()};
+    if (::connect(socket.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        throw FileError("Failed to connect to socket: " + path + " (" + std::strerror(errno) + ")");
+    }
+    return socket;
+}
+
+Socket Socket::accept() const
+{
+    while (true)
+    {
+        int connection{::accept4(fd, nullptr, nullptr, SOCK_CLOEXEC)};
+        if (connection >= 0) { return Socket{connection}; }
+        if (errno != EINTR && errno != ECONNABORTED)
+        {
+            throw FileError(String("Failed to accept connection: ") + std::strerror(errno));
+        }
+    }
+}
+
+void Socket::send(const String& message, const Vector<int>& fds) const
+{
+    if (message.size() > MAX_MESSAGE || fds.size() > MAX_FDS) { throw FileError("Message too large to send"); }
+
+    iovec data{const_cast<char*>(message.data()), message.size()};
+    msghdr header{};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)]{};
+    if (!fds.empty())
+    {
+        header.msg_control = control;
+        header.msg_controllen = CMSG_SPACE(sizeof(int) * fds.size());
+        cmsghdr* rights{CMSG_FIRSTHDR(&header)};
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        std::memcpy(CMSG_DATA(rights), fds.data(), sizeof(int) * fds.size());
+    }
+
+    while (::sendmsg(fd, &header, MSG_NOSIGNAL) < 0)
+    {
+        if (errno != EINTR) { throw FileError(String("Failed to send message: ") + std::strerror(errno)); }
+    }
+}
+
+bool Socket::receive(String& message, Vector<int>& fds) const
+{
+    message.resize(MAX_MESSAGE);
+    iovec data{message.data(), message.size()};
+    msghdr header{};
+    header.msg_iov = &data;
+    header.msg_iovlen = 1;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_FDS)]{};
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    ssize_t received{-1};
+    while ((received = ::recvmsg(fd, &header, MSG_CMSG_CLOEXEC)) < 0)
+    {
+        if (errno != EINTR) { throw FileError(String("Failed to receive message: ") + std::strerror(errno)); }
+    }
+
+    fds.clear();
+    for (cmsghdr* rights{CMSG_FIRSTHDR(&header)}; rights; rights = CMSG_NXTHDR(&header, rights))
+    {
+        if (rights->cmsg_level != SOL_SOCKET || rights->cmsg_type != SCM_RIGHTS) { continue; }
+        size_t count{(rights->cmsg_len - CMSG_LEN(0)) / sizeof(int)};
+        fds.resize(fds.size() + count);
+        std::memcpy(fds.data() + fds.size() - count, CMSG_DATA(rights), sizeof(int) * count);
+    }
+
+    message.resize(static_cast<size_t>(received));
+    return received > 0 || !fds.empty();
+}
+
+} // namespace funk
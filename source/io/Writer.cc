@@ -0,0 +1,137 @@
+#include "io/Writer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace funk
+{
+
+thread_local Writer* Writer::current{nullptr};
+
+Writer::Writer(int fd, size_t capacity, bool owns_fd) :
+    fd(fd), owns_fd(owns_fd), buffer(std::max<size_t>(capacity, 1))
+{
+}
+
+Writer::Writer(const String& path, bool append, size_t capacity) : Writer(-1, capacity, true)
+{
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    if (fd < 0) { throw FileError("Failed to open file: " + path + " (" + std::strerror(errno) + ")"); }
+}
+
+Writer::Writer(String* sink, size_t capacity) : Writer(-1, capacity, false)
+{
+    this->sink = sink;
+}
+
+Writer::~Writer()
+{
+    try
+    {
+        flush();
+    }
+    catch (const FileError&)
+    {
+        // Nothing sensible left to do with the output
+    }
+
+    if (owns_fd && fd >= 0) { ::close(fd); }
+}
+
+Writer& Writer::out()
+{
+    return current ? *current : standard();
+}
+
+Writer& Writer::standard()
+{
+    static Writer writer{STDOUT_FILENO};
+    return writer;
+}
+
+Writer* Writer::enter(Writer* writer)
+{
+    Writer* previous{current};
+    current = writer;
+    return previous;
+}
+
+void Writer::write(const String& text)
+{
+    write(text.data(), text.size());
+}
+
+void Writer::write(const char* data, size_t size)
+{
+    std::lock_guard<std::mutex> guard{lock};
+
+    // Large writes bypass the buffer instead of being copied through it
+    if (size >= buffer.size())
+    {
+        flush_buffer();
+        write_fd(data, size);
+        return;
+    }
+
+    if (used + size > buffer.size()) { flush_buffer(); }
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+void Writer::put(char c)
+{
+    std::lock_guard<std::mutex> guard{lock};
+    if (used == buffer.size()) { flush_buffer(); }
+    buffer[used++] = c;
+}
+
+void Writer::flush()
+{
+    std::lock_guard<std::mutex> guard{lock};
+    flush_buffer();
+}
+
+void Writer::flush_buffer()
+{
+    if (used == 0) { return; }
+    size_t pending{used};
+    used = 0;
+    write_fd(buffer.data(), pending);
+}
+
+void Writer::set_capacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> guard{lock};
+    flush_buffer();
+    buffer.assign(std::max<size_t>(capacity, 1), '\0');
+}
+
+size_t Writer::get_capacity() const
+{
+    return buffer.size();
+}
+
+void Writer::write_fd(const char* data, size_t size)
+{
+    if (sink)
+    {
+        sink->append(data, size);
+        return;
+    }
+
+    while (size > 0)
+    {
+        ssize_t written{::write(fd, data, size)};
+        if (written < 0)
+        {
+            if (errno == EINTR) { continue; }
+            throw FileError(String("Failed to write output: ") + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+} // namespace funk
@@ -14,12 +14,19 @@ static const HashMap<String, TokenType> keywords = {
     {"case", TokenType::CASE},
     {"none", TokenType::NONE},
     {"return", TokenType::RETURN},
+    {"spawn", TokenType::SPAWN},
+    {"await", TokenType::AWAIT},
+    {"yield", TokenType::YIELD},
 
     {"numb", TokenType::NUMB_TYPE},
     {"real", TokenType::REAL_TYPE},
     {"bool", TokenType::BOOL_TYPE},
     {"char", TokenType::CHAR_TYPE},
     {"text", TokenType::TEXT_TYPE},
+    {"task", TokenType::TASK_TYPE},
+    {"chan", TokenType::CHANNEL_TYPE},
+    {"gen", TokenType::GENERATOR_TYPE},
+    {"map", TokenType::MAP_TYPE},
 
     {"true", TokenType::BOOL},
     {"false", TokenType::BOOL},
@@ -62,9 +69,16 @@ Token Lexer::next_token()
     case ']': return make_token(lexeme, TokenType::R_BRACKET);
     case ',': return make_token(lexeme, TokenType::COMMA);
     case '.': return make_token(lexeme, TokenType::DOT);
+    case ':': return make_token(lexeme, TokenType::COLON);
     case ';': return make_token(lexeme, TokenType::SEMICOLON);
-    case '%': return make_token(lexeme, TokenType::MODULO);
-    case '^': return make_token(lexeme, TokenType::POWER);
+
+    case '%':
+        if (match('=')) { return make_token(lexeme + '=', TokenType::MODULO_ASSIGN); }
+        return make_token(lexeme, TokenType::MODULO);
+
+    case '^':
+        if (match('=')) { return make_token(lexeme + '=', TokenType::POWER_ASSIGN); }
+        return make_token(lexeme, TokenType::POWER);
 
     case '+':
         if (match('=')) { return make_token(lexeme + '=', TokenType::PLUS_ASSIGN); }
@@ -198,8 +212,15 @@ Token Lexer::get_number()
         return make_token(lexeme, TokenType::REAL, std::stod(lexeme));
     }
 
-    // Convert to int as the value
-    return make_token(lexeme, TokenType::NUMB, std::stoi(lexeme));
+    // Convert to a 64-bit numb as the value
+    try
+    {
+        return make_token(lexeme, TokenType::NUMB, static_cast<Numb>(std::stoll(lexeme)));
+    }
+    catch (const std::out_of_range&)
+    {
+        return error_token(lexeme, "Numb literal out of range");
+    }
 }
 
 Token Lexer::get_identifier()
@@ -23,6 +23,7 @@ void Logger::log(LogLevel level, const std::string& message)
 {
     if (level < log_level) return;
 
+    std::lock_guard<std::mutex> guard{lock};
     auto now = std::chrono::system_clock::now();
     auto time = std::chrono::system_clock::to_time_t(now);
 
@@ -50,6 +51,7 @@ void Logger::log(LogLevel level, const std::string& message)
 
 void Logger::set_file(const std::string& path)
 {
+    std::lock_guard<std::mutex> guard{lock};
     if (log_file.is_open()) { log_file.close(); }
     log_path = path;
     file_open();
@@ -6,10 +6,28 @@
  * and from lexing to evaluation.
  */
 
+#include "io/Reader.h"
+#include "io/Socket.h"
+#include "io/Writer.h"
 #include "logging/LogMacros.h"
+#include "optimizer/PassManager.h"
 #include "parser/Parser.h"
+#include "parser/Registry.h"
+#include "runtime/Budget.h"
+#include "runtime/Multiplexer.h"
+#include "runtime/Scheduler.h"
+#include "runtime/TaskGroup.h"
 #include "utils/ArgParser.h"
 #include "utils/Common.h"
+#include "utils/Stats.h"
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 using namespace funk;
 
@@ -23,6 +41,23 @@ HashMap<String, String> options{
     {"--debug", "Enable debug logging"},
     {"--ast", "Log the AST representation"},
     {"--tokens", "Log the lexical tokens"},
+    {"--buffer=<bytes>", "Set the size of the output buffer"},
+    {"--stats[=<file>]", "Print runtime statistics, or write them as JSON to a file"},
+    {"-O0, -O1, -O2", "Set the optimization level, default is -O1"},
+    {"--dump-after=<pass>", "Log the AST after an optimization pass"},
+    {"--big-numbs", "Promote numbs that overflow to arbitrary precision instead of failing"},
+    {"--threads=<n>", "Set the number of worker threads that run spawned tasks, default is one per core"},
+    {"--auto-parallel", "Evaluate independent calls to pure functions in parallel"},
+    {"--multiplex=<n>", "Run all given files side by side, taking turns on n threads"},
+    {"--slice=<steps>", "Set the loop iterations and calls a multiplexed file takes per turn, default is 10000"},
+    {"--max-steps=<n>", "Fail a run that takes more than n loop iterations and calls"},
+    {"--max-memory=<bytes>", "Fail a run that holds more than the given bytes of nodes and values"},
+    {"--timeout=<ms>", "Fail a run that takes longer than the given milliseconds"},
+    {"--batch", "Run all given files side by side, then print the output of each file in turn and the total time"},
+    {"--batch-from=<file>", "Add the files listed in a file, one path per line, to the batch"},
+    {"--serve=<socket>", "Run files for clients that connect to a socket, keeping compiled files until they change"},
+    {"--client=<socket>", "Run the file through the server that listens on a socket"},
+    {"-j <n>", "Set the number of threads that batch or multiplexed files run on, default for a batch is one per core"},
 };
 
 /**
@@ -31,9 +66,31 @@ HashMap<String, String> options{
  */
 struct Config
 {
-    bool debug{false};  ///< Enable debug level logging
-    bool ast{false};    ///< Print AST representation
-    bool tokens{false}; ///< Print lexical tokens
+    bool debug{false};                          ///< Enable debug level logging
+    bool ast{false};                            ///< Print AST representation
+    bool tokens{false};                         ///< Print lexical tokens
+    bool stats{false};                          ///< Report runtime statistics
+    String stats_file;                          ///< File to write statistics to as JSON, empty to print them
+    int optimize{PassManager::DEFAULT_LEVEL};   ///< Optimization level
+    String dump_after;                          ///< Optimization pass to log the AST after, empty for none
+    bool parallel{false};                       ///< Evaluate independent calls to pure functions in parallel
+    size_t multiplex{0};                        ///< Threads that multiplexed files take turns on, 0 to run one file
+    uint64_t slice{Multiplexer::DEFAULT_SLICE}; ///< Steps a multiplexed file takes per turn
+    Budget::Limits limits{};                    ///< Limits of every run, none by default
+    bool batch{false};                          ///< Capture the output of every file and print it once all are done
+};
+
+/**
+ * @brief Outcome of a file that ran in a batch
+ * The output of the file is captured while it runs and printed after all files of the batch are done
+ */
+struct BatchRun
+{
+    String output{};                                   ///< Output that the file printed
+    Writer writer{&output};                            ///< Writer that the file prints to
+    std::ostringstream errors{};                       ///< Error messages of the file
+    int status{0};                                     ///< Exit status, 0 if the file succeeded
+    std::chrono::duration<double, std::milli> time{0}; ///< Wall-clock time from the start to the end of the file
 };
 
 /**
@@ -69,69 +126,664 @@ bool setup(ArgParser& parser, Config& config)
         logger().set_level(LogLevel::DEBUG);
     }
 
+    // Set the output buffer size
+    if (parser.has_option("--buffer"))
+    {
+        size_t size{0};
+        try
+        {
+            size = std::stoul(parser.get_option("--buffer"));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (size == 0)
+        {
+            cerr << "Invalid output buffer size!\n";
+            return false;
+        }
+        Writer::out().set_capacity(size);
+    }
+
+    // Set the number of worker threads
+    if (parser.has_option("--threads"))
+    {
+        size_t count{0};
+        try
+        {
+            count = std::stoul(parser.get_option("--threads"));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (count == 0)
+        {
+            cerr << "Invalid number of threads!\n";
+            return false;
+        }
+        Scheduler::instance().set_workers(count);
+    }
+
+    // Run the files side by side
+    if (parser.has_option("--multiplex"))
+    {
+        try
+        {
+            config.multiplex = std::stoul(parser.get_option("--multiplex"));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (config.multiplex == 0)
+        {
+            cerr << "Invalid number of multiplexing threads!\n";
+            return false;
+        }
+    }
+
+    if (parser.has_option("-j"))
+    {
+        config.multiplex = 0;
+        try
+        {
+            config.multiplex = std::stoul(parser.get_option("-j"));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (config.multiplex == 0)
+        {
+            cerr << "Invalid number of threads for -j!\n";
+            return false;
+        }
+    }
+
+    // Capture the output of every file, the files run on one thread per core unless told otherwise
+    config.batch = parser.has_option("--batch") || parser.has_option("--batch-from");
+    if (config.batch && config.multiplex == 0)
+    {
+        config.multiplex = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    if (parser.has_option("--slice"))
+    {
+        config.slice = 0;
+        try
+        {
+            config.slice = std::stoull(parser.get_option("--slice"));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (config.slice == 0)
+        {
+            cerr << "Invalid time slice!\n";
+            return false;
+        }
+    }
+
+    // Set the limits of a run
+    for (const char* limit : {"--max-steps", "--max-memory", "--timeout"})
+    {
+        if (!parser.has_option(limit)) { continue; }
+
+        uint64_t value{0};
+        try
+        {
+            value = std::stoull(parser.get_option(limit));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        if (value == 0)
+        {
+            cerr << "Invalid value for " << limit << "!\n";
+            return false;
+        }
+        if (limit == String{"--max-steps"}) { config.limits.steps = value; }
+        else if (limit == String{"--max-memory"}) { config.limits.memory = value; }
+        else { config.limits.timeout = std::chrono::milliseconds{value}; }
+    }
+
     // Set other configuration options
     config.ast = parser.has_option("--ast");
     config.tokens = parser.has_option("--tokens");
+    config.stats = parser.has_option("--stats");
+    config.parallel = parser.has_option("--auto-parallel");
+    if (config.stats) { config.stats_file = parser.get_option("--stats"); }
+    NodeValue::set_numb_promotion(parser.has_option("--big-numbs"));
+
+    // Set the optimization level
+    for (int level{0}; level <= PassManager::MAX_LEVEL; level++)
+    {
+        if (parser.has_option("-O" + to_str(level))) { config.optimize = level; }
+    }
+
+    if (parser.has_option("--dump-after"))
+    {
+        config.dump_after = parser.get_option("--dump-after");
+        PassManager passes{config.optimize, config.parallel};
+        if (!passes.has_pass(config.dump_after))
+        {
+            cerr << "Unknown optimization pass '" << config.dump_after << "' at -O" << config.optimize << "!\n";
+            return false;
+        }
+    }
 
     return true;
 }
 
 /**
- * @brief Process a single Funk source file
- * Handles the complete execution pipeline: lexing, parsing, and evaluation
+ * @brief Report the runtime statistics of the last run
+ * Prints the statistics to stderr, or writes them as JSON if a file was given
+ * @param config Runtime configuration options
+ * @param passes The pass manager that optimized the program, nullptr if every file had its own
+ */
+void report_stats(const Config& config, const PassManager* passes)
+{
+    if (config.stats_file.empty())
+    {
+        if (passes) { cerr << passes->report(); }
+        cerr << Stats::instance().to_s();
+        return;
+    }
+
+    std::ofstream file{config.stats_file};
+    if (!file.is_open())
+    {
+        cerr << "Could not open statistics file '" << config.stats_file << "'\n";
+        return;
+    }
+    file << Stats::instance().to_json();
+}
+
+/**
+ * @brief Compile a Funk source file
+ * Lexes, parses and optimizes the file
  * @param file Path to the source file
  * @param config Runtime configuration options
+ * @param args Arguments passed to the program
+ * @param passes The pass manager that optimizes the program
+ * @return Node* The optimized program
  */
-void process_file(const String& file, const Config& config, const Vector<String>& args)
+Node* compile_file(const String& file, const Config& config, const Vector<String>& args, PassManager& passes)
 {
-    LOG_INFO("Processing file: " + file);
+    LOG_DEBUG("Lexing file...");
+    Lexer lexer{read_file(file), file};
+    Vector<Token> tokens{lexer.tokenize()};
+    LOG_DEBUG("Tokens lexed!");
 
-    try
+    if (config.tokens)
     {
-        LOG_DEBUG("Lexing file...");
-        Lexer lexer{read_file(file), file};
-        Vector<Token> tokens{lexer.tokenize()};
-        LOG_DEBUG("Tokens lexed!");
+        LOG_INFO("Tokens:");
+        for (const auto& token : tokens) { LOG_INFO(token); }
+    }
 
-        if (config.tokens)
-        {
-            LOG_INFO("Tokens:");
-            for (const auto& token : tokens) { LOG_INFO(token); }
-        }
+    LOG_DEBUG("Parsing file...");
+    Parser parser{tokens, file};
+    Node* ast = parser.parse(args);
+    LOG_DEBUG("File parsed!");
 
-        LOG_DEBUG("Parsing file...");
-        Parser parser{tokens, file};
-        Node* ast = parser.parse(args);
-        LOG_DEBUG("File parsed!");
+    if (config.ast)
+    {
+        LOG_INFO("Abstract Syntax Tree:");
+        std::istringstream stream(ast->to_s());
+        String line;
+        while (getline(stream, line)) { LOG_INFO(line); }
+    }
 
-        if (config.ast)
-        {
-            LOG_INFO("Abstract Syntax Tree:");
-            std::istringstream stream(ast->to_s());
-            String line;
-            while (getline(stream, line)) { LOG_INFO(line); }
-        }
+    LOG_DEBUG("Optimizing AST...");
+    passes.dump_after(config.dump_after);
+    ast = passes.run(ast);
+    LOG_DEBUG("AST optimized!");
+    return ast;
+}
+
+/**
+ * @brief Run a Funk program, reporting its errors
+ * @param file Path to the source file of the program
+ * @param config Runtime configuration options
+ * @param compile Gives the program to evaluate, errors it throws are reported like those of the evaluation
+ * @param errors Stream that the errors of the program are reported to
+ * @return int Exit status of the program, 1 if it failed with an error
+ */
+int run_program(const String& file, const Config& config, const std::function<Node*()>& compile, std::ostream& errors)
+{
+    try
+    {
+        Node* ast{compile()};
+
+        // Only count what happens at runtime, multiplexed files share the counts of their threads
+        if (config.multiplex == 0) { Stats::instance().reset(); }
 
         LOG_DEBUG("Evaluating AST...");
         Node* res{ast->evaluate()};
         LOG_DEBUG("AST evaluated!");
         if (!res) { LOG_INFO("Result: nullptr"); }
         else { LOG_INFO("Result: " + res->to_s()); }
+        Writer::out().flush();
+        return 0;
+    }
+    catch (const ProgramExit& e)
+    {
+        // exit() already flushed the output
+        LOG_INFO("File " + file + " exited with status " + to_str(e.get_status()));
+        return e.get_status();
     }
     catch (const FunkError& e)
     {
+        // Keep program output ahead of the error message
+        Writer::out().flush();
         LOG_ERROR("Error processing file " + file + ": " + e.what());
-        cerr << "Error: " << e.trace() << endl;
+        errors << "Error: " << e.trace() << endl;
     }
     catch (const FileError& e)
     {
+        Writer::out().flush();
         LOG_ERROR(e.what());
-        cerr << e.what() << endl;
+        errors << e.what() << endl;
     }
     catch (const std::exception& e)
     {
+        Writer::out().flush();
         LOG_ERROR("Unknown error occurred: " + String(e.what()));
-        cerr << "Unknown error occurred: " << e.what() << endl;
+        errors << "Unknown error occurred: " << e.what() << endl;
+    }
+    return 1;
+}
+
+/**
+ * @brief Run a Funk source file, reporting its errors
+ * Handles the complete execution pipeline: lexing, parsing, optimization and evaluation
+ * @param file Path to the source file
+ * @param config Runtime configuration options
+ * @param args Arguments passed to the program
+ * @param passes The pass manager that optimizes the program
+ * @param errors Stream that the errors of the program are reported to
+ * @return int Exit status of the program, 1 if it failed with an error
+ */
+int run_file(const String& file, const Config& config, const Vector<String>& args, PassManager& passes,
+    std::ostream& errors)
+{
+    return run_program(file, config, [&] { return compile_file(file, config, args, passes); }, errors);
+}
+
+/**
+ * @brief Process a single Funk source file
+ * @param file Path to the source file
+ * @param config Runtime configuration options
+ * @param args Arguments passed to the program
+ */
+void process_file(const String& file, const Config& config, const Vector<String>& args)
+{
+    LOG_INFO("Processing file: " + file);
+    PassManager passes{config.optimize, config.parallel};
+    std::unique_ptr<Budget> budget{config.limits.any() ? std::make_unique<Budget>(config.limits) : nullptr};
+    Budget::enter(budget.get());
+    run_file(file, config, args, passes, cerr);
+
+    // Tasks that were never awaited finish before the statistics are reported
+    Scheduler::instance().shutdown();
+    Budget::enter(nullptr);
+    Writer::out().flush();
+
+    if (config.stats) { report_stats(config, &passes); }
+}
+
+/**
+ * @brief Print the captured output of a batch and how long it took
+ * The output of the files goes to stdout and their errors to stderr, each in the order the files were given and
+ * headed by the path of the file, followed by the aggregate timing on stderr
+ * @param files Paths to the source files
+ * @param runs Outcomes of the files
+ * @param config Runtime configuration options
+ * @param wall Wall-clock time of the whole batch
+ */
+void report_batch(const Vector<String>& files, Vector<BatchRun>& runs, const Config& config,
+    std::chrono::duration<double, std::milli> wall)
+{
+    for (size_t i{0}; i < files.size(); i++)
+    {
+        // Tasks that were never awaited may have printed after their file ended
+        runs[i].writer.flush();
+        Writer::out().write("==> " + files[i] + " <==\n");
+        Writer::out().write(runs[i].output);
+    }
+    Writer::out().flush();
+
+    size_t failed{0};
+    std::chrono::duration<double, std::milli> total{0};
+    size_t slowest{0};
+    for (size_t i{0}; i < files.size(); i++)
+    {
+        const BatchRun& run{runs[i]};
+        total += run.time;
+        if (run.time > runs[slowest].time) { slowest = i; }
+        if (run.status == 0) { continue; }
+
+        // Files that called exit() with a status other than 0 have no error message
+        failed++;
+        String errors{run.errors.str()};
+        cerr << "==> " << files[i] << " <==\n" << errors;
+        if (errors.empty()) { cerr << "Exited with status " << run.status << "\n"; }
+    }
+
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(2) << "Batch: " << files.size() << " files, " << files.size() - failed
+            << " succeeded, " << failed << " failed in " << wall.count() << " ms on " << config.multiplex << " threads";
+    if (!files.empty())
+    {
+        summary << " (" << total.count() << " ms of runs, slowest " << files[slowest] << " in "
+                << runs[slowest].time.count() << " ms)";
+    }
+    cerr << summary.str() << endl;
+}
+
+/**
+ * @brief Process Funk source files side by side
+ * Every file runs in a fiber with a scope stack, registry and budget of its own, the fibers take turns on a few
+ * threads so that a file that runs for long can't hold up the others. In a batch every file also prints to a writer
+ * of its own, and the output of all files is printed once they are done.
+ * @param files Paths to the source files
+ * @param config Runtime configuration options
+ * @return size_t Number of files that failed or exited with a status other than 0
+ */
+size_t process_files(const Vector<String>& files, const Config& config)
+{
+    // Tasks that were never awaited may still run after their file ended, so they keep its registry, budget and writer
+    Vector<std::unique_ptr<Registry>> registries(files.size());
+    Vector<std::unique_ptr<Budget>> budgets(files.size());
+    Vector<BatchRun> runs(files.size());
+
+    Multiplexer multiplexer{config.multiplex, config.slice};
+    for (size_t i{0}; i < files.size(); i++)
+    {
+        multiplexer.add(
+            [&, i]
+            {
+                LOG_INFO("Processing file: " + files[i]);
+                auto started = std::chrono::steady_clock::now();
+                Scope scope{};
+                registries[i] = std::make_unique<Registry>();
+                if (config.limits.any()) { budgets[i] = std::make_unique<Budget>(config.limits); }
+                Scope::enter(&scope);
+                Registry::enter(registries[i].get());
+                Budget::enter(budgets[i].get());
+                if (config.batch) { Writer::enter(&runs[i].writer); }
+
+                PassManager passes{config.optimize, config.parallel};
+                runs[i].status = run_file(files[i], config, {}, passes, config.batch ? runs[i].errors : cerr);
+
+                // The scopes refer to nodes of the program, pop them before the scope stack is deleted
+                while (scope.get_depth() > 0) { scope.pop(); }
+                Scope::enter(nullptr);
+                Registry::enter(nullptr);
+                Budget::enter(nullptr);
+                Writer::enter(nullptr);
+                runs[i].time = std::chrono::steady_clock::now() - started;
+            });
+    }
+
+    if (config.batch) { LOG_INFO("Running a batch of " + to_str(files.size()) + " files"); }
+    auto started = std::chrono::steady_clock::now();
+    Stats::instance().reset();
+    multiplexer.run();
+
+    Scheduler::instance().shutdown();
+    Writer::out().flush();
+
+    if (config.batch)
+    {
+        report_batch(files, runs, config, std::chrono::steady_clock::now() - started);
+    }
+    if (config.stats) { report_stats(config, nullptr); }
+
+    size_t failed{0};
+    for (const BatchRun& run : runs) { failed += run.status != 0 ? 1 : 0; }
+    return failed;
+}
+
+/**
+ * @brief Read the paths of a batch from a file
+ * @param path Path to the file that lists one source file per line, blank lines are skipped
+ * @param files The paths to add to
+ * @return bool True if the file could be read
+ */
+bool read_batch(const String& path, Vector<String>& files)
+{
+    std::ifstream list{path};
+    if (!list.is_open())
+    {
+        cerr << "Could not open batch file '" << path << "'\n";
+        return false;
+    }
+
+    String line;
+    while (getline(list, line))
+    {
+        size_t start{line.find_first_not_of(" \t\r")};
+        if (start == String::npos) { continue; }
+        size_t end{line.find_last_not_of(" \t\r")};
+        files.push_back(line.substr(start, end - start + 1));
+    }
+    return true;
+}
+
+/**
+ * @brief Programs compiled by a server, by the path of their source file
+ * A program is compiled again once the modification time or size of its file changes
+ */
+struct ProgramCache
+{
+    /**
+     * @brief A compiled program and the version of the file it was compiled from
+     */
+    struct Program
+    {
+        timespec modified{}; ///< Modification time of the file
+        off_t size{0};       ///< Size of the file
+        Node* ast{nullptr};  ///< The optimized program
+    };
+
+    HashMap<String, Program> programs{}; ///< Programs by the path of their file
+    Vector<Node*> replaced{};            ///< Programs of files that changed, unawaited tasks may still use their nodes
+    std::mutex lock{};                   ///< Serializes lookups and compilations
+
+    /**
+     * @brief Get the program of a file, compiling it if it is new or changed
+     * @param file Path to the source file
+     * @param config Runtime configuration options
+     * @return Node* The optimized program, owned by the cache
+     * @throws FileError if the file can't be read, or the error that the compilation failed with
+     */
+    Node* get(const String& file, const Config& config)
+    {
+        struct stat info{};
+        if (::stat(file.c_str(), &info) < 0) { throw FileError("Failed to open file: " + file); }
+
+        std::lock_guard<std::mutex> guard{lock};
+        auto found = programs.find(file);
+        if (found != programs.end() && found->second.size == info.st_size &&
+            found->second.modified.tv_sec == info.st_mtim.tv_sec &&
+            found->second.modified.tv_nsec == info.st_mtim.tv_nsec)
+        {
+            return found->second.ast;
+        }
+
+        LOG_INFO("Compiling file: " + file);
+        PassManager passes{config.optimize, config.parallel};
+        Node* ast{compile_file(file, config, {}, passes)};
+        if (found != programs.end()) { replaced.push_back(found->second.ast); }
+        programs[file] = Program{info.st_mtim, info.st_size, ast};
+        return ast;
+    }
+};
+
+/**
+ * @brief Run a file for a client of the server
+ * The request holds the absolute path of the file followed by the arguments of the program, separated by null
+ * characters, and comes with the standard input, output and error of the client. The program runs with a scope
+ * stack, registry, budget, reader, writer and task group of its own, and its exit status is sent back once it and
+ * its tasks are done.
+ * @param connection The connection to the client
+ * @param config Runtime configuration options
+ * @param cache The programs compiled so far
+ */
+void serve_client(Socket connection, const Config& config, ProgramCache& cache)
+{
+    String request;
+    Vector<int> fds{};
+    try
+    {
+        if (!connection.receive(request, fds) || fds.size() != 3 || request.empty())
+        {
+            for (int fd : fds) { ::close(fd); }
+            return;
+        }
+    }
+    catch (const FileError& e)
+    {
+        LOG_ERROR(e.what());
+        return;
+    }
+
+    Vector<String> fields{};
+    std::istringstream stream{request};
+    for (String field; getline(stream, field, '\0');) { fields.push_back(field); }
+    const String file{fields.front()};
+    const Vector<String> args(fields.begin() + 1, fields.end());
+    LOG_INFO("Serving file: " + file);
+
+    // The arguments are declared ahead of the cached program, which is compiled without them
+    std::unique_ptr<Node> arguments{};
+    std::unique_ptr<Budget> budget{config.limits.any() ? std::make_unique<Budget>(config.limits) : nullptr};
+    Scope scope{};
+    Registry registry{};
+    Reader reader{fds[0]};
+    Writer writer{fds[1]};
+    TaskGroup tasks{};
+    reader.tie(&writer);
+    Scope::enter(&scope);
+    Registry::enter(&registry);
+    Budget::enter(budget.get());
+    Reader::enter(&reader);
+    Writer::enter(&writer);
+    TaskGroup::enter(&tasks);
+    scope.push();
+
+    std::ostringstream errors{};
+    int status{run_program(file, config,
+        [&]
+        {
+            Node* ast{cache.get(file, config)};
+            if (!args.empty())
+            {
+                arguments.reset(Parser::declare_args(args, file));
+                arguments->evaluate();
+            }
+            return ast;
+        },
+        errors)};
+
+    // Tasks that were never awaited use the registry, budget, reader and writer of the run until they finish
+    tasks.wait();
+    while (scope.get_depth() > 0) { scope.pop(); }
+    Scope::enter(nullptr);
+    Registry::enter(nullptr);
+    Budget::enter(nullptr);
+    Reader::enter(nullptr);
+    Writer::enter(nullptr);
+    TaskGroup::enter(nullptr);
+
+    try
+    {
+        writer.flush();
+        Writer error_writer{fds[2]};
+        error_writer.write(errors.str());
+        error_writer.flush();
+        connection.send(String(reinterpret_cast<const char*>(&status), sizeof(status)));
+    }
+    catch (const FileError& e)
+    {
+        // The client went away before its program was done
+        LOG_ERROR(e.what());
+    }
+    for (int fd : fds) { ::close(fd); }
+}
+
+/**
+ * @brief Serve runs of Funk source files to clients that connect to a socket
+ * Every connection runs a file on a thread of its own, so the process starts and the log file opens only once, and a
+ * file is only compiled again once it changes
+ * @param path Path of the socket file
+ * @param config Runtime configuration options
+ * @return int Exit code, only returned if the socket could not be set up
+ */
+int serve(const String& path, const Config& config)
+{
+    // A client that goes away while its program prints must not end the server
+    std::signal(SIGPIPE, SIG_IGN);
+
+    ProgramCache cache{};
+    try
+    {
+        Socket server{Socket::listen(path)};
+        LOG_INFO("Serving on socket: " + path);
+        while (true) { std::thread{serve_client, server.accept(), std::cref(config), std::ref(cache)}.detach(); }
+    }
+    catch (const FileError& e)
+    {
+        LOG_ERROR(e.what());
+        cerr << e.what() << endl;
+    }
+    return 1;
+}
+
+/**
+ * @brief Run a Funk source file through a server
+ * Sends the file and the arguments to the server along with the standard input, output and error, which the program
+ * uses directly, and waits for its exit status
+ * @param path Path of the socket file of the server
+ * @param file Path to the source file
+ * @param args Arguments passed to the program
+ * @return int Exit status of the program
+ */
+int run_client(const String& path, const String& file, const Vector<String>& args)
+{
+    // The server resolves paths against a working directory of its own
+    String request{std::filesystem::absolute(file).lexically_normal().string()};
+    for (const String& arg : args)
+    {
+        request += '\0';
+        request += arg;
+    }
+
+    try
+    {
+        Socket connection{Socket::connect(path)};
+        connection.send(request, {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO});
+
+        String reply;
+        Vector<int> fds{};
+        int status{0};
+        if (!connection.receive(reply, fds) || reply.size() != sizeof(status))
+        {
+            cerr << "The server closed the connection before the file was done\n";
+            return 1;
+        }
+        std::memcpy(&status, reply.data(), sizeof(status));
+        return status;
+    }
+    catch (const FileError& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
     }
 }
 
@@ -150,9 +802,8 @@ void repl()
 
     while (true)
     {
-        cout << ">>> ";
-        cout.flush();
-        if (!getline(cin, input)) { break; }
+        Writer::out().write(">>> ");
+        if (!Reader::in().read_line(input)) { break; }
         if (input.empty()) { continue; }
 
         try
@@ -167,14 +818,17 @@ void repl()
             BlockNode* ast{static_cast<BlockNode*>(parser.parse())};
 
             Node* result{ast->evaluate_same_scope()};
+            Writer::out().flush();
             if (result) { cout << result->to_s() << endl; }
         }
         catch (const FunkError& e)
         {
+            Writer::out().flush();
             cerr << "Error: " << e.trace() << endl;
         }
         catch (const std::exception& e)
         {
+            Writer::out().flush();
             cerr << "Error: " << e.what() << endl;
         }
         catch (...)
@@ -183,6 +837,8 @@ void repl()
         }
     }
 
+    Scheduler::instance().shutdown();
+    Writer::out().flush();
     Scope::instance().pop();
     cout << "Bye!" << endl;
 }
@@ -196,14 +852,46 @@ void repl()
  */
 int main(int argc, char* argv[])
 {
-    ArgParser parser(argc, argv);
+    ArgParser parser(argc, argv, {"-j"});
     Config config;
 
     // Setup and validate arguments
     if (!setup(parser, config)) { return 1; }
 
+    // Run files for clients, or as a client
+    if (parser.has_option("--serve") || parser.has_option("--client"))
+    {
+        const String option{parser.has_option("--serve") ? "--serve" : "--client"};
+        if (!parser.has_value(option))
+        {
+            cerr << "No socket specified!\n";
+            return 1;
+        }
+        if (option == "--serve") { return serve(parser.get_option(option), config); }
+        if (!parser.has_file())
+        {
+            cerr << "No file specified!\n";
+            return 1;
+        }
+        return run_client(parser.get_option(option), parser.get_file(), parser.get_args());
+    }
+
     // Process each file
-    if (parser.has_file()) { process_file(parser.get_file(), config, parser.get_args()); }
+    if (config.batch)
+    {
+        Vector<String> files{};
+        if (parser.has_option("--batch-from") && !read_batch(parser.get_option("--batch-from"), files)) { return 1; }
+        if (parser.has_file()) { files.push_back(parser.get_file()); }
+        for (const String& file : parser.get_args()) { files.push_back(file); }
+        return process_files(files, config) > 0 ? 1 : 0;
+    }
+    else if (parser.has_file() && config.multiplex > 0)
+    {
+        Vector<String> files{parser.get_file()};
+        for (const String& file : parser.get_args()) { files.push_back(file); }
+        process_files(files, config);
+    }
+    else if (parser.has_file()) { process_file(parser.get_file(), config, parser.get_args()); }
     else { repl(); }
 
     return 0;
@@ -0,0 +1,180 @@
+#include "optimizer/ConstantFolder.h"
+
+namespace funk
+{
+
+/**
+ * @brief Checks if an expression is a literal whole number with the given value.
+ */
+static bool is_numb_literal(const ExpressionNode* expr, Numb value)
+{
+    auto literal = node_cast<LiteralNode>(expr);
+    return literal && literal->get_value().is_a<Numb>() && literal->get_value().get<Numb>() == value;
+}
+
+/**
+ * @brief Checks if an expression is a reference to a variable, which can be evaluated twice without side effects.
+ */
+static bool is_reference(const ExpressionNode* expr)
+{
+    auto var = node_cast<VariableNode>(expr);
+    return var && !var->get_value_node();
+}
+
+ConstantFolder::ConstantFolder() : Pass("fold") {}
+
+void ConstantFolder::prepare(Node*)
+{
+    types.clear();
+}
+
+Node* ConstantFolder::rewrite_block(BlockNode* node)
+{
+    types.emplace_back();
+    rewrite_children(node);
+    types.pop_back();
+    return node;
+}
+
+Node* ConstantFolder::rewrite_function(FunctionNode* node)
+{
+    // The function name shadows any variable with the same name
+    declare(node->get_identifier(), TokenType::NONE);
+
+    // Scopes are dynamic, the body can't rely on declarations around the function
+    Vector<HashMap<String, TokenType>> outer{};
+    outer.swap(types);
+    rewrite_children(node);
+    types.swap(outer);
+    return node;
+}
+
+Node* ConstantFolder::rewrite_declaration(DeclarationNode* node)
+{
+    rewrite_children(node);
+
+    // The initializer is checked against the declared type, later assignments are checked as well
+    declare(node->get_identifier(), node->get_initializer() ? node->get_token_type() : TokenType::NONE);
+    return node;
+}
+
+Node* ConstantFolder::rewrite_binary_op(BinaryOpNode* node)
+{
+    rewrite_children(node);
+
+    auto left = node_cast<LiteralNode>(node->get_left());
+    auto right = node_cast<LiteralNode>(node->get_right());
+    if (!left || !right) { return simplify(node); }
+
+    try
+    {
+        return replace_with_literal(node, BinaryOpNode::apply(node->get_op().get_type(), left->get_value(),
+                                              right->get_value()));
+    }
+    catch (const FunkError&)
+    {
+        // Leave the error to the runtime, which reports it at the operator
+        return node;
+    }
+}
+
+Node* ConstantFolder::rewrite_unary_op(UnaryOpNode* node)
+{
+    rewrite_children(node);
+
+    auto operand = node_cast<LiteralNode>(node->get_expr());
+    if (!operand) { return node; }
+
+    try
+    {
+        return replace_with_literal(node, UnaryOpNode::apply(node->get_op().get_type(), operand->get_value()));
+    }
+    catch (const FunkError&)
+    {
+        return node;
+    }
+}
+
+Node* ConstantFolder::simplify(BinaryOpNode* node)
+{
+    ExpressionNode* left{node->get_left()};
+    ExpressionNode* right{node->get_right()};
+    TokenType left_type{type_of(left)};
+    TokenType right_type{type_of(right)};
+    ExpressionNode* kept{nullptr};
+
+    switch (node->get_op().get_type())
+    {
+    case TokenType::POWER:
+        // x^2 to x*x
+        if (is_numb_literal(right, 2) && is_reference(left) &&
+            (left_type == TokenType::NUMB || left_type == TokenType::REAL))
+        {
+            auto var = static_cast<VariableNode*>(left);
+            Token multiply{node->get_op().get_location(), "*", TokenType::MULTIPLY};
+            auto square = new BinaryOpNode(left, multiply, new VariableNode(var->get_location(), var->get_identifier()));
+            node->set_left(nullptr);
+            delete node;
+            changed++;
+            return square;
+        }
+        break;
+    case TokenType::PLUS:
+        // x+0 and 0+x
+        if (left_type == TokenType::NUMB && is_numb_literal(right, 0)) { kept = left; }
+        else if (right_type == TokenType::NUMB && is_numb_literal(left, 0)) { kept = right; }
+        break;
+    case TokenType::MINUS:
+        // x-0
+        if (left_type == TokenType::NUMB && is_numb_literal(right, 0)) { kept = left; }
+        break;
+    case TokenType::MULTIPLY:
+        // x*1 and 1*x
+        if (left_type == TokenType::NUMB && is_numb_literal(right, 1)) { kept = left; }
+        else if (right_type == TokenType::NUMB && is_numb_literal(left, 1)) { kept = right; }
+        break;
+    case TokenType::DIVIDE:
+        // x/1
+        if (left_type == TokenType::NUMB && is_numb_literal(right, 1)) { kept = left; }
+        break;
+    default: break;
+    }
+
+    if (!kept) { return node; }
+
+    // Detach the kept operand before deleting the operation
+    if (kept == left) { node->set_left(nullptr); }
+    else { node->set_right(nullptr); }
+    delete node;
+    changed++;
+    return kept;
+}
+
+LiteralNode* ConstantFolder::replace_with_literal(ExpressionNode* node, const NodeValue& value)
+{
+    LiteralNode* literal{new LiteralNode(node->get_location(), value)};
+    delete node;
+    changed++;
+    return literal;
+}
+
+TokenType ConstantFolder::type_of(const ExpressionNode* expr) const
+{
+    if (auto literal = node_cast<LiteralNode>(expr)) { return literal->get_value().get_token_type(); }
+    if (!is_reference(expr)) { return TokenType::NONE; }
+
+    const String& name{static_cast<const VariableNode*>(expr)->get_identifier()};
+    for (auto scope = types.rbegin(); scope != types.rend(); scope++)
+    {
+        auto it = scope->find(name);
+        if (it != scope->end()) { return it->second; }
+    }
+    return TokenType::NONE;
+}
+
+void ConstantFolder::declare(const String& name, TokenType type)
+{
+    if (!types.empty()) { types.back()[name] = type; }
+}
+
+} // namespace funk
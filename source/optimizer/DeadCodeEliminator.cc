@@ -0,0 +1,77 @@
+#include "optimizer/DeadCodeEliminator.h"
+
+namespace funk
+{
+
+/**
+ * @brief Gets the value of a condition that is a bool literal.
+ * @return 1 for true, 0 for false and -1 if the condition is not a bool literal
+ */
+static int literal_condition(const ExpressionNode* condition)
+{
+    auto literal = node_cast<LiteralNode>(condition);
+    if (!literal || !literal->get_value().is_a<bool>()) { return -1; }
+    return literal->get_value().get<bool>() ? 1 : 0;
+}
+
+DeadCodeEliminator::DeadCodeEliminator() : Pass("dce") {}
+
+Node* DeadCodeEliminator::rewrite_block(BlockNode* node)
+{
+    rewrite_children(node);
+
+    Vector<Node*> statements{};
+    bool returned{false};
+    for (Node* statement : node->get_statements())
+    {
+        if (returned || statement->get_kind() == NodeKind::LITERAL)
+        {
+            delete statement;
+            changed++;
+            continue;
+        }
+
+        statements.push_back(statement);
+        returned = statement->get_kind() == NodeKind::RETURN;
+    }
+
+    node->set_statements(statements);
+    return node;
+}
+
+Node* DeadCodeEliminator::rewrite_if(IfNode* node)
+{
+    rewrite_children(node);
+
+    int condition{literal_condition(node->get_condition())};
+    if (condition < 0) { return node; }
+
+    Node* taken{nullptr};
+    if (condition == 1)
+    {
+        taken = node->get_body();
+        node->set_body(nullptr);
+    }
+    else
+    {
+        taken = node->get_else_branch();
+        node->set_else_branch(nullptr);
+    }
+
+    delete node;
+    changed++;
+    return taken;
+}
+
+Node* DeadCodeEliminator::rewrite_while(WhileNode* node)
+{
+    rewrite_children(node);
+
+    if (literal_condition(node->get_condition()) != 0) { return node; }
+
+    delete node;
+    changed++;
+    return nullptr;
+}
+
+} // namespace funk
@@ -0,0 +1,232 @@
+#include "optimizer/Inliner.h"
+
+namespace funk
+{
+
+/**
+ * @brief Shape of an expression, collected by scan().
+ */
+struct Shape
+{
+    size_t nodes{0};        ///< Number of nodes
+    bool supported{true};   ///< False if the expression contains nodes that can't be copied
+    bool calls{false};      ///< True if the expression calls a function
+    bool recursive{false};  ///< True if the expression calls the function it belongs to
+    Vector<String> reads{}; ///< Names of the variables read, in evaluation order
+};
+
+/**
+ * @brief Collects the shape of an expression.
+ * @param expr The expression to scan
+ * @param self Name of the function the expression belongs to
+ * @param shape Receives the shape
+ */
+static void scan(const ExpressionNode* expr, const String& self, Shape& shape)
+{
+    shape.nodes++;
+    switch (expr->get_kind())
+    {
+    case NodeKind::LITERAL: break;
+    case NodeKind::VARIABLE:
+    {
+        auto var = static_cast<const VariableNode*>(expr);
+        if (var->get_value_node()) { shape.supported = false; }
+        else { shape.reads.push_back(var->get_identifier()); }
+        break;
+    }
+    case NodeKind::BINARY_OP:
+    {
+        auto binary = static_cast<const BinaryOpNode*>(expr);
+        scan(binary->get_left(), self, shape);
+        scan(binary->get_right(), self, shape);
+        break;
+    }
+    case NodeKind::UNARY_OP: scan(static_cast<const UnaryOpNode*>(expr)->get_expr(), self, shape); break;
+    case NodeKind::CALL:
+    {
+        auto call = static_cast<const CallNode*>(expr);
+        shape.calls = true;
+        if (call->get_identifier().get_lexeme() == self) { shape.recursive = true; }
+        for (const ExpressionNode* arg : call->get_args()) { scan(arg, self, shape); }
+        break;
+    }
+    default: shape.supported = false; break;
+    }
+}
+
+/**
+ * @brief Gets the expression returned by a function whose body is a single return statement.
+ * @return ExpressionNode* The returned expression, or nullptr if the body is anything else
+ */
+static ExpressionNode* returned_expression(const FunctionNode* function)
+{
+    Vector<Node*> statements{function->get_body()->get_statements()};
+    if (statements.size() != 1 || statements[0]->get_kind() != NodeKind::RETURN) { return nullptr; }
+    return static_cast<ReturnNode*>(statements[0])->get_value();
+}
+
+/**
+ * @brief Counts the functions declared anywhere in a tree by name.
+ */
+class FunctionCounter : public NodeVisitor
+{
+public:
+    HashMap<String, int> counts{};
+
+protected:
+    void visit_function(FunctionNode* node) override
+    {
+        counts[node->get_identifier()]++;
+        visit_children(node);
+    }
+};
+
+Inliner::Inliner() : Pass("inline") {}
+
+void Inliner::prepare(Node* root)
+{
+    candidates.clear();
+
+    auto block = node_cast<BlockNode>(root);
+    if (!block) { return; }
+
+    FunctionCounter counter{};
+    counter.visit(root);
+
+    // Only functions declared before anything else runs are known at every call
+    for (Node* statement : block->get_statements())
+    {
+        auto function = node_cast<FunctionNode>(statement);
+        if (!function) { break; }
+
+        const String& name{function->get_identifier()};
+        if (counter.counts[name] == 1 && BuiltIn::functions.find(name) == BuiltIn::functions.end() &&
+            is_inlinable(function))
+        {
+            candidates[name] = function;
+        }
+    }
+}
+
+bool Inliner::is_inlinable(const FunctionNode* function) const
+{
+    if (function->is_pattern_matching() || function->is_mutable_function() || function->is_generator())
+    {
+        return false;
+    }
+
+    ExpressionNode* value{returned_expression(function)};
+    if (!value) { return false; }
+
+    Shape shape{};
+    scan(value, function->get_identifier(), shape);
+    return shape.supported && !shape.recursive && shape.nodes <= MAX_NODES;
+}
+
+Node* Inliner::rewrite_call(CallNode* node)
+{
+    rewrite_children(node);
+
+    auto it = candidates.find(node->get_identifier().get_lexeme());
+    if (it == candidates.end()) { return node; }
+
+    ExpressionNode* inlined{substitute(it->second, node)};
+    if (!inlined) { return node; }
+
+    delete node;
+    changed++;
+    return inlined;
+}
+
+Node* Inliner::rewrite_pipe(PipeNode* node)
+{
+    node->set_source(rewrite_as(node->get_source()));
+
+    // A call that is the target of a pipe receives the piped value as an extra argument, only its arguments are inlined
+    if (node->get_target()->get_kind() == NodeKind::CALL) { rewrite_children(node->get_target()); }
+    else { node->set_target(rewrite_as(node->get_target())); }
+    return node;
+}
+
+ExpressionNode* Inliner::substitute(const FunctionNode* function, const CallNode* call) const
+{
+    const Vector<Pair<TokenType, String>>& params{function->get_parameters()};
+    const Vector<ExpressionNode*>& args{call->get_args()};
+    if (args.size() != params.size()) { return nullptr; }
+
+    ExpressionNode* value{returned_expression(function)};
+    Shape body{};
+    scan(value, function->get_identifier(), body);
+
+    // Arguments that are not literals must be evaluated as often and in the same order as before
+    size_t last{0};
+    for (const String& read : body.reads)
+    {
+        for (size_t i{0}; i < params.size(); i++)
+        {
+            if (params[i].second != read || args[i]->get_kind() == NodeKind::LITERAL) { continue; }
+            if (args[i]->get_kind() == NodeKind::VARIABLE) { break; }
+            if (i < last) { return nullptr; }
+            last = i + 1;
+            break;
+        }
+    }
+
+    for (size_t i{0}; i < params.size(); i++)
+    {
+        if (args[i]->get_kind() == NodeKind::LITERAL) { continue; }
+
+        size_t uses{static_cast<size_t>(std::count(body.reads.begin(), body.reads.end(), params[i].second))};
+        Shape arg{};
+        scan(args[i], "", arg);
+        if (!arg.supported || uses == 0) { return nullptr; }
+        if (args[i]->get_kind() == NodeKind::VARIABLE) { continue; }
+        if (uses != 1 || body.calls) { return nullptr; }
+    }
+
+    return copy(value, params, args);
+}
+
+ExpressionNode* Inliner::copy(const ExpressionNode* expr, const Vector<Pair<TokenType, String>>& params,
+    const Vector<ExpressionNode*>& args) const
+{
+    switch (expr->get_kind())
+    {
+    case NodeKind::LITERAL:
+    {
+        auto literal = static_cast<const LiteralNode*>(expr);
+        return new LiteralNode(literal->get_location(), literal->get_value());
+    }
+    case NodeKind::VARIABLE:
+    {
+        auto var = static_cast<const VariableNode*>(expr);
+        for (size_t i{0}; i < params.size(); i++)
+        {
+            // Arguments belong to the caller and are copied without substitution
+            if (params[i].second == var->get_identifier()) { return copy(args[i], {}, {}); }
+        }
+        return new VariableNode(var->get_location(), var->get_identifier());
+    }
+    case NodeKind::BINARY_OP:
+    {
+        auto binary = static_cast<const BinaryOpNode*>(expr);
+        return new BinaryOpNode(
+            copy(binary->get_left(), params, args), binary->get_op(), copy(binary->get_right(), params, args));
+    }
+    case NodeKind::UNARY_OP:
+    {
+        auto unary = static_cast<const UnaryOpNode*>(expr);
+        return new UnaryOpNode(unary->get_op(), copy(unary->get_expr(), params, args));
+    }
+    case NodeKind::CALL:
+    {
+        auto call = static_cast<const CallNode*>(expr);
+        Vector<ExpressionNode*> call_args{};
+        for (const ExpressionNode* arg : call->get_args()) { call_args.push_back(copy(arg, params, args)); }
+        return new CallNode(call->get_identifier(), call_args);
+    }
+    default: throw RuntimeError(expr->get_location(), "Can't inline " + node_kind_to_s(expr->get_kind()));
+    }
+}
+
+} // namespace funk
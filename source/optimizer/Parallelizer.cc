@@ -0,0 +1,193 @@
+#include "optimizer/Parallelizer.h"
+
+namespace funk
+{
+
+/**
+ * @brief Checks if the nodes of a function body or an expression have no effects besides their value.
+ * Calls are collected instead of checked, since the purity of the called functions is only known at the end.
+ */
+class EffectScanner : public NodeVisitor
+{
+public:
+    bool pure{true};            ///< False once a node with effects or a read of an unknown variable is found
+    bool loops{false};          ///< True if a loop was found
+    bool any_reads{false};      ///< True if any variable may be read, for expressions of the calling code
+    Vector<String> calls{};     ///< Names of the called functions
+    HashMap<String, int> own{}; ///< Names of the parameters and declarations that may be read and assigned
+
+protected:
+    void visit_while(WhileNode* node) override
+    {
+        loops = true;
+        visit_children(node);
+    }
+
+    void visit_declaration(DeclarationNode* node) override
+    {
+        own[node->get_identifier()]++;
+        visit_children(node);
+    }
+
+    void visit_assignment(AssignmentNode* node) override
+    {
+        auto var = node_cast<VariableNode>(node->get_left());
+        if (!var || !own.count(var->get_identifier())) { pure = false; }
+        visit(node->get_right());
+    }
+
+    void visit_variable(VariableNode* node) override
+    {
+        if (!any_reads && !own.count(node->get_identifier())) { pure = false; }
+        visit_children(node);
+    }
+
+    void visit_call(CallNode* node) override
+    {
+        calls.push_back(node->get_identifier().get_lexeme());
+        visit_children(node);
+    }
+
+    // Nodes that declare functions, run other tasks, call methods or stream or yield values
+    void visit_function(FunctionNode*) override { pure = false; }
+    void visit_method_call(MethodCallNode*) override { pure = false; }
+    void visit_pipe(PipeNode*) override { pure = false; }
+    void visit_stream(StreamNode*) override { pure = false; }
+    void visit_spawn(SpawnNode*) override { pure = false; }
+    void visit_await(AwaitNode*) override { pure = false; }
+    void visit_yield(YieldNode*) override { pure = false; }
+};
+
+/**
+ * @brief Counts the overloads declared anywhere in a tree by name.
+ */
+class OverloadCounter : public NodeVisitor
+{
+public:
+    HashMap<String, int> counts{};
+
+protected:
+    void visit_function(FunctionNode* node) override
+    {
+        counts[node->get_identifier()]++;
+        visit_children(node);
+    }
+};
+
+Parallelizer::Parallelizer() : Pass("parallel") {}
+
+void Parallelizer::prepare(Node* root)
+{
+    pure.clear();
+
+    auto block = node_cast<BlockNode>(root);
+    if (!block) { return; }
+
+    OverloadCounter counter{};
+    counter.visit(root);
+
+    // Scan the functions declared before anything else runs, grouped by name
+    HashMap<String, Vector<FunctionNode*>> functions{};
+    for (Node* statement : block->get_statements())
+    {
+        auto function = node_cast<FunctionNode>(statement);
+        if (!function) { break; }
+        functions[function->get_identifier()].push_back(function);
+    }
+
+    HashMap<String, EffectScanner> scans{};
+    for (const auto& [name, overloads] : functions)
+    {
+        EffectScanner& scan{scans[name]};
+        scan.pure = BuiltIn::functions.find(name) == BuiltIn::functions.end() &&
+                    counter.counts[name] == static_cast<int>(overloads.size());
+
+        for (FunctionNode* function : overloads)
+        {
+            // Every overload starts with only its own parameters, names of other overloads are variables of the caller
+            EffectScanner overload{};
+            if (function->is_mutable_function()) { overload.pure = false; }
+            for (ExpressionNode* value : function->get_pattern_values()) { overload.visit(value); }
+            for (const Pair<TokenType, String>& param : function->get_parameters()) { overload.own[param.second]++; }
+            overload.visit(function->get_body());
+
+            scan.pure = scan.pure && overload.pure;
+            scan.loops = scan.loops || overload.loops;
+            scan.calls.insert(scan.calls.end(), overload.calls.begin(), overload.calls.end());
+        }
+    }
+
+    // A function stays pure while all functions it calls are pure, drop impure ones until nothing changes
+    HashMap<String, bool> candidates{};
+    for (const auto& [name, scan] : scans)
+    {
+        if (scan.pure) { candidates[name] = scan.loops; }
+    }
+
+    bool dropped{true};
+    while (dropped)
+    {
+        dropped = false;
+        for (auto it = candidates.begin(); it != candidates.end();)
+        {
+            const Vector<String>& calls{scans[it->first].calls};
+            bool calls_impure{std::any_of(
+                calls.begin(), calls.end(), [&](const String& name) { return !candidates.count(name); })};
+            if (calls_impure)
+            {
+                it = candidates.erase(it);
+                dropped = true;
+            }
+            else { ++it; }
+        }
+    }
+
+    // Calls are worth forking if the function loops or can reach itself through the functions it calls
+    for (auto& [name, heavy] : candidates)
+    {
+        Vector<String> pending{scans[name].calls};
+        HashMap<String, bool> seen{};
+        while (!heavy && !pending.empty())
+        {
+            String callee{pending.back()};
+            pending.pop_back();
+            if (seen[callee]) { continue; }
+            seen[callee] = true;
+
+            heavy = callee == name || scans[callee].loops;
+            pending.insert(pending.end(), scans[callee].calls.begin(), scans[callee].calls.end());
+        }
+    }
+
+    pure = candidates;
+}
+
+bool Parallelizer::is_forkable(const ExpressionNode* expr) const
+{
+    // Method calls are call nodes too, but may change their object
+    if (!expr || expr->get_kind() != NodeKind::CALL) { return false; }
+    auto call = static_cast<const CallNode*>(expr);
+
+    auto it = pure.find(call->get_identifier().get_lexeme());
+    if (it == pure.end() || !it->second) { return false; }
+
+    EffectScanner scan{};
+    scan.any_reads = true;
+    for (ExpressionNode* arg : call->get_args()) { scan.visit(arg); }
+    return scan.pure && std::all_of(scan.calls.begin(), scan.calls.end(),
+                            [this](const String& name) { return pure.count(name) != 0; });
+}
+
+Node* Parallelizer::rewrite_binary_op(BinaryOpNode* node)
+{
+    rewrite_children(node);
+
+    if (is_forkable(node->get_left()) && is_forkable(node->get_right()) && !node->is_parallel())
+    {
+        node->set_parallel(true);
+        changed++;
+    }
+    return node;
+}
+
+} // namespace funk
@@ -0,0 +1,25 @@
+#include "optimizer/Pass.h"
+
+namespace funk
+{
+
+Pass::Pass(const String& name) : name(name) {}
+
+Node* Pass::run(Node* root)
+{
+    changed = 0;
+    prepare(root);
+    return rewrite(root);
+}
+
+const String& Pass::get_name() const
+{
+    return name;
+}
+
+size_t Pass::get_changed() const
+{
+    return changed;
+}
+
+} // namespace funk
@@ -0,0 +1,101 @@
+#include "optimizer/PassManager.h"
+#include "logging/LogMacros.h"
+#include "optimizer/ConstantFolder.h"
+#include "optimizer/DeadCodeEliminator.h"
+#include "optimizer/Inliner.h"
+#include "optimizer/Parallelizer.h"
+
+#include <chrono>
+
+namespace funk
+{
+
+PassManager::PassManager(int level, bool parallel)
+{
+    if (level >= 1)
+    {
+        add(new ConstantFolder());
+        add(new DeadCodeEliminator());
+    }
+
+    if (level >= 2)
+    {
+        // Inlined arguments often turn into constant expressions
+        add(new Inliner());
+        add(new ConstantFolder());
+    }
+
+    // Runs after inlining, which removes calls too small to fork
+    if (parallel) { add(new Parallelizer()); }
+}
+
+PassManager::~PassManager()
+{
+    for (Pass* pass : passes) { delete pass; }
+}
+
+void PassManager::add(Pass* pass)
+{
+    passes.push_back(pass);
+}
+
+bool PassManager::has_pass(const String& name) const
+{
+    for (const Pass* pass : passes)
+    {
+        if (pass->get_name() == name) { return true; }
+    }
+    return false;
+}
+
+Vector<String> PassManager::get_pass_names() const
+{
+    Vector<String> names{};
+    for (const Pass* pass : passes) { names.push_back(pass->get_name()); }
+    return names;
+}
+
+void PassManager::dump_after(const String& name)
+{
+    dump = name;
+}
+
+Node* PassManager::run(Node* root)
+{
+    results.clear();
+
+    for (Pass* pass : passes)
+    {
+        auto start = std::chrono::steady_clock::now();
+        root = pass->run(root);
+        std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+
+        results.push_back({pass->get_name(), elapsed.count(), pass->get_changed()});
+        LOG_INFO("Pass " + pass->get_name() + " changed " + to_str(pass->get_changed()) + " nodes in " +
+                 to_str(elapsed.count()) + " ms");
+
+        if (pass->get_name() == dump)
+        {
+            LOG_INFO("Abstract Syntax Tree after " + dump + ":");
+            std::istringstream stream(root->to_s());
+            String line;
+            while (getline(stream, line)) { LOG_INFO(line); }
+        }
+    }
+
+    return root;
+}
+
+String PassManager::report() const
+{
+    std::ostringstream out;
+    out << "Optimization passes:\n";
+    for (const PassResult& result : results)
+    {
+        out << "  " << std::left << std::setw(22) << result.name << std::right << std::setw(6) << result.changed
+            << " changed  " << std::fixed << std::setprecision(3) << result.milliseconds << " ms\n";
+    }
+    return out.str();
+}
+
+} // namespace funk
@@ -1,17 +1,22 @@
 #include "parser/BuiltIn.h"
+#include "parser/Registry.h"
 
 namespace funk
 {
 
 Node* BuiltIn::print(const CallNode& call, const Vector<ExpressionNode*>& args)
 {
+    // The line is written at once, so lines printed by concurrent tasks are never mixed
+    String line{};
     for (ExpressionNode* arg : args)
     {
-        ExpressionNode* result{dynamic_cast<ExpressionNode*>(arg->evaluate())};
+        ExpressionNode* result{node_cast<ExpressionNode>(arg->evaluate())};
         if (!result) { throw RuntimeError(arg->get_location(), "Print argument did not evaluate to an expression"); }
-        cout << result->get_value().cast<String>() << " ";
+        line += result->get_value().cast<String>();
+        line += ' ';
     }
-    cout << endl;
+    line += '\n';
+    Writer::out().write(line);
     return new LiteralNode(call.get_location(), None{});
 }
 
@@ -19,19 +24,161 @@ Node* BuiltIn::read(const CallNode& call, const Vector<ExpressionNode*>& args)
 {
     if (!args.empty()) { print(call, args); }
     String input;
-    getline(cin, input);
+    Reader::in().read_line(input);
     return new LiteralNode(call.get_location(), input);
 }
 
+Node* BuiltIn::read_all(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (!args.empty()) { throw RuntimeError(call.get_location(), "read_all() takes no arguments"); }
+    return new LiteralNode(call.get_location(), Reader::in().read_all());
+}
+
+Node* BuiltIn::read_lines(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (!args.empty()) { throw RuntimeError(call.get_location(), "read_lines() takes no arguments"); }
+
+    Vector<ExpressionNode*> lines{};
+    String line;
+    while (Reader::in().read_line(line)) { lines.push_back(new LiteralNode(call.get_location(), line)); }
+    return new ListNode(call.get_location(), TokenType::TEXT, lines);
+}
+
+Node* BuiltIn::stdin_lines(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (!args.empty()) { throw RuntimeError(call.get_location(), "stdin_lines() takes no arguments"); }
+
+    return new StreamNode(call.get_location(), "stdin_lines", [](NodeValue& value)
+    {
+        String line;
+        if (!Reader::in().read_line(line)) { return false; }
+        value = NodeValue(line);
+        return true;
+    });
+}
+
 Node* BuiltIn::fast_exit(const CallNode& call [[maybe_unused]], const Vector<ExpressionNode*>& args)
 {
     int status{0};
-    if (!args.empty()) { status = dynamic_cast<LiteralNode*>(args[0]->evaluate())->get_value().cast<int>(); }
+    if (!args.empty())
+    {
+        status = static_cast<int>(node_cast<LiteralNode>(args[0]->evaluate())->get_value().cast<Numb>());
+    }
 
+    Writer::out().flush();
+    // Other programs in the process keep running, only this one ends
+    if (Registry::is_isolated()) { throw ProgramExit(status); }
     exit(status);
 }
 
-HashMap<String, Node* (*)(const CallNode&, const Vector<ExpressionNode*>&)> BuiltIn::functions{
-    {"print", print}, {"read", read}, {"exit", fast_exit}};
+Node* BuiltIn::flush(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (!args.empty()) { throw RuntimeError(call.get_location(), "flush() takes no arguments"); }
+    Writer::out().flush();
+    return new LiteralNode(call.get_location(), None{});
+}
+
+Node* BuiltIn::write_file(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    return to_file(call, args, false);
+}
+
+Node* BuiltIn::append_file(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    return to_file(call, args, true);
+}
+
+Node* BuiltIn::to_file(const CallNode& call, const Vector<ExpressionNode*>& args, bool append)
+{
+    const String name{call.get_identifier().get_lexeme()};
+    if (args.empty()) { throw RuntimeError(call.get_location(), name + "() expects a file path"); }
+
+    String path{args[0]->get_value().cast<String>()};
+    try
+    {
+        Writer file{path, append, Writer::out().get_capacity()};
+        for (size_t i{1}; i < args.size(); i++) { file.write(args[i]->get_value().cast<String>()); }
+        file.flush();
+    }
+    catch (const FileError& e)
+    {
+        throw RuntimeError(call.get_location(), e.what());
+    }
+
+    return new LiteralNode(call.get_location(), None{});
+}
+
+Node* BuiltIn::channel(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (args.size() > 1) { throw RuntimeError(call.get_location(), "channel() takes at most one argument"); }
+
+    Numb capacity{Channel::DEFAULT_CAPACITY};
+    if (!args.empty())
+    {
+        NodeValue value{args[0]->get_value()};
+        if (!value.is_a<Numb>() || value.as_numb() < 1)
+        {
+            throw RuntimeError(call.get_location(), "channel() expects a capacity of at least 1");
+        }
+        capacity = value.as_numb();
+    }
+
+    NodeValue result{ObjectRef{std::make_shared<Channel>(static_cast<size_t>(capacity))}};
+    return new LiteralNode(call.get_location(), result);
+}
+
+Node* BuiltIn::send(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (args.size() != 2) { throw RuntimeError(call.get_location(), "send() expects a channel and a value"); }
+
+    std::shared_ptr<Channel> target{to_channel(call, args[0])};
+    try
+    {
+        target->send(args[1]->get_value());
+    }
+    catch (const TypeError& e)
+    {
+        throw TypeError(call.get_location(), e.what());
+    }
+    catch (const RuntimeError& e)
+    {
+        throw RuntimeError(call.get_location(), e.what());
+    }
+    return new LiteralNode(call.get_location(), None{});
+}
+
+Node* BuiltIn::recv(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (args.size() != 1) { throw RuntimeError(call.get_location(), "recv() expects a channel"); }
+
+    // A closed and empty channel gives none
+    NodeValue value{};
+    to_channel(call, args[0])->recv(value);
+    return new LiteralNode(call.get_location(), value);
+}
+
+Node* BuiltIn::close(const CallNode& call, const Vector<ExpressionNode*>& args)
+{
+    if (args.size() != 1) { throw RuntimeError(call.get_location(), "close() expects a channel"); }
+    to_channel(call, args[0])->close();
+    return new LiteralNode(call.get_location(), None{});
+}
+
+std::shared_ptr<Channel> BuiltIn::to_channel(const CallNode& call, ExpressionNode* arg)
+{
+    NodeValue value{arg->get_value()};
+    std::shared_ptr<Channel> result{Channel::from(value)};
+    if (!result)
+    {
+        throw TypeError(call.get_location(), call.get_identifier().get_lexeme() + "() expects a channel, got " +
+                                                 token_type_to_s(value.get_token_type()));
+    }
+    return result;
+}
+
+HashMap<String, Node* (*)(const CallNode&, const Vector<ExpressionNode*>&)> BuiltIn::functions{{"print", print},
+    {"read", read}, {"read_all", read_all}, {"read_lines", read_lines}, {"stdin_lines", stdin_lines},
+    {"exit", fast_exit}, {"flush", flush}, {"write_file", write_file}, {"append_file", append_file},
+    {"channel", channel}, {"send", send}, {"recv", recv}, {"close", close}};
 
 } // namespace funk
@@ -13,17 +13,7 @@ Node* Parser::parse(const Vector<String>& args)
     BlockNode* block = new BlockNode(SourceLocation(filename, 0, 0));
 
     LOG_DEBUG("Parsing arguments");
-    if (!args.empty())
-    {
-        // Create a Vector of ExpressionNodes for the arguments
-        Vector<ExpressionNode*> list{};
-        // Populate the Vector with LiteralNodes
-        for (const String& arg : args) { list.push_back(new LiteralNode(SourceLocation(filename, 0, 0), arg)); }
-        // Create a ListNode for the arguments
-        ExpressionNode* args_list{new ListNode(SourceLocation(filename, 0, 0), TokenType::TEXT, list)};
-        // Create a DeclarationNode for the arguments
-        block->add(new DeclarationNode(SourceLocation(filename, 0, 0), true, TokenType::TEXT, "ARGS", args_list));
-    }
+    if (!args.empty()) { block->add(declare_args(args, filename)); }
 
     // Parse the rest of the program
     while (!done()) { block->add(parse_statement()); }
@@ -42,6 +32,18 @@ Parser Parser::load(String filename)
     return Parser(lexer.tokenize(), filename);
 }
 
+Node* Parser::declare_args(const Vector<String>& args, const String& filename)
+{
+    // Create a Vector of ExpressionNodes for the arguments
+    Vector<ExpressionNode*> list{};
+    // Populate the Vector with LiteralNodes
+    for (const String& arg : args) { list.push_back(new LiteralNode(SourceLocation(filename, 0, 0), arg)); }
+    // Create a ListNode for the arguments
+    ExpressionNode* args_list{new ListNode(SourceLocation(filename, 0, 0), TokenType::TEXT, list)};
+    // Create a DeclarationNode for the arguments
+    return new DeclarationNode(SourceLocation(filename, 0, 0), true, TokenType::TEXT, "ARGS", args_list);
+}
+
 Token Parser::next()
 {
     if (!done()) index++;
@@ -127,7 +129,8 @@ Node* Parser::parse_declaration()
     if (match(TokenType::MUT)) { is_mutable = true; }
 
     if (check(TokenType::NUMB_TYPE) || check(TokenType::REAL_TYPE) || check(TokenType::BOOL_TYPE) ||
-        check(TokenType::CHAR_TYPE) || check(TokenType::TEXT_TYPE))
+        check(TokenType::CHAR_TYPE) || check(TokenType::TEXT_TYPE) || check(TokenType::TASK_TYPE) ||
+        check(TokenType::CHANNEL_TYPE) || check(TokenType::GENERATOR_TYPE) || check(TokenType::MAP_TYPE))
     {
         return parse_variable_declaration(is_mutable);
     }
@@ -154,7 +157,7 @@ Node* Parser::parse_variable_declaration(bool is_mutable)
     Node* expr{parse_statement()};
     if (!expr) { throw SyntaxError(peek_prev().get_location(), "Expected expression after '='"); }
 
-    ExpressionNode* expr_node{dynamic_cast<ExpressionNode*>(expr)};
+    ExpressionNode* expr_node{node_cast<ExpressionNode>(expr)};
     return new DeclarationNode(type.get_location(), is_mutable, type.get_type(), identifier.get_lexeme(), expr_node);
 }
 
@@ -179,16 +182,19 @@ Node* Parser::parse_function_declaration(bool is_mutable)
 
         // Collect pattern arguments
         do {
-            pattern.push_back(dynamic_cast<LiteralNode*>(parse_literal()));
+            pattern.push_back(node_cast<LiteralNode>(parse_literal()));
         } while (match(TokenType::COMMA));
 
         if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')' after pattern"); }
 
         // Parse function body
-        BlockNode* body{dynamic_cast<BlockNode*>(parse_block())};
-        if (!body) { throw SyntaxError(peek().get_location(), "Expected function body"); }
+        bool generator{false};
+        BlockNode* body{parse_function_body(generator)};
 
-        return new FunctionNode(identifier.get_location(), is_mutable, identifier.get_lexeme(), pattern, body);
+        auto function =
+            new FunctionNode(identifier.get_location(), is_mutable, identifier.get_lexeme(), pattern, body);
+        function->set_generator(generator);
+        return function;
     }
     else
     {
@@ -207,6 +213,10 @@ Node* Parser::parse_function_declaration(bool is_mutable)
                 case TokenType::BOOL_TYPE: type = TokenType::BOOL_TYPE; break;
                 case TokenType::CHAR_TYPE: type = TokenType::CHAR_TYPE; break;
                 case TokenType::TEXT_TYPE: type = TokenType::TEXT_TYPE; break;
+                case TokenType::TASK_TYPE: type = TokenType::TASK_TYPE; break;
+                case TokenType::CHANNEL_TYPE: type = TokenType::CHANNEL_TYPE; break;
+                case TokenType::GENERATOR_TYPE: type = TokenType::GENERATOR_TYPE; break;
+                case TokenType::MAP_TYPE: type = TokenType::MAP_TYPE; break;
                 default: throw SyntaxError(peek().get_location(), "Expected parameter type");
                 }
 
@@ -227,11 +237,40 @@ Node* Parser::parse_function_declaration(bool is_mutable)
         if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')' after parameters"); }
 
         // Parse function body
-        BlockNode* body{dynamic_cast<BlockNode*>(parse_block())};
-        if (!body) { throw SyntaxError(peek().get_location(), "Expected function body"); }
+        bool generator{false};
+        BlockNode* body{parse_function_body(generator)};
+
+        auto function =
+            new FunctionNode(identifier.get_location(), is_mutable, identifier.get_lexeme(), parameters, body);
+        function->set_generator(generator);
+        return function;
+    }
+}
+
+BlockNode* Parser::parse_function_body(bool& generator)
+{
+    // Yield statements belong to the innermost function, save the state of the enclosing one
+    bool outer_yields{yields};
+    yields = false;
+    functions++;
 
-        return new FunctionNode(identifier.get_location(), is_mutable, identifier.get_lexeme(), parameters, body);
+    BlockNode* body{nullptr};
+    try
+    {
+        body = node_cast<BlockNode>(parse_block());
+    }
+    catch (...)
+    {
+        functions--;
+        yields = outer_yields;
+        throw;
     }
+
+    functions--;
+    generator = yields;
+    yields = outer_yields;
+    if (!body) { throw SyntaxError(peek().get_location(), "Expected function body"); }
+    return body;
 }
 
 Node* Parser::parse_block()
@@ -256,6 +295,7 @@ Node* Parser::parse_control()
     if (match(TokenType::IF)) { return parse_if(); }
     if (match(TokenType::WHILE)) { return parse_while(); }
     if (match(TokenType::RETURN)) { return parse_return(); }
+    if (match(TokenType::YIELD)) { return parse_yield(); }
     return nullptr;
 }
 
@@ -265,10 +305,10 @@ Node* Parser::parse_if()
 
     if (!match(TokenType::L_PAR)) { throw SyntaxError(peek().get_location(), "Expected '('"); }
 
-    ExpressionNode* condition{dynamic_cast<ExpressionNode*>(parse_expression())};
+    ExpressionNode* condition{node_cast<ExpressionNode>(parse_expression())};
     if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')'"); }
 
-    BlockNode* body{dynamic_cast<BlockNode*>(parse_block())};
+    BlockNode* body{node_cast<BlockNode>(parse_block())};
     Node* else_branch{nullptr};
     if (match(TokenType::ELSE))
     {
@@ -283,9 +323,9 @@ Node* Parser::parse_while()
     LOG_DEBUG("Parse while loop");
 
     if (!match(TokenType::L_PAR)) { throw SyntaxError(peek().get_location(), "Expected '('"); }
-    ExpressionNode* condition{dynamic_cast<ExpressionNode*>(parse_expression())};
+    ExpressionNode* condition{node_cast<ExpressionNode>(parse_expression())};
     if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')'"); }
-    BlockNode* body{dynamic_cast<BlockNode*>(parse_block())};
+    BlockNode* body{node_cast<BlockNode>(parse_block())};
     return new WhileNode(condition, body);
 }
 
@@ -294,12 +334,27 @@ Node* Parser::parse_return()
     LOG_DEBUG("Parse return");
 
     if (match(TokenType::SEMICOLON)) { return new ReturnNode(peek_prev().get_location(), nullptr); }
-    ExpressionNode* value{dynamic_cast<ExpressionNode*>(parse_expression())};
+    ExpressionNode* value{node_cast<ExpressionNode>(parse_expression())};
     if (!value) { throw SyntaxError(peek().get_location(), "Expected expression"); }
     if (!match(TokenType::SEMICOLON)) { throw SyntaxError(peek().get_location(), "Expected ';'"); }
     return new ReturnNode(peek_prev().get_location(), value);
 }
 
+Node* Parser::parse_yield()
+{
+    LOG_DEBUG("Parse yield");
+
+    SourceLocation location{peek_prev().get_location()};
+    if (functions == 0) { throw SyntaxError(location, "Expected 'yield' inside a function"); }
+
+    ExpressionNode* value{node_cast<ExpressionNode>(parse_expression())};
+    if (!value) { throw SyntaxError(peek().get_location(), "Expected expression"); }
+    if (!match(TokenType::SEMICOLON)) { throw SyntaxError(peek().get_location(), "Expected ';'"); }
+
+    yields = true;
+    return new YieldNode(location, value);
+}
+
 Node* Parser::parse_expression()
 {
     LOG_DEBUG("Parse expression");
@@ -312,12 +367,14 @@ Node* Parser::parse_assignment()
     LOG_DEBUG("Parse assignment");
 
     Node* expr{parse_pipe()};
-    if (auto var = dynamic_cast<VariableNode*>(expr))
+    if (auto var = node_cast<VariableNode>(expr))
     {
-        if (match(TokenType::ASSIGN))
+        if (match(TokenType::ASSIGN) || match(TokenType::PLUS_ASSIGN) || match(TokenType::MINUS_ASSIGN) ||
+            match(TokenType::MULTIPLY_ASSIGN) || match(TokenType::DIVIDE_ASSIGN) || match(TokenType::MODULO_ASSIGN) ||
+            match(TokenType::POWER_ASSIGN))
         {
             Token op{peek_prev()};
-            ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_pipe())};
+            ExpressionNode* right{node_cast<ExpressionNode>(parse_pipe())};
             if (!expr) { throw SyntaxError(peek().get_location(), "Expected expression before '='"); }
             if (!right) { throw SyntaxError(peek().get_location(), "Expected expression after '='"); }
             return new AssignmentNode(var, op, right);
@@ -335,7 +392,7 @@ Node* Parser::parse_pipe()
     while (check(TokenType::PIPE))
     {
         SourceLocation loc{next().get_location()};
-        ExpressionNode* source{dynamic_cast<ExpressionNode*>(expr)};
+        ExpressionNode* source{node_cast<ExpressionNode>(expr)};
         if (!source) { throw SyntaxError(peek().get_location(), "Left side of pipe must be an expression"); }
 
         if (!check(TokenType::IDENTIFIER))
@@ -351,7 +408,7 @@ Node* Parser::parse_pipe()
             if (!check(TokenType::R_PAR))
             {
                 do {
-                    args.push_back(dynamic_cast<ExpressionNode*>(parse_expression()));
+                    args.push_back(node_cast<ExpressionNode>(parse_expression()));
                 } while (match(TokenType::COMMA));
             }
 
@@ -368,12 +425,12 @@ Node* Parser::parse_logical_or()
 {
     LOG_DEBUG("Parse logical or");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_logical_and())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_logical_and())};
 
     while (match(TokenType::OR))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_logical_and())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_logical_and())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -384,12 +441,12 @@ Node* Parser::parse_logical_and()
 {
     LOG_DEBUG("Parse logical and");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_equality())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_equality())};
 
     while (match(TokenType::AND))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_equality())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_equality())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -400,12 +457,12 @@ Node* Parser::parse_equality()
 {
     LOG_DEBUG("Parse equality");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_comparison())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_comparison())};
 
     while (match(TokenType::EQUAL) || match(TokenType::NOT_EQUAL))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_comparison())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_comparison())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -416,13 +473,13 @@ Node* Parser::parse_comparison()
 {
     LOG_DEBUG("Parse comparison");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_additive())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_additive())};
 
     while (match(TokenType::LESS) || match(TokenType::LESS_EQUAL) || match(TokenType::GREATER) ||
            match(TokenType::GREATER_EQUAL))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_additive())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_additive())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -433,12 +490,12 @@ Node* Parser::parse_additive()
 {
     LOG_DEBUG("Parse addative");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_multiplicative())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_multiplicative())};
 
     while (match(TokenType::PLUS) || match(TokenType::MINUS))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_multiplicative())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_multiplicative())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -449,13 +506,13 @@ Node* Parser::parse_multiplicative()
 {
     LOG_DEBUG("Parse multiplicative");
 
-    ExpressionNode* left{dynamic_cast<ExpressionNode*>(parse_unary())};
+    ExpressionNode* left{node_cast<ExpressionNode>(parse_unary())};
 
     while (
         match(TokenType::MULTIPLY) || match(TokenType::DIVIDE) || match(TokenType::MODULO) || match(TokenType::POWER))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_unary())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_unary())};
         left = new BinaryOpNode(left, op, right);
     }
 
@@ -469,10 +526,27 @@ Node* Parser::parse_unary()
     if (match(TokenType::MINUS) || match(TokenType::NOT))
     {
         Token op{peek_prev()};
-        ExpressionNode* right{dynamic_cast<ExpressionNode*>(parse_factor())};
+        ExpressionNode* right{node_cast<ExpressionNode>(parse_factor())};
         return new UnaryOpNode(op, right);
     }
 
+    if (match(TokenType::SPAWN))
+    {
+        // The whole expression that follows runs in the task, including binary operators and pipes
+        SourceLocation loc{peek_prev().get_location()};
+        ExpressionNode* expr{node_cast<ExpressionNode>(parse_pipe())};
+        if (!expr) { throw SyntaxError(peek().get_location(), "Expected expression after 'spawn'"); }
+        return new SpawnNode(loc, expr);
+    }
+
+    if (match(TokenType::AWAIT))
+    {
+        SourceLocation loc{peek_prev().get_location()};
+        ExpressionNode* expr{node_cast<ExpressionNode>(parse_unary())};
+        if (!expr) { throw SyntaxError(peek().get_location(), "Expected expression after 'await'"); }
+        return new AwaitNode(loc, expr);
+    }
+
     return parse_factor();
 }
 
@@ -494,9 +568,10 @@ Node* Parser::parse_factor()
         if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')'"); }
     }
     else if (check(TokenType::L_BRACKET)) { expr = parse_list(); }
+    else if (check(TokenType::L_BRACE)) { expr = parse_map(); }
     else { throw SyntaxError(peek().get_location(), "Expected expression, got " + token_type_to_s(peek().get_type())); }
 
-    while (match(TokenType::DOT)) { expr = parse_method_call(dynamic_cast<ExpressionNode*>(expr)); }
+    while (match(TokenType::DOT)) { expr = parse_method_call(node_cast<ExpressionNode>(expr)); }
 
     return expr;
 }
@@ -506,7 +581,8 @@ Node* Parser::parse_literal()
     LOG_DEBUG("Parse literal");
 
     Token literal{next()};
-    return new LiteralNode(literal.get_location(), NodeValue(literal.get_value()));
+    NodeValue value{std::visit([](const auto& v) { return NodeValue(v); }, literal.get_value())};
+    return new LiteralNode(literal.get_location(), value);
 }
 
 Node* Parser::parse_identifier()
@@ -535,7 +611,7 @@ Node* Parser::parse_call(const Token& identifier)
     if (!check(TokenType::R_PAR))
     {
         do {
-            arguments.push_back(dynamic_cast<ExpressionNode*>(parse_expression()));
+            arguments.push_back(node_cast<ExpressionNode>(parse_expression()));
         } while (match(TokenType::COMMA));
     }
     if (!match(TokenType::R_PAR)) { throw SyntaxError(peek().get_location(), "Expected ')'"); }
@@ -556,7 +632,7 @@ Node* Parser::parse_method_call(ExpressionNode* object)
     if (!check(TokenType::R_PAR))
     {
         do {
-            arguments.push_back(dynamic_cast<ExpressionNode*>(parse_expression()));
+            arguments.push_back(node_cast<ExpressionNode>(parse_expression()));
         } while (match(TokenType::COMMA));
     }
 
@@ -579,7 +655,7 @@ Node* Parser::parse_list()
         do {
             if (type == TokenType::NONE) { type = peek().get_type(); }
             else if (type != peek().get_type()) { throw SyntaxError(peek().get_location(), "Inconsistent list types"); }
-            elements.push_back(dynamic_cast<ExpressionNode*>(parse_expression()));
+            elements.push_back(node_cast<ExpressionNode>(parse_expression()));
         } while (match(TokenType::COMMA));
     }
 
@@ -587,4 +663,25 @@ Node* Parser::parse_list()
     return new ListNode(peek_prev().get_location(), type, elements);
 }
 
+Node* Parser::parse_map()
+{
+    LOG_DEBUG("Parse map");
+
+    SourceLocation loc{peek().get_location()};
+    if (!match(TokenType::L_BRACE)) { throw SyntaxError(peek().get_location(), "Expected '{'"); }
+
+    Vector<MapNode::Entry> entries{};
+    if (!check(TokenType::R_BRACE))
+    {
+        do {
+            ExpressionNode* key{node_cast<ExpressionNode>(parse_expression())};
+            if (!match(TokenType::COLON)) { throw SyntaxError(peek().get_location(), "Expected ':' after map key"); }
+            entries.emplace_back(key, node_cast<ExpressionNode>(parse_expression()));
+        } while (match(TokenType::COMMA));
+    }
+
+    if (!match(TokenType::R_BRACE)) { throw SyntaxError(peek().get_location(), "Expected '}'"); }
+    return new MapNode(loc, entries);
+}
+
 } // namespace funk
@@ -3,33 +3,52 @@
 namespace funk
 {
 
+thread_local Registry* Registry::current{nullptr};
+
 Registry& Registry::instance()
 {
-    static Registry registry;
-    return registry;
+    static Registry global;
+    return current ? *current : global;
+}
+
+Registry* Registry::enter(Registry* registry)
+{
+    Registry* previous{current};
+    current = registry;
+    return previous;
 }
 
 bool Registry::add_function(FunctionNode* function)
 {
     // TODO: Check for duplicate functions for the same identifier and arguments
-    functions[function->get_identifier()].push_back(function);
+    std::unique_lock<std::shared_mutex> guard{lock};
+    Overloads& overloads{functions[function->get_identifier()]};
+    auto updated = overloads ? std::make_shared<Vector<FunctionNode*>>(*overloads)
+                             : std::make_shared<Vector<FunctionNode*>>();
+    updated->push_back(function);
+    overloads = updated;
     return true;
 }
 
 FunctionNode* Registry::get_function(const String& identifier, const Vector<ExpressionNode*>& arguments) const
 {
+    Stats::instance().function_lookup();
+
     // Check if the function exists
-    if (functions.find(identifier) == functions.end()) { return nullptr; }
+    Overloads overloads{get_overloads(identifier)};
+    if (!overloads) { return nullptr; }
 
     // Check if the function is a pattern matching function
-    for (FunctionNode* function : functions.at(identifier))
+    for (FunctionNode* function : *overloads)
     {
+        Stats::instance().overload_scanned();
         if (function->is_pattern_matching() && function->matches(arguments)) { return function; }
     }
 
     // Check if the function is a regular function
-    for (FunctionNode* function : functions.at(identifier))
+    for (FunctionNode* function : *overloads)
     {
+        Stats::instance().overload_scanned();
         if (!function->is_pattern_matching() && function->get_parameters().size() == arguments.size())
         {
             return function;
@@ -39,13 +58,22 @@ FunctionNode* Registry::get_function(const String& identifier, const Vector<Expr
     return nullptr;
 }
 
+Registry::Overloads Registry::get_overloads(const String& identifier) const
+{
+    std::shared_lock<std::shared_mutex> guard{lock};
+    auto it = functions.find(identifier);
+    return it != functions.end() ? it->second : nullptr;
+}
+
 void Registry::remove_function(const String& identifier)
 {
+    std::unique_lock<std::shared_mutex> guard{lock};
     functions.erase(identifier);
 }
 
 bool Registry::contains(const String& identifier) const
 {
+    std::shared_lock<std::shared_mutex> guard{lock};
     return functions.find(identifier) != functions.end();
 }
 
@@ -1,35 +1,116 @@
 #include "parser/Scope.h"
+#include "ast/expression/VariableNode.h"
 
 namespace funk
 {
 
-Scope::Scope() {}
-Scope::~Scope()
+Node* Scope::Frame::find(const String& name) const
 {
-    for (auto& scope : scopes)
+    if (!index.empty())
+    {
+        auto it = index.find(name);
+        return it != index.end() ? symbols[it->second].second : nullptr;
+    }
+
+    for (size_t i{0}; i < size; i++)
+    {
+        if (symbols[i].first == name) { return symbols[i].second; }
+    }
+    return nullptr;
+}
+
+void Scope::Frame::set(const String& name, Node* node)
+{
+    if (!index.empty())
+    {
+        auto it = index.find(name);
+        if (it != index.end())
+        {
+            symbols[it->second].second = node;
+            return;
+        }
+    }
+    else
     {
-        for (auto& [name, node] : scope) { delete node; }
+        for (size_t i{0}; i < size; i++)
+        {
+            if (symbols[i].first == name)
+            {
+                symbols[i].second = node;
+                return;
+            }
+        }
+    }
+
+    // Reuse the slot of a previous use of the frame, keeping the capacity of its name
+    if (size < symbols.size())
+    {
+        symbols[size].first.assign(name);
+        symbols[size].second = node;
+    }
+    else { symbols.emplace_back(name, node); }
+    size++;
+
+    if (!index.empty()) { index.emplace(name, size - 1); }
+    else if (size > INDEX_THRESHOLD)
+    {
+        for (size_t i{0}; i < size; i++) { index.emplace(symbols[i].first, i); }
     }
 }
 
+void Scope::Frame::reserve(size_t slots)
+{
+    symbols.reserve(slots);
+}
+
+void Scope::Frame::clear()
+{
+    size = 0;
+    if (!index.empty()) { index.clear(); }
+}
+
+void Scope::Frame::delete_nodes()
+{
+    for (size_t i{0}; i < size; i++) { delete symbols[i].second; }
+    clear();
+}
+
+thread_local Scope* Scope::current{nullptr};
+
+Scope::Scope() {}
+Scope::~Scope()
+{
+    for (int i{0}; i < depth; i++) { frames[i].delete_nodes(); }
+}
+
 Scope& Scope::instance()
 {
-    static Scope instance;
-    return instance;
+    static Scope global;
+    return current ? *current : global;
 }
 
-void Scope::push()
+Scope* Scope::enter(Scope* scope)
+{
+    Scope* previous{current};
+    current = scope;
+    return previous;
+}
+
+void Scope::push(size_t slots)
 {
     LOG_DEBUG("Pushing scope at depth " + to_str(depth) + " -> " + to_str(depth + 1));
     if (depth++ >= MAX_DEPTH) { throw RuntimeError("Scope stack overflow, max depth is " + to_str(MAX_DEPTH)); }
-    scopes.push_back({});
+    if (static_cast<size_t>(depth) > frames.size()) { frames.emplace_back(); }
+    frames[depth - 1].reserve(slots);
+    Stats::instance().scope_pushed(depth);
 }
 
 void Scope::pop()
 {
     LOG_DEBUG("Popping scope at depth " + to_str(depth) + " -> " + to_str(depth - 1));
     if (depth-- <= 0) { throw RuntimeError("Scope stack underflow, can't go below 0"); }
-    scopes.pop_back();
+    frames[depth].clear();
+    Stats::instance().scope_popped();
 }
 
 void Scope::add(const String& name, Node* node)
@@ -45,36 +126,82 @@ void Scope::add(const String& name, Node* node)
     // }
 
     LOG_DEBUG("Registering symbol '" + name + "' with node " + node->to_s());
-    scopes.back()[name] = node;
+    if (depth == 0) { throw RuntimeError(node->get_location(), "No scope to register symbol '" + name + "' in"); }
+    frames[depth - 1].set(name, node);
 }
 
 Node* Scope::get(const String& name) const
 {
-    for (int i = scopes.size() - 1; i >= 0; i--)
+    for (int i = depth - 1; i >= 0; i--)
     {
         LOG_DEBUG("Searching for symbol '" + name + "' at depth " + to_str(i));
-        auto it = scopes[i].find(name);
-        if (it != scopes[i].end())
+        if (Node* node = frames[i].find(name))
         {
             LOG_DEBUG("Found symbol '" + name + "' at depth " + to_str(i));
-            return it->second;
+            Stats::instance().scope_lookup(depth - i);
+            return node;
         }
     }
+    Stats::instance().scope_lookup(depth);
     return nullptr;
 }
 
 bool Scope::contains(const String& name) const
 {
-    for (int i = scopes.size() - 1; i >= 0; i--)
+    for (int i = depth - 1; i >= 0; i--)
     {
-        if (scopes[i].find(name) != scopes[i].end()) { return true; }
+        if (frames[i].find(name)) { return true; }
     }
     return false;
 }
 bool Scope::contains_in_current_scope(const String& name) const
 {
-    if (scopes.empty()) return false;
-    return scopes.back().find(name) != scopes.back().end();
+    if (depth == 0) return false;
+    return frames[depth - 1].find(name) != nullptr;
+}
+
+Vector<Pair<String, Node*>> Scope::visible() const
+{
+    Vector<Pair<String, Node*>> symbols{};
+    for (int i = depth - 1; i >= 0; i--)
+    {
+        for (size_t j{0}; j < frames[i].count(); j++)
+        {
+            const Pair<String, Node*>& symbol{frames[i].at(j)};
+            auto hidden = [&symbol](const Pair<String, Node*>& inner) { return inner.first == symbol.first; };
+            if (std::none_of(symbols.begin(), symbols.end(), hidden)) { symbols.push_back(symbol); }
+        }
+    }
+    return symbols;
+}
+
+void Scope::capture(Vector<Node*>& copies)
+{
+    Vector<Pair<String, Node*>> symbols{instance().visible()};
+    push(symbols.size());
+    for (const Pair<String, Node*>& symbol : symbols) { add(symbol.first, capture(symbol.second, copies)); }
+}
+
+Node* Scope::capture(Node* node, Vector<Node*>& copies)
+{
+    auto var = node_cast<VariableNode>(node);
+    if (!var) { return node; }
+
+    // Parameters can refer to the variable passed as argument, copy the value at the end of the chain
+    ExpressionNode* value{var->get_value_node()};
+    while (auto inner = node_cast<VariableNode>(value))
+    {
+        if (!inner->get_value_node()) { break; }
+        value = inner->get_value_node();
+    }
+
+    auto literal = node_cast<LiteralNode>(value);
+    if (!literal) { return node; }
+
+    auto copy = new VariableNode(var->get_location(), var->get_identifier(), var->get_mutable(), var->get_type(),
+        new LiteralNode(literal->get_location(), literal->get_value()));
+    copies.push_back(copy);
+    return copy;
 }
 
 } // namespace funk
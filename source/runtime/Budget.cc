@@ -0,0 +1,86 @@
+#include "runtime/Budget.h"
+#include "runtime/Fiber.h"
+#include <algorithm>
+
+namespace funk
+{
+
+static const uint64_t UNLIMITED{UINT64_MAX}; ///< Countdown of threads that check no budget and run no fiber
+
+thread_local Budget* Budget::current{nullptr};
+thread_local uint64_t Budget::countdown{UNLIMITED};
+thread_local uint64_t Budget::armed{UNLIMITED};
+thread_local int64_t Budget::unsettled_bytes{0};
+
+Budget::Budget(const Limits& limits) : limits(limits), started(std::chrono::steady_clock::now()) {}
+
+Budget* Budget::enter(Budget* budget)
+{
+    // Steps taken since the last checkpoint still count, but never use up the slice of a fiber
+    uint64_t used{armed - countdown};
+    settle(used);
+    Fiber::elapse(used);
+
+    Budget* previous{current};
+    current = budget;
+    arm();
+    return previous;
+}
+
+void Budget::arm()
+{
+    uint64_t interval{current ? CHECK_INTERVAL : UNLIMITED};
+    armed = std::min(interval, Fiber::remaining());
+    countdown = armed;
+}
+
+std::chrono::milliseconds Budget::get_elapsed() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+}
+
+String Budget::usage() const
+{
+    return to_str(get_steps()) + " steps, " + to_str(get_elapsed().count()) + " ms and " + to_str(get_memory()) +
+           " bytes";
+}
+
+void Budget::checkpoint(const SourceLocation& location)
+{
+    uint64_t used{armed};
+    settle(used);
+    bool preempted{Fiber::elapse(used)};
+    arm();
+
+    if (current) { current->check(location); }
+    if (preempted) { Fiber::suspend(); }
+}
+
+void Budget::settle(uint64_t used)
+{
+    if (current)
+    {
+        current->steps.fetch_add(used, std::memory_order_relaxed);
+        current->memory.fetch_add(unsettled_bytes, std::memory_order_relaxed);
+    }
+    unsettled_bytes = 0;
+}
+
+void Budget::check(const SourceLocation& location) const
+{
+    if (limits.steps > 0 && get_steps() > limits.steps)
+    {
+        throw RuntimeError(location, "Step limit of " + to_str(limits.steps) + " exceeded after " + usage());
+    }
+    if (limits.memory > 0 && get_memory() > static_cast<int64_t>(limits.memory))
+    {
+        throw RuntimeError(location, "Memory limit of " + to_str(limits.memory) + " bytes exceeded after " + usage());
+    }
+    if (limits.timeout.count() > 0 && get_elapsed() > limits.timeout)
+    {
+        throw RuntimeError(location, "Time limit of " + to_str(limits.timeout.count()) + " ms exceeded after " +
+                                         usage());
+    }
+}
+
+} // namespace funk
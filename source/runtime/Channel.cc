@@ -0,0 +1,178 @@
+#include "runtime/Channel.h"
+#include "runtime/Scheduler.h"
+#include "utils/Exception.h"
+
+namespace funk
+{
+
+Channel::Channel(size_t capacity) :
+    capacity(std::max<size_t>(capacity, 1)), ring(std::max<size_t>(capacity, 2)), slots(new Slot[ring])
+{
+    for (size_t i{0}; i < ring; i++) { slots[i].sequence.store(i, std::memory_order_relaxed); }
+}
+
+std::shared_ptr<Channel> Channel::from(const NodeValue& value)
+{
+    if (value.get_token_type() != TokenType::CHANNEL) { return nullptr; }
+    return std::static_pointer_cast<Channel>(value.as_object());
+}
+
+String Channel::to_s() const
+{
+    return "<channel " + to_str(capacity) + (is_closed() ? " closed>" : ">");
+}
+
+bool Channel::try_send(const NodeValue& value)
+{
+    size_t position{tail.load(std::memory_order_relaxed)};
+    while (true)
+    {
+        // Only a channel of one value has more slots than values, the sequence of a free slot can't tell it is full
+        if (ring > capacity && position >= head.load(std::memory_order_acquire) + capacity) { return false; }
+
+        Slot& slot{slots[position % ring]};
+        size_t sequence{slot.sequence.load(std::memory_order_acquire)};
+
+        if (sequence == position)
+        {
+            // The slot is free, claim it unless another sender got there first
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.value = value;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        // The slot still holds the value sent one lap earlier
+        else if (sequence < position) { return false; }
+        else { position = tail.load(std::memory_order_relaxed); }
+    }
+}
+
+bool Channel::try_recv(NodeValue& value)
+{
+    size_t position{head.load(std::memory_order_relaxed)};
+    while (true)
+    {
+        Slot& slot{slots[position % ring]};
+        size_t sequence{slot.sequence.load(std::memory_order_acquire)};
+
+        if (sequence == position + 1)
+        {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                value = std::move(slot.value);
+                slot.value = NodeValue{};
+                // Free the slot for the send one lap later
+                slot.sequence.store(position + ring, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (sequence < position + 1) { return false; }
+        else { position = head.load(std::memory_order_relaxed); }
+    }
+}
+
+template <typename Ready> void Channel::block(Ready ready)
+{
+    Scheduler::instance().blocking();
+    {
+        std::unique_lock<std::mutex> guard{lock};
+        waiting.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in notify(), either the notifier sees the waiter or the waiter sees the change
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        changed.wait(guard, ready);
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+    Scheduler::instance().unblocked();
+}
+
+void Channel::notify()
+{
+    // Orders the change of the ring before the check, a thread that starts waiting after it sees the change
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) == 0) { return; }
+
+    {
+        std::lock_guard<std::mutex> guard{lock};
+    }
+    changed.notify_all();
+}
+
+void Channel::send(const NodeValue& value)
+{
+    TokenType value_type{value.get_token_type()};
+    if (value_type == TokenType::NONE) { throw TypeError("Cannot send none to a channel"); }
+
+    TokenType expected{TokenType::NONE};
+    if (!type.compare_exchange_strong(expected, value_type) && expected != value_type)
+    {
+        throw TypeError("Cannot send " + token_type_to_s(value_type) + " to a channel of " + token_type_to_s(expected));
+    }
+
+    while (true)
+    {
+        // Counted before the check, so a receiver that sees the channel closed waits for the value to be stored
+        sending.fetch_add(1, std::memory_order_seq_cst);
+        if (is_closed())
+        {
+            sending.fetch_sub(1, std::memory_order_seq_cst);
+            notify();
+            throw RuntimeError("Cannot send to a closed channel");
+        }
+        bool sent{try_send(value)};
+        sending.fetch_sub(1, std::memory_order_seq_cst);
+        if (sent) { break; }
+
+        block([this] {
+            size_t used{tail.load(std::memory_order_relaxed) - head.load(std::memory_order_relaxed)};
+            return is_closed() || used < capacity;
+        });
+    }
+
+    notify();
+}
+
+bool Channel::has_ended() const
+{
+    // Pairs with the count of senders, a send not counted yet sees the channel closed and fails
+    if (!closed.load(std::memory_order_seq_cst) || sending.load(std::memory_order_seq_cst) > 0) { return false; }
+    return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+}
+
+bool Channel::recv(NodeValue& value)
+{
+    while (!try_recv(value))
+    {
+        // Values sent before the channel was closed are still received, also those whose send is under way
+        if (has_ended()) { return false; }
+
+        block([this] {
+            return has_ended() || tail.load(std::memory_order_relaxed) != head.load(std::memory_order_relaxed);
+        });
+    }
+
+    notify();
+    return true;
+}
+
+bool Channel::is_done()
+{
+    while (tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire))
+    {
+        if (has_ended()) { return true; }
+
+        block([this] {
+            return has_ended() || tail.load(std::memory_order_relaxed) != head.load(std::memory_order_relaxed);
+        });
+    }
+    return false;
+}
+
+void Channel::close()
+{
+    closed.store(true, std::memory_order_seq_cst);
+    notify();
+}
+
+} // namespace funk
@@ -0,0 +1,169 @@
+#include "runtime/Fiber.h"
+#include "io/Reader.h"
+#include "io/Writer.h"
+#include "parser/Registry.h"
+#include "parser/Scope.h"
+#include "runtime/Budget.h"
+#include "utils/Stats.h"
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+namespace funk
+{
+
+static const uint64_t UNLIMITED{UINT64_MAX}; ///< Slice of threads that run no fiber
+
+thread_local Fiber* Fiber::running{nullptr};
+thread_local uint64_t Fiber::slice_left{UNLIMITED};
+
+/**
+ * @brief Gets the size of the page that guards the bottom of a stack.
+ * @return size_t Page size in bytes
+ */
+static size_t guard_size()
+{
+    static const size_t size{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+    return size;
+}
+
+/**
+ * @brief Tells the address sanitizer that the thread is about to switch stacks, does nothing in other builds.
+ */
+static void start_switch([[maybe_unused]] void** fake_stack, [[maybe_unused]] const void* bottom,
+    [[maybe_unused]] size_t size)
+{
+#if defined(__SANITIZE_ADDRESS__)
+    __sanitizer_start_switch_fiber(fake_stack, bottom, size);
+#endif
+}
+
+/**
+ * @brief Tells the address sanitizer that the thread switched stacks, does nothing in other builds.
+ */
+static void finish_switch([[maybe_unused]] void* fake_stack, [[maybe_unused]] const void** bottom,
+    [[maybe_unused]] size_t* size)
+{
+#if defined(__SANITIZE_ADDRESS__)
+    __sanitizer_finish_switch_fiber(fake_stack, bottom, size);
+#endif
+}
+
+Fiber::Fiber(Body body) : body(std::move(body))
+{
+    // An overflow of the stack faults on the guard page instead of writing over other memory
+    void* memory{mmap(nullptr, guard_size() + STACK_SIZE, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0)};
+    if (memory == MAP_FAILED) { throw std::bad_alloc{}; }
+    mprotect(memory, guard_size(), PROT_NONE);
+    stack = static_cast<char*>(memory) + guard_size();
+}
+
+Fiber::~Fiber()
+{
+#if defined(__SANITIZE_ADDRESS__)
+    // The sanitizer keeps the frames of the body poisoned, a stack mapped at the same address later must not see them
+    ASAN_UNPOISON_MEMORY_REGION(stack, STACK_SIZE);
+#endif
+    munmap(static_cast<char*>(stack) - guard_size(), guard_size() + STACK_SIZE);
+}
+
+void Fiber::resume(uint64_t slice)
+{
+    if (done) { return; }
+
+    if (!started)
+    {
+        getcontext(&context);
+        context.uc_stack.ss_sp = stack;
+        context.uc_stack.ss_size = STACK_SIZE;
+        context.uc_link = &caller;
+        makecontext(&context, &Fiber::start, 0);
+        started = true;
+    }
+
+    // The steps of the caller are charged to its budget before the fiber takes over the countdown
+    Budget* caller_budget{Budget::enter(budget)};
+    Fiber* outer{running};
+    uint64_t outer_left{slice_left};
+    running = this;
+    this->slice = slice;
+    slice_left = slice;
+    Budget::arm();
+    Scope* caller_scope{Scope::enter(scope)};
+    Registry* caller_registry{Registry::enter(registry)};
+    Reader* caller_reader{Reader::enter(reader)};
+    Writer* caller_writer{Writer::enter(writer)};
+
+    void* fake_stack{nullptr};
+    start_switch(&fake_stack, stack, STACK_SIZE);
+    swapcontext(&caller, &context);
+    finish_switch(fake_stack, nullptr, nullptr);
+
+    scope = Scope::enter(caller_scope);
+    registry = Registry::enter(caller_registry);
+    reader = Reader::enter(caller_reader);
+    writer = Writer::enter(caller_writer);
+    budget = Budget::enter(caller_budget);
+    running = outer;
+    slice_left = outer_left;
+    Budget::arm();
+
+    if (done && error)
+    {
+        std::exception_ptr failed{error};
+        error = nullptr;
+        std::rethrow_exception(failed);
+    }
+}
+
+uint64_t Fiber::remaining()
+{
+    return running ? slice_left : UNLIMITED;
+}
+
+bool Fiber::elapse(uint64_t steps)
+{
+    if (!running) { return false; }
+
+    slice_left -= steps;
+    if (slice_left > 0) { return false; }
+    slice_left = running->slice;
+    return true;
+}
+
+void Fiber::suspend()
+{
+    Fiber* fiber{running};
+    if (!fiber) { return; }
+
+    Stats::instance().fiber_preempted();
+    void* fake_stack{nullptr};
+    start_switch(&fake_stack, fiber->caller_bottom, fiber->caller_size);
+    swapcontext(&fiber->context, &fiber->caller);
+    finish_switch(fake_stack, &fiber->caller_bottom, &fiber->caller_size);
+}
+
+void Fiber::start()
+{
+    Fiber* fiber{running};
+    finish_switch(nullptr, &fiber->caller_bottom, &fiber->caller_size);
+    try
+    {
+        fiber->body();
+    }
+    catch (...)
+    {
+        fiber->error = std::current_exception();
+    }
+    // Returning switches to the caller through uc_link
+    fiber->done = true;
+    start_switch(nullptr, fiber->caller_bottom, fiber->caller_size);
+}
+
+} // namespace funk
@@ -0,0 +1,186 @@
+#include "runtime/Generator.h"
+#include "ast/control/IfNode.h"
+#include "ast/control/YieldNode.h"
+#include "ast/expression/LiteralNode.h"
+#include "runtime/Budget.h"
+
+namespace funk
+{
+
+Generator::Generator(const FunctionNode* function, const Vector<NodeValue>& arguments) : function(function)
+{
+    scope.capture(owned);
+
+    const Vector<Pair<TokenType, String>>& parameters{function->get_parameters()};
+    BlockNode* body{function->get_body()};
+    scope.push(arguments.size() + body->get_slot_count());
+    for (size_t i{0}; i < arguments.size(); i++)
+    {
+        auto var = new VariableNode(function->get_location(), parameters[i].second, false, parameters[i].first,
+            new LiteralNode(function->get_location(), arguments[i]));
+        owned.push_back(var);
+        scope.add(parameters[i].second, var);
+    }
+    base_depth = scope.get_depth();
+
+    // The body shares the scope of the parameters, like a called function
+    frames.push_back(Frame{body->get_statements()});
+}
+
+Generator::~Generator()
+{
+    // The scopes only refer to nodes owned by the program or by the generator, pop them before the nodes are deleted
+    while (scope.get_depth() > 0) { scope.pop(); }
+    for (Node* node : owned) { delete node; }
+}
+
+std::shared_ptr<Generator> Generator::from(const NodeValue& value)
+{
+    if (value.get_token_type() != TokenType::GENERATOR) { return nullptr; }
+    return std::static_pointer_cast<Generator>(value.as_object());
+}
+
+String Generator::to_s() const
+{
+    return "<generator " + function->get_identifier() + (frames.empty() && !has_peeked ? " done>" : ">");
+}
+
+bool Generator::next(NodeValue& value)
+{
+    std::lock_guard<std::recursive_mutex> guard{lock};
+    if (has_peeked)
+    {
+        value = peeked;
+        peeked = NodeValue{};
+        has_peeked = false;
+        return true;
+    }
+    return resume(value);
+}
+
+bool Generator::is_done()
+{
+    std::lock_guard<std::recursive_mutex> guard{lock};
+    if (!has_peeked) { has_peeked = resume(peeked); }
+    return !has_peeked;
+}
+
+void Generator::enter(const Vector<Node*>& statements, size_t slots, const WhileNode* loop)
+{
+    Frame frame{statements};
+    frame.slots = slots;
+    frame.scoped = slots > 0;
+    frame.loop = loop;
+    if (frame.scoped) { scope.push(slots); }
+    frames.push_back(std::move(frame));
+}
+
+void Generator::leave()
+{
+    if (frames.back().scoped) { scope.pop(); }
+    frames.pop_back();
+}
+
+bool Generator::resume(NodeValue& value)
+{
+    if (frames.empty()) { return false; }
+    if (running)
+    {
+        String name{function->get_identifier()};
+        throw RuntimeError(function->get_location(), "Generator " + name + " can't resume itself");
+    }
+
+    running = true;
+    Scope* previous{Scope::enter(&scope)};
+
+    try
+    {
+        while (!frames.empty())
+        {
+            Frame& frame{frames.back()};
+            if (frame.next == frame.statements.size())
+            {
+                if (frame.loop) { Budget::step(frame.loop->get_location()); }
+                // The end of a loop body runs the loop again in a fresh scope while its condition holds
+                if (frame.loop && frame.loop->get_condition()->get_value().cast<bool>())
+                {
+                    frame.next = 0;
+                    if (frame.scoped)
+                    {
+                        scope.pop();
+                        scope.push(frame.slots);
+                    }
+                }
+                else { leave(); }
+                continue;
+            }
+
+            Node* statement{frame.statements[frame.next++]};
+            switch (statement->get_kind())
+            {
+            case NodeKind::YIELD:
+            {
+                Stats::instance().evaluated(NodeKind::YIELD);
+                value = static_cast<YieldNode*>(statement)->get_value()->get_value();
+                running = false;
+                Scope::enter(previous);
+                return true;
+            }
+            case NodeKind::RETURN:
+            {
+                Stats::instance().evaluated(NodeKind::RETURN);
+                while (!frames.empty()) { leave(); }
+                break;
+            }
+            case NodeKind::BLOCK:
+            {
+                Stats::instance().evaluated(NodeKind::BLOCK);
+                auto block = static_cast<BlockNode*>(statement);
+                enter(block->get_statements(), block->get_slot_count());
+                break;
+            }
+            case NodeKind::IF:
+            {
+                Stats::instance().evaluated(NodeKind::IF);
+                auto if_node = static_cast<IfNode*>(statement);
+                if (if_node->get_condition()->get_value().cast<bool>())
+                {
+                    enter(if_node->get_body()->get_statements(), if_node->get_body()->get_slot_count());
+                }
+                else if (Node* else_branch = if_node->get_else_branch())
+                {
+                    // An else branch is a block or another if statement, run it as a block of its own
+                    enter({else_branch}, 0);
+                }
+                break;
+            }
+            case NodeKind::WHILE:
+            {
+                Stats::instance().evaluated(NodeKind::WHILE);
+                auto loop = static_cast<WhileNode*>(statement);
+                if (loop->get_condition()->get_value().cast<bool>())
+                {
+                    enter(loop->get_body()->get_statements(), loop->get_body()->get_slot_count(), loop);
+                }
+                break;
+            }
+            default: statement->evaluate(); break;
+            }
+        }
+    }
+    catch (...)
+    {
+        // A failed body ends the sequence, scopes pushed by the nodes that threw are left behind as well
+        frames.clear();
+        while (scope.get_depth() > base_depth) { scope.pop(); }
+        running = false;
+        Scope::enter(previous);
+        throw;
+    }
+
+    running = false;
+    Scope::enter(previous);
+    return false;
+}
+
+} // namespace funk
@@ -0,0 +1,508 @@
+#include "runtime/Map.h"
+#include "runtime/Budget.h"
+#include "utils/Exception.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+namespace funk
+{
+
+static constexpr unsigned TRIE_BITS = 5;  ///< Bits of the hash that index the children of a trie node
+static constexpr uint64_t TRIE_MASK = 31; ///< Mask of the bits that index the children of a trie node
+static constexpr unsigned HASH_BITS = 64; ///< Bits of a hash, keys whose hashes are equal share a collision node
+
+/**
+ * @brief Node of a hash array mapped trie.
+ * Only the children that are present are stored, in the order of their position, and a bit of the bitmap is set for
+ * every position that has one. A child is either a node or, if it is the only key below that position, an entry.
+ * Below the last bits of the hash, a collision node holds the entries whose hashes are equal in a list.
+ */
+struct Map::Trie
+{
+    /**
+     * @brief Child of a node, an entry if it is not a node.
+     */
+    struct Slot
+    {
+        TrieRef child{}; ///< The node, or null if the child is an entry
+        Entry entry{};   ///< The entry
+    };
+
+    uint32_t bitmap{0};   ///< Positions that have a child
+    Vector<Slot> slots{}; ///< The children, in the order of their positions
+    size_t bytes{0};      ///< Memory of the node counted against the budget
+
+    Trie() { count_memory(); }
+
+    Trie(const Trie& other) : bitmap(other.bitmap), slots(other.slots) { count_memory(); }
+
+    ~Trie() { Budget::released(bytes); }
+
+    Trie& operator=(const Trie&) = delete;
+
+    /**
+     * @brief Gets the index in the slots of the child at a position.
+     */
+    size_t index_of(uint32_t bit) const { return static_cast<size_t>(__builtin_popcount(bitmap & (bit - 1))); }
+
+    /**
+     * @brief Counts a change in the memory of the node against the budget of the run.
+     */
+    void count_memory()
+    {
+        size_t now{sizeof(Trie) + slots.capacity() * sizeof(Slot)};
+        if (now > bytes) { Budget::allocated(now - bytes); }
+        else { Budget::released(bytes - now); }
+        bytes = now;
+    }
+};
+
+/**
+ * @brief Spreads the bits of a small key over the whole hash, so that neighbouring numbs don't fill a run of slots.
+ */
+static uint64_t mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Converts a key or value to a string the way it is written in a literal.
+ */
+static String show(const NodeValue& value)
+{
+    if (value.is_a<String>()) { return "\"" + value.as_text() + "\""; }
+    if (value.is_a<char>()) { return "'" + String(1, value.as_char()) + "'"; }
+    return value.cast<String>();
+}
+
+Map::Map(const Map& other) :
+    Object(other), count(other.count), key_type(other.key_type), value_type(other.value_type),
+    persistent(other.persistent), root(std::atomic_load(&other.root)), next_order(other.next_order)
+{
+    // Keep the spare capacity, so the copy grows no sooner than the original would
+    entries.reserve(other.entries.capacity());
+    entries.insert(entries.end(), other.entries.begin(), other.entries.end());
+    slots = other.slots;
+    count_memory();
+}
+
+Map::~Map()
+{
+    Budget::released(bytes);
+}
+
+std::shared_ptr<Map> Map::from(const NodeValue& value)
+{
+    if (value.get_token_type() != TokenType::MAP) { return nullptr; }
+    return std::static_pointer_cast<Map>(value.as_object());
+}
+
+std::shared_ptr<Map> Map::iterable(const std::shared_ptr<Map>& map)
+{
+    if (!map->persistent) { return map; }
+
+    auto copy = std::make_shared<Map>(*map);
+    copy->thaw();
+    return copy;
+}
+
+String Map::to_s() const
+{
+    if (count == 0) { return "{}"; }
+    if (persistent)
+    {
+        Map copy{*this};
+        copy.thaw();
+        return copy.to_s();
+    }
+
+    String result{"{ "};
+    size_t position{0};
+    NodeValue key{};
+    NodeValue value{};
+    bool first{true};
+    while (next(position, key, value))
+    {
+        if (!first) { result += ", "; }
+        result += show(key) + ": " + show(value);
+        first = false;
+    }
+    return result + " }";
+}
+
+const NodeValue* Map::find(const NodeValue& key) const
+{
+    uint64_t key_hash{hash(key)};
+    if (persistent) { return find_in(root.get(), key, key_hash, 0); }
+
+    size_t slot{probe(key, key_hash)};
+    return slot < slots.size() ? &entries[slots[slot]].value : nullptr;
+}
+
+void Map::check(const NodeValue& key, const NodeValue& value) const
+{
+    TokenType new_key_type{key.get_token_type()};
+    TokenType new_value_type{value.get_token_type()};
+    if (new_key_type == TokenType::NONE) { throw TypeError("Cannot use none as a map key"); }
+    if (new_value_type == TokenType::NONE) { throw TypeError("Cannot store none in a map"); }
+    if (key_type != TokenType::NONE && new_key_type != key_type)
+    {
+        throw TypeError("Cannot use " + token_type_to_s(new_key_type) + " as a key of a map with " +
+                        token_type_to_s(key_type) + " keys");
+    }
+    if (value_type != TokenType::NONE && new_value_type != value_type)
+    {
+        throw TypeError("Cannot store " + token_type_to_s(new_value_type) + " in a map of " +
+                        token_type_to_s(value_type) + " values");
+    }
+}
+
+void Map::set(const NodeValue& key, const NodeValue& value)
+{
+    check(key, value);
+    key_type = key.get_token_type();
+    value_type = value.get_token_type();
+
+    // The trie made of the table no longer matches it
+    if (persistent) { thaw(); }
+    root.reset();
+
+    uint64_t key_hash{hash(key)};
+    size_t slot{probe(key, key_hash)};
+    if (slot < slots.size()) { entries[slots[slot]].value = value; }
+    else { insert(key, value, key_hash); }
+}
+
+void Map::insert(const NodeValue& key, const NodeValue& value, uint64_t key_hash)
+{
+    // Removed entries count towards the load, so a map that only ever adds and removes keys is compacted in place
+    if (entries.size() + 1 > slots.size() / 3 * 2) { rehash(std::max(count + 1, count * 2)); }
+
+    size_t mask{slots.size() - 1};
+    size_t slot{key_hash & mask};
+    while (slots[slot] >= 0) { slot = (slot + 1) & mask; }
+    slots[slot] = static_cast<int32_t>(entries.size());
+    entries.push_back(Entry{key, value, key_hash});
+    count++;
+}
+
+bool Map::remove(const NodeValue& key)
+{
+    if (persistent) { thaw(); }
+
+    size_t slot{probe(key, hash(key))};
+    if (slot == slots.size()) { return false; }
+
+    root.reset();
+    Entry& entry{entries[slots[slot]]};
+    entry.key = NodeValue{};
+    entry.value = NodeValue{};
+    slots[slot] = REMOVED;
+    count--;
+    return true;
+}
+
+std::shared_ptr<Map> Map::with(const NodeValue& key, const NodeValue& value) const
+{
+    check(key, value);
+
+    auto copy = persistent_copy();
+    copy->key_type = key.get_token_type();
+    copy->value_type = value.get_token_type();
+    if (insert_into(copy->root, Entry{key, value, hash(key), copy->next_order}, 0))
+    {
+        copy->count++;
+        copy->next_order++;
+    }
+    return copy;
+}
+
+std::shared_ptr<Map> Map::without(const NodeValue& key) const
+{
+    auto copy = persistent_copy();
+    uint64_t key_hash{hash(key)};
+    if (find_in(copy->root.get(), key, key_hash, 0))
+    {
+        erase_from(copy->root, key, key_hash, 0);
+        copy->count--;
+    }
+    return copy;
+}
+
+std::shared_ptr<Map> Map::persistent_copy() const
+{
+    auto copy = std::make_shared<Map>();
+    copy->persistent = true;
+    copy->root = get_trie();
+    copy->count = count;
+    copy->key_type = key_type;
+    copy->value_type = value_type;
+    copy->next_order = persistent ? next_order : count;
+    return copy;
+}
+
+Map::TrieRef Map::get_trie() const
+{
+    if (persistent) { return root; }
+
+    // Tasks sharing the map may make the trie at the same time, each one makes the same trie
+    TrieRef trie{std::atomic_load(&root)};
+    if (trie || count == 0) { return trie; }
+
+    uint64_t order{0};
+    for (const Entry& entry : entries)
+    {
+        if (!entry.key.is_nothing()) { insert_into(trie, Entry{entry.key, entry.value, entry.hash, order++}, 0); }
+    }
+    std::atomic_store(&root, trie);
+    return trie;
+}
+
+void Map::thaw()
+{
+    Vector<const Entry*> ordered{};
+    ordered.reserve(count);
+    collect(root.get(), ordered);
+    std::sort(ordered.begin(), ordered.end(),
+        [](const Entry* lhs, const Entry* rhs) { return lhs->order < rhs->order; });
+
+    // The trie holds the entries until they are copied into the table
+    TrieRef trie{std::move(root)};
+    persistent = false;
+    entries.clear();
+    count = 0;
+    rehash(ordered.size());
+    for (const Entry* entry : ordered) { insert(entry->key, entry->value, entry->hash); }
+}
+
+const NodeValue* Map::find_in(const Trie* node, const NodeValue& key, uint64_t key_hash, unsigned shift)
+{
+    for (; node; shift += TRIE_BITS)
+    {
+        if (shift >= HASH_BITS)
+        {
+            for (const Trie::Slot& slot : node->slots)
+            {
+                if (same(slot.entry.key, key)) { return &slot.entry.value; }
+            }
+            return nullptr;
+        }
+
+        uint32_t bit{1u << ((key_hash >> shift) & TRIE_MASK)};
+        if (!(node->bitmap & bit)) { return nullptr; }
+
+        const Trie::Slot& slot{node->slots[node->index_of(bit)]};
+        if (!slot.child)
+        {
+            return slot.entry.hash == key_hash && same(slot.entry.key, key) ? &slot.entry.value : nullptr;
+        }
+        node = slot.child.get();
+    }
+    return nullptr;
+}
+
+bool Map::insert_into(TrieRef& node, Entry entry, unsigned shift)
+{
+    // Nodes shared with other maps are copied, a node that only this map holds is changed in place
+    if (!node) { node = std::make_shared<Trie>(); }
+    else if (node.use_count() > 1) { node = std::make_shared<Trie>(*node); }
+    Trie& trie{*node};
+
+    if (shift >= HASH_BITS)
+    {
+        for (Trie::Slot& slot : trie.slots)
+        {
+            if (same(slot.entry.key, entry.key))
+            {
+                slot.entry.value = std::move(entry.value);
+                return false;
+            }
+        }
+        trie.slots.push_back(Trie::Slot{nullptr, std::move(entry)});
+        trie.count_memory();
+        return true;
+    }
+
+    uint32_t bit{1u << ((entry.hash >> shift) & TRIE_MASK)};
+    size_t index{trie.index_of(bit)};
+    if (!(trie.bitmap & bit))
+    {
+        auto at = trie.slots.begin() + static_cast<std::ptrdiff_t>(index);
+        trie.slots.insert(at, Trie::Slot{nullptr, std::move(entry)});
+        trie.bitmap |= bit;
+        trie.count_memory();
+        return true;
+    }
+
+    Trie::Slot& slot{trie.slots[index]};
+    if (slot.child) { return insert_into(slot.child, std::move(entry), shift + TRIE_BITS); }
+    if (slot.entry.hash == entry.hash && same(slot.entry.key, entry.key))
+    {
+        // The key keeps its place in insertion order
+        slot.entry.value = std::move(entry.value);
+        return false;
+    }
+
+    // Another key is at the position, move both a level down
+    TrieRef child{};
+    insert_into(child, std::move(slot.entry), shift + TRIE_BITS);
+    insert_into(child, std::move(entry), shift + TRIE_BITS);
+    slot.child = std::move(child);
+    slot.entry = Entry{};
+    return true;
+}
+
+void Map::erase_from(TrieRef& node, const NodeValue& key, uint64_t key_hash, unsigned shift)
+{
+    if (node.use_count() > 1) { node = std::make_shared<Trie>(*node); }
+    Trie& trie{*node};
+
+    if (shift >= HASH_BITS)
+    {
+        auto found = std::find_if(
+            trie.slots.begin(), trie.slots.end(), [&key](const Trie::Slot& slot) { return same(slot.entry.key, key); });
+        if (found != trie.slots.end()) { trie.slots.erase(found); }
+    }
+    else
+    {
+        uint32_t bit{1u << ((key_hash >> shift) & TRIE_MASK)};
+        size_t index{trie.index_of(bit)};
+        Trie::Slot& slot{trie.slots[index]};
+        if (slot.child)
+        {
+            erase_from(slot.child, key, key_hash, shift + TRIE_BITS);
+
+            // A node left with a single entry is replaced by the entry, so lookups don't have to walk through it
+            const Trie& child{*slot.child};
+            if (child.slots.size() == 1 && !child.slots[0].child)
+            {
+                slot.entry = child.slots[0].entry;
+                slot.child = nullptr;
+            }
+            return;
+        }
+        trie.slots.erase(trie.slots.begin() + static_cast<std::ptrdiff_t>(index));
+        trie.bitmap &= ~bit;
+    }
+
+    if (trie.slots.empty()) { node = nullptr; }
+}
+
+void Map::collect(const Trie* node, Vector<const Entry*>& out)
+{
+    if (!node) { return; }
+    for (const Trie::Slot& slot : node->slots)
+    {
+        if (slot.child) { collect(slot.child.get(), out); }
+        else { out.push_back(&slot.entry); }
+    }
+}
+
+bool Map::next(size_t& position, NodeValue& key, NodeValue& value) const
+{
+    if (persistent) { return false; }
+
+    for (; position < entries.size(); position++)
+    {
+        const Entry& entry{entries[position]};
+        if (entry.key.is_nothing()) { continue; }
+
+        key = entry.key;
+        value = entry.value;
+        position++;
+        return true;
+    }
+    return false;
+}
+
+uint64_t Map::hash(const NodeValue& key)
+{
+    if (key.is_a<Numb>()) { return mix(static_cast<uint64_t>(key.as_numb())); }
+    if (key.is_a<String>()) { return std::hash<String>{}(key.as_text()); }
+    if (key.is_a<double>())
+    {
+        // 0.0 and -0.0 are equal keys
+        double real{key.as_real() == 0 ? 0.0 : key.as_real()};
+        uint64_t bits;
+        std::memcpy(&bits, &real, sizeof(bits));
+        return mix(bits);
+    }
+    if (key.is_a<bool>()) { return mix(key.as_bool() ? 1 : 2); }
+    if (key.is_a<char>()) { return mix(static_cast<unsigned char>(key.as_char()) + 3); }
+    if (key.is_a<BigInt>()) { return std::hash<String>{}(key.as_big().to_s()); }
+    if (key.is_a<ObjectRef>()) { return mix(reinterpret_cast<uintptr_t>(key.as_object().get())); }
+    return 0;
+}
+
+bool Map::same(const NodeValue& lhs, const NodeValue& rhs)
+{
+    if (lhs.is_a<Numb>()) { return rhs.is_a<Numb>() && lhs.as_numb() == rhs.as_numb(); }
+    if (lhs.is_a<String>()) { return rhs.is_a<String>() && lhs.as_text() == rhs.as_text(); }
+    if (lhs.type_index() != rhs.type_index()) { return false; }
+
+    if (lhs.is_a<double>())
+    {
+        // Unlike ==, a NaN key finds itself
+        double left{lhs.as_real()};
+        double right{rhs.as_real()};
+        return left == right || (left != left && right != right);
+    }
+    if (lhs.is_a<BigInt>()) { return lhs.as_big() == rhs.as_big(); }
+    if (lhs.is_a<ObjectRef>()) { return lhs.as_object() == rhs.as_object(); }
+    return (lhs == rhs).as_bool();
+}
+
+size_t Map::probe(const NodeValue& key, uint64_t key_hash) const
+{
+    if (count == 0) { return slots.size(); }
+
+    size_t mask{slots.size() - 1};
+    for (size_t slot{key_hash & mask};; slot = (slot + 1) & mask)
+    {
+        int32_t index{slots[slot]};
+        if (index == EMPTY) { return slots.size(); }
+        if (index >= 0 && entries[index].hash == key_hash && same(entries[index].key, key)) { return slot; }
+    }
+}
+
+void Map::rehash(size_t capacity)
+{
+    // The index is at most two thirds full, so every probe ends at an empty slot
+    size_t size{MIN_SLOTS};
+    while (size / 3 * 2 < capacity) { size *= 2; }
+    if (size > static_cast<size_t>(INT32_MAX)) { throw RuntimeError("Map too large"); }
+
+    Vector<Entry> compacted{};
+    compacted.reserve(size / 3 * 2);
+    for (Entry& entry : entries)
+    {
+        if (!entry.key.is_nothing()) { compacted.push_back(std::move(entry)); }
+    }
+    entries.swap(compacted);
+
+    slots.assign(size, EMPTY);
+    size_t mask{size - 1};
+    for (size_t i{0}; i < entries.size(); i++)
+    {
+        size_t slot{entries[i].hash & mask};
+        while (slots[slot] != EMPTY) { slot = (slot + 1) & mask; }
+        slots[slot] = static_cast<int32_t>(i);
+    }
+    count_memory();
+}
+
+void Map::count_memory()
+{
+    size_t now{entries.capacity() * sizeof(Entry) + slots.capacity() * sizeof(int32_t)};
+    if (now > bytes) { Budget::allocated(now - bytes); }
+    else { Budget::released(bytes - now); }
+    bytes = now;
+}
+
+} // namespace funk
@@ -0,0 +1,67 @@
+#include "runtime/Multiplexer.h"
+#include <thread>
+
+namespace funk
+{
+
+Multiplexer::Multiplexer(size_t threads, uint64_t slice) : threads(threads), slice(slice) {}
+
+void Multiplexer::add(Fiber::Body body)
+{
+    std::lock_guard<std::mutex> guard{lock};
+    waiting.push_back(std::make_unique<Fiber>(std::move(body)));
+}
+
+void Multiplexer::run()
+{
+    totals = &Stats::instance();
+
+    Vector<std::thread> started{};
+    for (size_t i{0}; i < threads; i++) { started.emplace_back(&Multiplexer::work, this); }
+    for (std::thread& thread : started) { thread.join(); }
+
+    if (error)
+    {
+        std::exception_ptr failed{error};
+        error = nullptr;
+        std::rethrow_exception(failed);
+    }
+}
+
+void Multiplexer::work()
+{
+    std::deque<std::unique_ptr<Fiber>> turns{};
+
+    while (true)
+    {
+        if (std::unique_ptr<Fiber> fiber = take()) { turns.push_back(std::move(fiber)); }
+        if (turns.empty()) { break; }
+
+        std::unique_ptr<Fiber> fiber{std::move(turns.front())};
+        turns.pop_front();
+        try
+        {
+            fiber->resume(slice);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            if (!error) { error = std::current_exception(); }
+        }
+        if (!fiber->is_done()) { turns.push_back(std::move(fiber)); }
+    }
+
+    std::lock_guard<std::mutex> guard{lock};
+    totals->merge(Stats::instance());
+}
+
+std::unique_ptr<Fiber> Multiplexer::take()
+{
+    std::lock_guard<std::mutex> guard{lock};
+    if (waiting.empty()) { return nullptr; }
+    std::unique_ptr<Fiber> fiber{std::move(waiting.front())};
+    waiting.pop_front();
+    return fiber;
+}
+
+} // namespace funk
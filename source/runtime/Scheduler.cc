@@ -0,0 +1,239 @@
+#include "runtime/Scheduler.h"
+
+namespace funk
+{
+
+static const size_t NO_QUEUE{static_cast<size_t>(-1)};
+static thread_local size_t own_queue{NO_QUEUE}; ///< Queue of the worker running on the thread, if any
+
+Scheduler::Scheduler() : workers(std::max(std::thread::hardware_concurrency(), 1u)) {}
+
+Scheduler::~Scheduler()
+{
+    // Workers only run at this point if the program exited without a shutdown, the process ends without them
+    for (std::thread& thread : threads) { thread.detach(); }
+}
+
+Scheduler& Scheduler::instance()
+{
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+void Scheduler::set_workers(size_t count)
+{
+    workers = std::max<size_t>(count, 1);
+}
+
+size_t Scheduler::get_workers() const
+{
+    return workers;
+}
+
+void Scheduler::start()
+{
+    std::lock_guard<std::mutex> guard{start_lock};
+    if (started.load(std::memory_order_acquire)) { return; }
+
+    for (size_t i{0}; i <= workers; i++) { queues.push_back(std::make_unique<Queue>()); }
+    running.store(workers, std::memory_order_relaxed);
+    for (size_t i{0}; i < workers; i++) { threads.emplace_back(&Scheduler::work, this, i, false); }
+    started.store(true, std::memory_order_release);
+}
+
+void Scheduler::compensate()
+{
+    if (pending.load(std::memory_order_acquire) == 0) { return; }
+    if (blocked.load(std::memory_order_acquire) < running.load(std::memory_order_acquire)) { return; }
+
+    std::lock_guard<std::mutex> guard{start_lock};
+    if (!started.load(std::memory_order_acquire)) { return; }
+    if (blocked.load(std::memory_order_acquire) < running.load(std::memory_order_acquire)) { return; }
+    if (extra.load(std::memory_order_acquire) >= MAX_EXTRA_WORKERS) { return; }
+
+    // Extra workers take their tasks from the shared queue
+    running.fetch_add(1, std::memory_order_release);
+    extra.fetch_add(1, std::memory_order_release);
+    std::thread{&Scheduler::work, this, queues.size() - 1, true}.detach();
+}
+
+void Scheduler::submit(const std::shared_ptr<Task>& task)
+{
+    if (!started.load(std::memory_order_acquire)) { start(); }
+
+    Queue& queue{*queues[own_queue < queues.size() ? own_queue : queues.size() - 1]};
+    {
+        std::lock_guard<std::mutex> guard{queue.lock};
+        queue.tasks.push_back(task);
+    }
+    pending.fetch_add(1, std::memory_order_release);
+    Stats::instance().task_spawned();
+    compensate();
+
+    // Taking the lock orders the increment before the check of an idle worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> guard{sleep_lock};
+    }
+    wake.notify_one();
+}
+
+std::shared_ptr<Task> Scheduler::take()
+{
+    if (!started.load(std::memory_order_acquire) || pending.load(std::memory_order_acquire) == 0) { return nullptr; }
+
+    // Threads that are not workers share the last queue
+    size_t count{queues.size()};
+    size_t own{own_queue < count ? own_queue : count - 1};
+
+    {
+        Queue& queue{*queues[own]};
+        std::lock_guard<std::mutex> guard{queue.lock};
+        if (!queue.tasks.empty())
+        {
+            std::shared_ptr<Task> task{std::move(queue.tasks.back())};
+            queue.tasks.pop_back();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    for (size_t i{1}; i < count; i++)
+    {
+        Queue& queue{*queues[(own + i) % count]};
+        std::lock_guard<std::mutex> guard{queue.lock};
+        if (!queue.tasks.empty())
+        {
+            std::shared_ptr<Task> task{std::move(queue.tasks.front())};
+            queue.tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            Stats::instance().task_stolen();
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+void Scheduler::wait(Task& task)
+{
+    // Running the task here costs no more than a call, its entry in the queue is skipped by the workers
+    if (task.claim())
+    {
+        task.run();
+        return;
+    }
+
+    if (task.is_done()) { return; }
+    blocking();
+    task.wait();
+    unblocked();
+}
+
+bool Scheduler::has_idle_worker() const
+{
+    if (!started.load(std::memory_order_acquire)) { return true; }
+    return pending.load(std::memory_order_relaxed) < idle.load(std::memory_order_relaxed);
+}
+
+void Scheduler::blocking()
+{
+    // Only workers run queued tasks, other threads can block without leaving tasks behind
+    if (own_queue == NO_QUEUE) { return; }
+    blocked.fetch_add(1, std::memory_order_acq_rel);
+    compensate();
+}
+
+void Scheduler::unblocked()
+{
+    if (own_queue == NO_QUEUE) { return; }
+    blocked.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void Scheduler::work(size_t index, bool is_extra)
+{
+    own_queue = index;
+
+    while (true)
+    {
+        if (std::shared_ptr<Task> task = take())
+        {
+            if (task->claim()) { task->run(); }
+            continue;
+        }
+        if (is_extra) { break; }
+
+        std::unique_lock<std::mutex> guard{sleep_lock};
+        idle.fetch_add(1, std::memory_order_relaxed);
+        wake.wait(guard, [this] { return pending.load(std::memory_order_acquire) > 0 || stopping; });
+        idle.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping && pending.load(std::memory_order_acquire) == 0) { break; }
+    }
+
+    if (!is_extra)
+    {
+        std::lock_guard<std::mutex> guard{sleep_lock};
+        totals->merge(Stats::instance());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{sleep_lock};
+        if (retired_stats) { retired_stats->merge(Stats::instance()); }
+        else { retired_stats = std::make_unique<Stats>(Stats::instance()); }
+        running.fetch_sub(1, std::memory_order_acq_rel);
+        extra.fetch_sub(1, std::memory_order_acq_rel);
+        retired.notify_all();
+    }
+
+    // A task queued after the last take() may have found this worker running and started no other one
+    compensate();
+}
+
+void Scheduler::shutdown()
+{
+    if (!started.load(std::memory_order_acquire)) { return; }
+
+    // Tasks that were never awaited still run before the program ends
+    while (std::shared_ptr<Task> task = take())
+    {
+        if (task->claim()) { task->run(); }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{sleep_lock};
+        stopping = true;
+        totals = &Stats::instance();
+    }
+    wake.notify_all();
+
+    Vector<std::thread> stopped{};
+    {
+        std::lock_guard<std::mutex> guard{start_lock};
+        stopped.swap(threads);
+    }
+    for (std::thread& thread : stopped) { thread.join(); }
+
+    // Extra workers that exit may still start others on their way out
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard{sleep_lock};
+            retired.wait(guard, [this] { return extra.load(std::memory_order_acquire) == 0; });
+            if (retired_stats)
+            {
+                totals->merge(*retired_stats);
+                retired_stats.reset();
+            }
+        }
+
+        std::lock_guard<std::mutex> guard{start_lock};
+        if (extra.load(std::memory_order_acquire) > 0) { continue; }
+        queues.clear();
+        running.store(0, std::memory_order_relaxed);
+        stopping = false;
+        started.store(false, std::memory_order_release);
+        break;
+    }
+}
+
+} // namespace funk
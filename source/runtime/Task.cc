@@ -0,0 +1,97 @@
+#include "runtime/Task.h"
+#include "ast/expression/CallNode.h"
+#include "io/Reader.h"
+#include "io/Writer.h"
+#include "parser/Registry.h"
+#include "runtime/Budget.h"
+#include "runtime/TaskGroup.h"
+
+namespace funk
+{
+
+Task::Task(const ExpressionNode* expression) :
+    expression(expression), registry(&Registry::instance()), budget(Budget::get_current()), reader(&Reader::in()),
+    writer(&Writer::out()), group(TaskGroup::get_current())
+{
+    scope.capture(captured);
+    if (group) { group->add(); }
+}
+
+Task::Task(std::unique_ptr<ExpressionNode> expression) :
+    expression(expression.get()), owned(std::move(expression)), registry(&Registry::instance()),
+    budget(Budget::get_current()), reader(&Reader::in()), writer(&Writer::out()), group(TaskGroup::get_current())
+{
+    scope.push();
+    if (group) { group->add(); }
+}
+
+Task::~Task()
+{
+    // A task that ran left its group when it finished
+    if (group && !claimed.load(std::memory_order_acquire)) { group->finish(); }
+    scope.pop();
+    for (Node* node : captured) { delete node; }
+}
+
+String Task::to_s() const
+{
+    return is_done() ? "<task done>" : "<task>";
+}
+
+void Task::run()
+{
+    Scope* previous{Scope::enter(&scope)};
+    Registry* previous_registry{Registry::enter(registry)};
+    Budget* previous_budget{Budget::enter(budget)};
+    Reader* previous_reader{Reader::enter(reader)};
+    Writer* previous_writer{Writer::enter(writer)};
+    TaskGroup* previous_group{TaskGroup::enter(group)};
+    int depth{scope.get_depth()};
+
+    try
+    {
+        // Functions without a return value are spawned for their effects, their tasks give none
+        if (auto call = node_cast<CallNode>(expression))
+        {
+            auto value = node_cast<ExpressionNode>(call->evaluate());
+            result = value ? value->get_value() : NodeValue{};
+        }
+        else { result = expression->get_value(); }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+        // Scopes pushed by the failed evaluation are left behind by the nodes that threw
+        while (scope.get_depth() > depth) { scope.pop(); }
+    }
+
+    Scope::enter(previous);
+    Registry::enter(previous_registry);
+    Budget::enter(previous_budget);
+    Reader::enter(previous_reader);
+    Writer::enter(previous_writer);
+    TaskGroup::enter(previous_group);
+
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        done.store(true, std::memory_order_release);
+    }
+    finished.notify_all();
+
+    // Last, the run that spawned the task may delete its context once its group is empty
+    if (group) { group->finish(); }
+}
+
+void Task::wait() const
+{
+    std::unique_lock<std::mutex> guard{lock};
+    finished.wait(guard, [this] { return is_done(); });
+}
+
+NodeValue Task::get_result() const
+{
+    if (error) { std::rethrow_exception(error); }
+    return result;
+}
+
+} // namespace funk
@@ -0,0 +1,34 @@
+#include "runtime/TaskGroup.h"
+
+namespace funk
+{
+
+thread_local TaskGroup* TaskGroup::current{nullptr};
+
+TaskGroup* TaskGroup::enter(TaskGroup* group)
+{
+    TaskGroup* previous{current};
+    current = group;
+    return previous;
+}
+
+void TaskGroup::add()
+{
+    std::lock_guard<std::mutex> guard{lock};
+    unfinished++;
+}
+
+void TaskGroup::finish()
+{
+    // Notified under the lock, the group may be deleted as soon as a waiter sees the count drop to zero
+    std::lock_guard<std::mutex> guard{lock};
+    if (--unfinished == 0) { finished.notify_all(); }
+}
+
+void TaskGroup::wait()
+{
+    std::unique_lock<std::mutex> guard{lock};
+    finished.wait(guard, [this] { return unfinished == 0; });
+}
+
+} // namespace funk
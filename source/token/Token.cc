@@ -37,7 +37,7 @@ String Token::get_value_str() const
 {
     std::ostringstream oss;
 
-    if (std::holds_alternative<int>(value)) { oss << std::get<int>(value); }
+    if (std::holds_alternative<Numb>(value)) { oss << std::get<Numb>(value); }
     else if (std::holds_alternative<double>(value)) { oss << std::get<double>(value); }
     else if (std::holds_alternative<bool>(value)) { oss << (std::get<bool>(value) ? "true" : "false"); }
     else if (std::holds_alternative<char>(value)) { oss << "'" << std::get<char>(value) << "'"; }
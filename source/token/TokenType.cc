@@ -17,18 +17,29 @@ String token_type_to_s(TokenType token)
     case TokenType::CASE: return "CASE";
     case TokenType::NONE: return "NONE";
     case TokenType::RETURN: return "RETURN";
+    case TokenType::SPAWN: return "SPAWN";
+    case TokenType::AWAIT: return "AWAIT";
+    case TokenType::YIELD: return "YIELD";
 
     case TokenType::NUMB: return "NUMB";
     case TokenType::REAL: return "REAL";
     case TokenType::BOOL: return "BOOL";
     case TokenType::CHAR: return "CHAR";
     case TokenType::TEXT: return "TEXT";
+    case TokenType::TASK: return "TASK";
+    case TokenType::CHANNEL: return "CHANNEL";
+    case TokenType::GENERATOR: return "GENERATOR";
+    case TokenType::MAP: return "MAP";
 
     case TokenType::NUMB_TYPE: return "NUMB_TYPE";
     case TokenType::REAL_TYPE: return "REAL_TYPE";
     case TokenType::BOOL_TYPE: return "BOOL_TYPE";
     case TokenType::CHAR_TYPE: return "CHAR_TYPE";
     case TokenType::TEXT_TYPE: return "TEXT_TYPE";
+    case TokenType::TASK_TYPE: return "TASK_TYPE";
+    case TokenType::CHANNEL_TYPE: return "CHANNEL_TYPE";
+    case TokenType::GENERATOR_TYPE: return "GENERATOR_TYPE";
+    case TokenType::MAP_TYPE: return "MAP_TYPE";
 
     case TokenType::IDENTIFIER: return "IDENTIFIER";
 
@@ -91,6 +102,24 @@ TokenType type_token_to_value_token(TokenType token)
     case TokenType::BOOL_TYPE: return TokenType::BOOL;
     case TokenType::CHAR_TYPE: return TokenType::CHAR;
     case TokenType::TEXT_TYPE: return TokenType::TEXT;
+    case TokenType::TASK_TYPE: return TokenType::TASK;
+    case TokenType::CHANNEL_TYPE: return TokenType::CHANNEL;
+    case TokenType::GENERATOR_TYPE: return TokenType::GENERATOR;
+    case TokenType::MAP_TYPE: return TokenType::MAP;
+    default: return token;
+    }
+}
+
+TokenType compound_assign_to_operator(TokenType token)
+{
+    switch (token)
+    {
+    case TokenType::PLUS_ASSIGN: return TokenType::PLUS;
+    case TokenType::MINUS_ASSIGN: return TokenType::MINUS;
+    case TokenType::MULTIPLY_ASSIGN: return TokenType::MULTIPLY;
+    case TokenType::DIVIDE_ASSIGN: return TokenType::DIVIDE;
+    case TokenType::MODULO_ASSIGN: return TokenType::MODULO;
+    case TokenType::POWER_ASSIGN: return TokenType::POWER;
     default: return token;
     }
 }
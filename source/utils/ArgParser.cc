@@ -3,7 +3,7 @@
 namespace funk
 {
 
-ArgParser::ArgParser(int argc, char* argv[])
+ArgParser::ArgParser(int argc, char* argv[], const Vector<String>& valued)
 {
     for (int i{1}; i < argc; ++i)
     {
@@ -15,7 +15,15 @@ ArgParser::ArgParser(int argc, char* argv[])
             continue;
         }
 
-        if (arg.substr(0, 2) == "--")
+        // Short options like -O2 are stored as they are, unless they take a value like -j 4
+        if (arg.size() > 1 && arg[0] == '-' && arg[1] != '-')
+        {
+            String option{arg.substr(0, 2)};
+            if (std::find(valued.begin(), valued.end(), option) == valued.end()) { options[arg] = ""; }
+            else if (arg.size() > 2) { options[option] = arg.substr(2); }
+            else { options[option] = i + 1 < argc ? argv[++i] : ""; }
+        }
+        else if (arg.substr(0, 2) == "--")
         {
             size_t eq_pos = arg.find('=');
             if (eq_pos != String::npos) { options[arg.substr(0, eq_pos)] = arg.substr(eq_pos + 1); }
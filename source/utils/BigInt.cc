@@ -0,0 +1,260 @@
+#include "utils/BigInt.h"
+
+#include <limits>
+
+namespace funk
+{
+
+BigInt::BigInt(Numb value) : negative(value < 0)
+{
+    // Negating the smallest numb overflows, the magnitude is computed unsigned
+    uint64_t magnitude{value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value)};
+    while (magnitude != 0)
+    {
+        limbs.push_back(static_cast<uint32_t>(magnitude));
+        magnitude >>= 32;
+    }
+}
+
+void BigInt::trim()
+{
+    while (!limbs.empty() && limbs.back() == 0) { limbs.pop_back(); }
+    if (limbs.empty()) { negative = false; }
+}
+
+bool BigInt::fits_numb() const
+{
+    if (limbs.size() > 2) { return false; }
+
+    uint64_t magnitude{0};
+    for (size_t i{limbs.size()}; i > 0; i--) { magnitude = (magnitude << 32) | limbs[i - 1]; }
+
+    uint64_t limit{static_cast<uint64_t>(std::numeric_limits<Numb>::max())};
+    return magnitude <= limit || (negative && magnitude == limit + 1);
+}
+
+Numb BigInt::to_numb() const
+{
+    uint64_t magnitude{0};
+    for (size_t i{limbs.size()}; i > 0; i--) { magnitude = (magnitude << 32) | limbs[i - 1]; }
+    return static_cast<Numb>(negative ? 0 - magnitude : magnitude);
+}
+
+double BigInt::to_double() const
+{
+    double value{0.0};
+    for (size_t i{limbs.size()}; i > 0; i--) { value = value * 4294967296.0 + limbs[i - 1]; }
+    return negative ? -value : value;
+}
+
+String BigInt::to_s() const
+{
+    if (limbs.empty()) { return "0"; }
+
+    // Split off nine decimal digits at a time
+    Vector<uint32_t> magnitude{limbs};
+    Vector<uint32_t> chunks{};
+    while (!magnitude.empty())
+    {
+        uint64_t remainder{0};
+        for (size_t i{magnitude.size()}; i > 0; i--)
+        {
+            uint64_t current{(remainder << 32) | magnitude[i - 1]};
+            magnitude[i - 1] = static_cast<uint32_t>(current / 1000000000);
+            remainder = current % 1000000000;
+        }
+        chunks.push_back(static_cast<uint32_t>(remainder));
+        while (!magnitude.empty() && magnitude.back() == 0) { magnitude.pop_back(); }
+    }
+
+    std::ostringstream out;
+    if (negative) { out << '-'; }
+    out << chunks.back();
+    for (size_t i{chunks.size() - 1}; i > 0; i--) { out << std::setw(9) << std::setfill('0') << chunks[i - 1]; }
+    return out.str();
+}
+
+int BigInt::compare_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs)
+{
+    if (lhs.size() != rhs.size()) { return lhs.size() < rhs.size() ? -1 : 1; }
+    for (size_t i{lhs.size()}; i > 0; i--)
+    {
+        if (lhs[i - 1] != rhs[i - 1]) { return lhs[i - 1] < rhs[i - 1] ? -1 : 1; }
+    }
+    return 0;
+}
+
+int BigInt::compare(const BigInt& lhs, const BigInt& rhs)
+{
+    if (lhs.negative != rhs.negative) { return lhs.negative ? -1 : 1; }
+    int magnitude{compare_magnitude(lhs.limbs, rhs.limbs)};
+    return lhs.negative ? -magnitude : magnitude;
+}
+
+Vector<uint32_t> BigInt::add_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs)
+{
+    Vector<uint32_t> sum{};
+    uint64_t carry{0};
+    for (size_t i{0}; i < std::max(lhs.size(), rhs.size()); i++)
+    {
+        uint64_t current{carry};
+        if (i < lhs.size()) { current += lhs[i]; }
+        if (i < rhs.size()) { current += rhs[i]; }
+        sum.push_back(static_cast<uint32_t>(current));
+        carry = current >> 32;
+    }
+    if (carry != 0) { sum.push_back(static_cast<uint32_t>(carry)); }
+    return sum;
+}
+
+Vector<uint32_t> BigInt::subtract_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs)
+{
+    Vector<uint32_t> difference{};
+    int64_t borrow{0};
+    for (size_t i{0}; i < lhs.size(); i++)
+    {
+        int64_t current{static_cast<int64_t>(lhs[i]) - borrow - (i < rhs.size() ? rhs[i] : 0)};
+        borrow = current < 0 ? 1 : 0;
+        difference.push_back(static_cast<uint32_t>(current + (borrow << 32)));
+    }
+    return difference;
+}
+
+void BigInt::divide_magnitude(const Vector<uint32_t>& lhs, const Vector<uint32_t>& rhs, Vector<uint32_t>& quotient,
+    Vector<uint32_t>& remainder)
+{
+    quotient.assign(lhs.size(), 0);
+    remainder.clear();
+
+    if (rhs.size() == 1)
+    {
+        uint64_t rest{0};
+        for (size_t i{lhs.size()}; i > 0; i--)
+        {
+            uint64_t current{(rest << 32) | lhs[i - 1]};
+            quotient[i - 1] = static_cast<uint32_t>(current / rhs[0]);
+            rest = current % rhs[0];
+        }
+        if (rest != 0) { remainder.push_back(static_cast<uint32_t>(rest)); }
+        return;
+    }
+
+    // Shift and subtract one bit at a time
+    for (size_t bit{lhs.size() * 32}; bit > 0; bit--)
+    {
+        uint32_t carry{(lhs[(bit - 1) / 32] >> ((bit - 1) % 32)) & 1};
+        for (uint32_t& limb : remainder)
+        {
+            uint32_t next{limb >> 31};
+            limb = (limb << 1) | carry;
+            carry = next;
+        }
+        if (carry != 0) { remainder.push_back(carry); }
+
+        if (compare_magnitude(remainder, rhs) >= 0)
+        {
+            remainder = subtract_magnitude(remainder, rhs);
+            while (!remainder.empty() && remainder.back() == 0) { remainder.pop_back(); }
+            quotient[(bit - 1) / 32] |= 1u << ((bit - 1) % 32);
+        }
+    }
+}
+
+BigInt BigInt::add(const BigInt& lhs, const BigInt& rhs, bool subtract)
+{
+    bool rhs_negative{subtract ? !rhs.negative : rhs.negative};
+    BigInt result{};
+
+    if (lhs.negative == rhs_negative)
+    {
+        result.limbs = add_magnitude(lhs.limbs, rhs.limbs);
+        result.negative = lhs.negative;
+    }
+    else if (compare_magnitude(lhs.limbs, rhs.limbs) >= 0)
+    {
+        result.limbs = subtract_magnitude(lhs.limbs, rhs.limbs);
+        result.negative = lhs.negative;
+    }
+    else
+    {
+        result.limbs = subtract_magnitude(rhs.limbs, lhs.limbs);
+        result.negative = rhs_negative;
+    }
+
+    result.trim();
+    return result;
+}
+
+BigInt BigInt::operator-() const
+{
+    BigInt result{*this};
+    if (!result.limbs.empty()) { result.negative = !result.negative; }
+    return result;
+}
+
+BigInt operator+(const BigInt& lhs, const BigInt& rhs)
+{
+    return BigInt::add(lhs, rhs, false);
+}
+
+BigInt operator-(const BigInt& lhs, const BigInt& rhs)
+{
+    return BigInt::add(lhs, rhs, true);
+}
+
+BigInt operator*(const BigInt& lhs, const BigInt& rhs)
+{
+    BigInt result{};
+    result.limbs.assign(lhs.limbs.size() + rhs.limbs.size(), 0);
+
+    for (size_t i{0}; i < lhs.limbs.size(); i++)
+    {
+        uint64_t carry{0};
+        for (size_t j{0}; j < rhs.limbs.size(); j++)
+        {
+            uint64_t current{static_cast<uint64_t>(lhs.limbs[i]) * rhs.limbs[j] + result.limbs[i + j] + carry};
+            result.limbs[i + j] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        result.limbs[i + rhs.limbs.size()] = static_cast<uint32_t>(carry);
+    }
+
+    result.negative = lhs.negative != rhs.negative;
+    result.trim();
+    return result;
+}
+
+BigInt operator/(const BigInt& lhs, const BigInt& rhs)
+{
+    BigInt quotient{};
+    Vector<uint32_t> remainder{};
+    BigInt::divide_magnitude(lhs.limbs, rhs.limbs, quotient.limbs, remainder);
+    quotient.negative = lhs.negative != rhs.negative;
+    quotient.trim();
+    return quotient;
+}
+
+BigInt operator%(const BigInt& lhs, const BigInt& rhs)
+{
+    Vector<uint32_t> quotient{};
+    BigInt remainder{};
+    BigInt::divide_magnitude(lhs.limbs, rhs.limbs, quotient, remainder.limbs);
+    remainder.negative = lhs.negative;
+    remainder.trim();
+    return remainder;
+}
+
+BigInt BigInt::pow(const BigInt& base, Numb exponent)
+{
+    BigInt result{1};
+    BigInt square{base};
+    while (exponent > 0)
+    {
+        if (exponent & 1) { result = result * square; }
+        exponent >>= 1;
+        if (exponent > 0) { square = square * square; }
+    }
+    return result;
+}
+
+} // namespace funk
@@ -0,0 +1,100 @@
+#include "utils/Stats.h"
+
+namespace funk
+{
+
+void Stats::reset()
+{
+    *this = Stats{};
+}
+
+void Stats::merge(const Stats& other)
+{
+    for (size_t i{0}; i < nodes_evaluated.size(); i++) { nodes_evaluated[i] += other.nodes_evaluated[i]; }
+    scope_pushes += other.scope_pushes;
+    scope_pops += other.scope_pops;
+    max_scope_depth = std::max(max_scope_depth, other.max_scope_depth);
+    scope_gets += other.scope_gets;
+    scope_chain_walked += other.scope_chain_walked;
+    registry_lookups += other.registry_lookups;
+    overloads_scanned += other.overloads_scanned;
+    pattern_matches += other.pattern_matches;
+    nodes_allocated += other.nodes_allocated;
+    specializations += other.specializations;
+    deoptimizations += other.deoptimizations;
+    tasks_spawned += other.tasks_spawned;
+    tasks_stolen += other.tasks_stolen;
+    preemptions += other.preemptions;
+}
+
+double Stats::average_chain() const
+{
+    if (scope_gets == 0) { return 0.0; }
+    return static_cast<double>(scope_chain_walked) / static_cast<double>(scope_gets);
+}
+
+String Stats::to_s() const
+{
+    std::ostringstream out;
+    uint64_t total{0};
+    for (uint64_t count : nodes_evaluated) { total += count; }
+
+    out << "Runtime statistics:\n";
+    out << "  Nodes evaluated:      " << total << "\n";
+    for (size_t i{0}; i < nodes_evaluated.size(); i++)
+    {
+        if (nodes_evaluated[i] == 0) { continue; }
+        out << "    " << std::left << std::setw(18) << node_kind_to_s(static_cast<NodeKind>(i)) << nodes_evaluated[i]
+            << "\n";
+    }
+    out << "  Scope pushes:         " << scope_pushes << "\n";
+    out << "  Scope pops:           " << scope_pops << "\n";
+    out << "  Max scope depth:      " << max_scope_depth << "\n";
+    out << "  Scope lookups:        " << scope_gets << "\n";
+    out << "  Avg chain walked:     " << std::fixed << std::setprecision(2) << average_chain() << "\n";
+    out << "  Function lookups:     " << registry_lookups << "\n";
+    out << "  Overloads scanned:    " << overloads_scanned << "\n";
+    out << "  Pattern matches:      " << pattern_matches << "\n";
+    out << "  Nodes allocated:      " << nodes_allocated << "\n";
+    out << "  Specializations:      " << specializations << "\n";
+    out << "  Deoptimizations:      " << deoptimizations << "\n";
+    out << "  Tasks spawned:        " << tasks_spawned << "\n";
+    out << "  Tasks stolen:         " << tasks_stolen << "\n";
+    out << "  Preemptions:          " << preemptions << "\n";
+
+    return out.str();
+}
+
+String Stats::to_json() const
+{
+    std::ostringstream out;
+
+    out << "{\n  \"nodes_evaluated\": {";
+    bool first{true};
+    for (size_t i{0}; i < nodes_evaluated.size(); i++)
+    {
+        out << (first ? "" : ",") << "\n    \"" << node_kind_to_s(static_cast<NodeKind>(i))
+            << "\": " << nodes_evaluated[i];
+        first = false;
+    }
+    out << "\n  },\n";
+    out << "  \"scope_pushes\": " << scope_pushes << ",\n";
+    out << "  \"scope_pops\": " << scope_pops << ",\n";
+    out << "  \"max_scope_depth\": " << max_scope_depth << ",\n";
+    out << "  \"scope_gets\": " << scope_gets << ",\n";
+    out << "  \"scope_avg_chain\": " << std::fixed << std::setprecision(4) << average_chain() << ",\n";
+    out << "  \"registry_lookups\": " << registry_lookups << ",\n";
+    out << "  \"overloads_scanned\": " << overloads_scanned << ",\n";
+    out << "  \"pattern_matches\": " << pattern_matches << ",\n";
+    out << "  \"nodes_allocated\": " << nodes_allocated << ",\n";
+    out << "  \"specializations\": " << specializations << ",\n";
+    out << "  \"deoptimizations\": " << deoptimizations << ",\n";
+    out << "  \"tasks_spawned\": " << tasks_spawned << ",\n";
+    out << "  \"tasks_stolen\": " << tasks_stolen << ",\n";
+    out << "  \"preemptions\": " << preemptions << "\n";
+    out << "}\n";
+
+    return out.str();
+}
+
+} // namespace funk
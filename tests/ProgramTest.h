@@ -0,0 +1,83 @@
+/**
+ * @file ProgramTest.h
+ * @brief Defines the ProgramTest fixture for tests that run Funk programs.
+ */
+#pragma once
+
+#include "ast/BlockNode.h"
+#include "lexer/Lexer.h"
+#include "parser/Parser.h"
+#include "parser/Registry.h"
+#include "parser/Scope.h"
+#include "runtime/Scheduler.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+namespace funk
+{
+
+/**
+ * @brief Fixture that runs programs on the scope stack and registry of the test thread.
+ * Every program of a test runs in the same scope, so later programs see the variables of earlier ones. The programs
+ * are kept until the end of the test, when the tasks they spawned have finished and their functions are forgotten.
+ */
+class ProgramTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Scope::instance().push();
+    }
+
+    void TearDown() override
+    {
+        Scheduler::instance().shutdown();
+        Scope::instance().pop();
+        for (Node* ast : trees)
+        {
+            // The registry outlives the test, forget the functions before they are deleted
+            for (Node* statement : static_cast<BlockNode*>(ast)->get_statements())
+            {
+                if (auto function = node_cast<FunctionNode>(statement))
+                {
+                    Registry::instance().remove_function(function->get_identifier());
+                }
+            }
+            delete ast;
+        }
+        trees.clear();
+    }
+
+    /**
+     * @brief Parses and evaluates a program, keeping it until the end of the test.
+     */
+    void evaluate(const String& source)
+    {
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        auto ast = static_cast<BlockNode*>(parser.parse());
+        trees.push_back(ast);
+        ast->evaluate_same_scope();
+    }
+
+    /**
+     * @brief Runs a program and returns the value of one of its variables.
+     */
+    NodeValue run(const String& source, const String& name)
+    {
+        evaluate(source);
+        return get(name);
+    }
+
+    /**
+     * @brief Gets the value of a variable of the programs run so far.
+     */
+    static NodeValue get(const String& name)
+    {
+        return static_cast<ExpressionNode*>(Scope::instance().get(name))->get_value();
+    }
+
+    Vector<Node*> trees{}; ///< Programs run by the test
+};
+
+} // namespace funk
@@ -0,0 +1,71 @@
+#include "utils/BigInt.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+#include <limits>
+
+using namespace funk;
+
+class TestBigInt : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        // Cleanup code if needed
+    }
+
+    BigInt two_to_100{BigInt::pow(BigInt{2}, 100)};
+};
+
+TEST_F(TestBigInt, Formatting)
+{
+    ASSERT_EQ(BigInt{}.to_s(), "0");
+    ASSERT_EQ(BigInt{-42}.to_s(), "-42");
+    ASSERT_EQ(two_to_100.to_s(), "1267650600228229401496703205376");
+    ASSERT_EQ((-two_to_100).to_s(), "-1267650600228229401496703205376");
+    ASSERT_EQ(BigInt{1000000000}.to_s(), "1000000000");
+}
+
+TEST_F(TestBigInt, FitsNumb)
+{
+    Numb max{std::numeric_limits<Numb>::max()};
+    Numb min{std::numeric_limits<Numb>::min()};
+    ASSERT_TRUE(BigInt{max}.fits_numb());
+    ASSERT_TRUE(BigInt{min}.fits_numb());
+    ASSERT_EQ(BigInt{min}.to_numb(), min);
+    ASSERT_FALSE((BigInt{max} + BigInt{1}).fits_numb());
+    ASSERT_FALSE((BigInt{min} - BigInt{1}).fits_numb());
+    ASSERT_EQ((BigInt{max} + BigInt{1} - BigInt{1}).to_numb(), max);
+}
+
+TEST_F(TestBigInt, Arithmetic)
+{
+    ASSERT_EQ((two_to_100 * two_to_100 / two_to_100), two_to_100);
+    ASSERT_EQ((two_to_100 / BigInt{3}).to_s(), "422550200076076467165567735125");
+    ASSERT_EQ((two_to_100 % BigInt{7}).to_s(), "2");
+    ASSERT_EQ((two_to_100 + BigInt{-1} - two_to_100).to_s(), "-1");
+    ASSERT_TRUE((two_to_100 - two_to_100).is_zero());
+
+    // Division truncates towards zero like numb division
+    BigInt big_divisor{BigInt::pow(BigInt{10}, 20)};
+    ASSERT_EQ((-two_to_100 / big_divisor).to_s(), "-12676506002");
+    ASSERT_EQ((-two_to_100 % big_divisor).to_s(), "-28229401496703205376");
+}
+
+TEST_F(TestBigInt, Comparison)
+{
+    ASSERT_TRUE(two_to_100 > BigInt{std::numeric_limits<Numb>::max()});
+    ASSERT_TRUE(-two_to_100 < BigInt{std::numeric_limits<Numb>::min()});
+    ASSERT_TRUE(BigInt{-1} < BigInt{});
+    ASSERT_EQ(BigInt::compare(two_to_100, two_to_100), 0);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
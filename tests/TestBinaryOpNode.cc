@@ -45,8 +45,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 8);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 8);
     }
 
     // Subtraction
@@ -57,8 +57,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 6);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 6);
     }
 
     // Multiplication
@@ -69,8 +69,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 30);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 30);
     }
 
     // Division
@@ -81,8 +81,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 5);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 5);
     }
 
     // Modulo
@@ -93,8 +93,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 2);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 2);
     }
 
     // Power
@@ -105,8 +105,8 @@ TEST_F(TestBinaryOpNode, ArithmeticOperations)
         BinaryOpNode node(left, op, right);
 
         NodeValue result = node.get_value();
-        ASSERT_TRUE(result.is_a<int>());
-        ASSERT_EQ(result.get<int>(), 8);
+        ASSERT_TRUE(result.is_a<Numb>());
+        ASSERT_EQ(result.get<Numb>(), 8);
     }
 }
 
@@ -283,7 +283,7 @@ TEST_F(TestBinaryOpNode, Evaluate)
     // After evaluation, result should be a LiteralNode
     LiteralNode* literal_result = dynamic_cast<LiteralNode*>(result);
     ASSERT_NE(literal_result, nullptr);
-    ASSERT_EQ(literal_result->get_value().get<int>(), 4);
+    ASSERT_EQ(literal_result->get_value().get<Numb>(), 4);
 }
 
 TEST_F(TestBinaryOpNode, NestedOperations)
@@ -300,8 +300,55 @@ TEST_F(TestBinaryOpNode, NestedOperations)
     BinaryOpNode multiplication(addition, mult_op, two);
 
     NodeValue result = multiplication.get_value();
-    ASSERT_TRUE(result.is_a<int>());
-    ASSERT_EQ(result.get<int>(), 16);
+    ASSERT_TRUE(result.is_a<Numb>());
+    ASSERT_EQ(result.get<Numb>(), 16);
+}
+
+TEST_F(TestBinaryOpNode, SpecializesOnOperandTypes)
+{
+    BinaryOpNode numbs(new LiteralNode(loc, 7), Token(loc, "/", TokenType::DIVIDE), new LiteralNode(loc, 2));
+    ASSERT_EQ(numbs.get_specialization(), BinaryOpNode::Specialization::UNSPECIALIZED);
+    ASSERT_EQ(numbs.get_value().get<Numb>(), 3);
+    ASSERT_EQ(numbs.get_specialization(), BinaryOpNode::Specialization::NUMB_NUMB);
+
+    BinaryOpNode texts(new LiteralNode(loc, String("a")), Token(loc, "+", TokenType::PLUS),
+        new LiteralNode(loc, String("b")));
+    ASSERT_EQ(texts.get_value().get<String>(), "ab");
+    ASSERT_EQ(texts.get_specialization(), BinaryOpNode::Specialization::TEXT_TEXT);
+
+    // Reals have no modulo, the error comes from the generic operator
+    BinaryOpNode reals(new LiteralNode(loc, 1.5), Token(loc, "%", TokenType::MODULO), new LiteralNode(loc, 2.0));
+    ASSERT_THROW(reals.get_value(), TypeError);
+    ASSERT_EQ(reals.get_specialization(), BinaryOpNode::Specialization::GENERIC);
+}
+
+TEST_F(TestBinaryOpNode, FallsBackWhenOperandTypesChange)
+{
+    LiteralNode* right = new LiteralNode(loc, 2);
+    BinaryOpNode node(new LiteralNode(loc, 1), Token(loc, "+", TokenType::PLUS), right);
+    ASSERT_EQ(node.get_value().get<Numb>(), 3);
+
+    right->set_value(0.5);
+    NodeValue result = node.get_value();
+    ASSERT_TRUE(result.is_a<double>());
+    ASSERT_EQ(result.get<double>(), 1.5);
+    ASSERT_EQ(node.get_specialization(), BinaryOpNode::Specialization::GENERIC);
+}
+
+TEST_F(TestBinaryOpNode, SpecializedErrorsMatchGenericErrors)
+{
+    BinaryOpNode node(new LiteralNode(loc, 1), Token(loc, "%", TokenType::MODULO), new LiteralNode(loc, 0));
+    ASSERT_THROW(node.get_value(), RuntimeError);
+    ASSERT_EQ(node.get_specialization(), BinaryOpNode::Specialization::NUMB_NUMB);
+    try
+    {
+        node.get_value();
+        FAIL();
+    }
+    catch (const RuntimeError& e)
+    {
+        ASSERT_NE(String(e.what()).find("Modulo by zero"), String::npos);
+    }
 }
 
 int main(int argc, char** argv)
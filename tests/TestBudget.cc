@@ -0,0 +1,98 @@
+#include "ProgramTest.h"
+#include "runtime/Budget.h"
+#include "runtime/Scheduler.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestBudget : public ProgramTest
+{
+protected:
+    void TearDown() override
+    {
+        Budget::enter(nullptr);
+        ProgramTest::TearDown();
+    }
+
+    /**
+     * @brief Runs a program with a budget and returns the message of the error it failed with.
+     */
+    String fail(const String& source, const Budget::Limits& limits)
+    {
+        Budget budget{limits};
+        Budget::enter(&budget);
+        String message{};
+        try
+        {
+            evaluate(source);
+        }
+        catch (const RuntimeError& e)
+        {
+            message = e.what();
+        }
+        Scheduler::instance().shutdown();
+        Budget::enter(nullptr);
+        return message;
+    }
+};
+
+const String FOREVER{"mut numb i = 0;\nwhile (true) { i += 1; }\n"};
+
+TEST_F(TestBudget, StepLimitStopsLoop)
+{
+    Budget::Limits limits{};
+    limits.steps = 5000;
+    String message{fail(FOREVER, limits)};
+    ASSERT_NE(message.find("Step limit of 5000 exceeded after"), String::npos) << message;
+}
+
+TEST_F(TestBudget, StepsOfCallsCount)
+{
+    Budget::Limits limits{};
+    limits.steps = 10000;
+    String message{fail("funk f = (numb n) { return n; };\nmut numb i = 0;\nwhile (true) { i = f(i); }\n", limits)};
+    ASSERT_NE(message.find("Step limit"), String::npos) << message;
+}
+
+TEST_F(TestBudget, MemoryLimitStopsGrowingText)
+{
+    Budget::Limits limits{};
+    limits.memory = 100000;
+    String message{fail("mut text s = \"\";\nwhile (true) { s = s + \"0123456789\"; }\n", limits)};
+    ASSERT_NE(message.find("Memory limit of 100000 bytes exceeded"), String::npos) << message;
+}
+
+TEST_F(TestBudget, TimeoutStopsLoop)
+{
+    Budget::Limits limits{};
+    limits.timeout = std::chrono::milliseconds{50};
+    String message{fail(FOREVER, limits)};
+    ASSERT_NE(message.find("Time limit of 50 ms exceeded"), String::npos) << message;
+}
+
+TEST_F(TestBudget, TasksCountAgainstBudgetOfSpawningRun)
+{
+    Budget::Limits limits{};
+    limits.steps = 5000;
+    String source{"funk spin = () { mut numb i = 0; while (true) { i += 1; } return i; };\n"
+                  "task t = spawn spin();\nnumb n = await t;\n"};
+    ASSERT_NE(fail(source, limits).find("Step limit"), String::npos);
+}
+
+TEST_F(TestBudget, CountsWithinLimits)
+{
+    Budget::Limits limits{};
+    limits.steps = 1000000;
+    Budget budget{limits};
+    Budget::enter(&budget);
+    for (int i{0}; i < 3000; i++) { Budget::step(SourceLocation{"", 0, 0}); }
+    Budget::enter(nullptr);
+    ASSERT_EQ(budget.get_steps(), 3000u);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+#include "runtime/Channel.h"
+#include "utils/Common.h"
+#include "utils/Exception.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace funk;
+
+class TestChannel : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        // Cleanup code if needed
+    }
+};
+
+TEST_F(TestChannel, ReceivesInOrderSent)
+{
+    Channel channel{4};
+    for (Numb i{0}; i < 4; i++) { channel.send(NodeValue{i}); }
+
+    NodeValue value{};
+    for (Numb i{0}; i < 4; i++)
+    {
+        ASSERT_TRUE(channel.recv(value));
+        ASSERT_EQ(value.get<Numb>(), i);
+    }
+}
+
+TEST_F(TestChannel, DrainsAfterClose)
+{
+    Channel channel{2};
+    channel.send(NodeValue{String{"a"}});
+    channel.close();
+
+    ASSERT_THROW(channel.send(NodeValue{String{"b"}}), RuntimeError);
+    NodeValue value{};
+    ASSERT_TRUE(channel.recv(value));
+    ASSERT_EQ(value.get<String>(), "a");
+    ASSERT_FALSE(channel.recv(value));
+    ASSERT_EQ(channel.to_s(), "<channel 2 closed>");
+}
+
+TEST_F(TestChannel, DoneWaitsForValueOrClose)
+{
+    Channel channel{2};
+    std::thread producer{[&] {
+        channel.send(NodeValue{Numb{1}});
+        channel.close();
+    }};
+
+    NodeValue value{};
+    ASSERT_FALSE(channel.is_done());
+    ASSERT_TRUE(channel.recv(value));
+    ASSERT_EQ(value.get<Numb>(), 1);
+    ASSERT_TRUE(channel.is_done());
+    producer.join();
+}
+
+TEST_F(TestChannel, SendsRacingCloseAreDeliveredOrFail)
+{
+    for (int round{0}; round < 200; round++)
+    {
+        Channel channel{8};
+        std::atomic<Numb> delivered{0};
+        Vector<std::thread> senders{};
+        for (int i{0}; i < 3; i++)
+        {
+            senders.emplace_back([&] {
+                try
+                {
+                    while (true)
+                    {
+                        channel.send(NodeValue{Numb{1}});
+                        delivered++;
+                    }
+                }
+                catch (const RuntimeError&)
+                {
+                    // Closed, every send before this one was counted
+                }
+            });
+        }
+        std::thread closer{[&] {
+            std::this_thread::sleep_for(std::chrono::microseconds(50 + round % 7 * 20));
+            channel.close();
+        }};
+
+        // Every send that did not fail is received, even if the channel was closed while it was under way
+        Numb received{0};
+        NodeValue value{};
+        while (!channel.is_done())
+        {
+            bool got{channel.recv(value)};
+            EXPECT_TRUE(got);
+            if (!got) { break; }
+            received++;
+        }
+        EXPECT_FALSE(channel.recv(value));
+        closer.join();
+        for (std::thread& sender : senders) { sender.join(); }
+        ASSERT_EQ(received, delivered.load());
+    }
+}
+
+TEST_F(TestChannel, FirstValueFixesType)
+{
+    Channel channel{};
+    channel.send(NodeValue{1});
+    ASSERT_THROW(channel.send(NodeValue{1.5}), TypeError);
+    ASSERT_THROW(channel.send(NodeValue{}), TypeError);
+    ASSERT_EQ(channel.get_capacity(), size_t{Channel::DEFAULT_CAPACITY});
+}
+
+TEST_F(TestChannel, HoldsOneValueWithCapacityOne)
+{
+    Channel channel{1};
+    channel.send(NodeValue{Numb{1}});
+
+    // The second send blocks until the first value is received
+    std::atomic<bool> sent{false};
+    std::thread sender{[&] {
+        channel.send(NodeValue{Numb{2}});
+        sent.store(true);
+        channel.send(NodeValue{Numb{3}});
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(sent.load());
+
+    NodeValue value{};
+    for (Numb expected{1}; expected <= 3; expected++)
+    {
+        ASSERT_TRUE(channel.recv(value));
+        ASSERT_EQ(value.get<Numb>(), expected);
+    }
+    sender.join();
+    ASSERT_TRUE(sent.load());
+}
+
+TEST_F(TestChannel, PassesValuesBetweenThreads)
+{
+    // The capacities are far below the number of values, so both sides block on each other many times
+    for (size_t capacity : {1, 3})
+    {
+        Channel channel{capacity};
+        const Numb count{20000};
+
+        std::thread producer{[&] {
+            for (Numb i{1}; i <= count; i++) { channel.send(NodeValue{i}); }
+            channel.close();
+        }};
+
+        Numb total{0};
+        bool ordered{true};
+        NodeValue value{};
+        for (Numb expected{1}; channel.recv(value); expected++)
+        {
+            ordered = ordered && value.get<Numb>() == expected;
+            total += value.get<Numb>();
+        }
+        producer.join();
+
+        ASSERT_TRUE(ordered);
+        ASSERT_EQ(total, count * (count + 1) / 2);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,71 @@
+#include "lexer/Lexer.h"
+#include "optimizer/ConstantFolder.h"
+#include "parser/Parser.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestConstantFolder : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        for (Node* ast : trees) { delete ast; }
+    }
+
+    /**
+     * @brief Parses and folds a program, returning the folded tree as text.
+     */
+    String fold(const String& source)
+    {
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        ConstantFolder folder{};
+        Node* ast{folder.run(parser.parse())};
+        trees.push_back(ast);
+        changed = folder.get_changed();
+        return ast->to_s();
+    }
+
+    Vector<Node*> trees{};
+    size_t changed{0};
+};
+
+TEST_F(TestConstantFolder, FoldsLiteralOperations)
+{
+    ASSERT_EQ(fold("print(2 ^ 3, 1 + 2 * 3);\n"), "print( 8, 7 )\n");
+    ASSERT_EQ(changed, 3);
+    ASSERT_EQ(fold("print(\"a\" + \"b\", -(1 + 1), !true);\n"), "print( \"ab\", -2, false )\n");
+}
+
+TEST_F(TestConstantFolder, KeepsFailingOperations)
+{
+    ASSERT_EQ(fold("print(1 / 0);\n"), "print( (1 / 0) )\n");
+    ASSERT_EQ(fold("print(true + \"a\");\n"), "print( (true + \"a\") )\n");
+    ASSERT_EQ(changed, 0);
+}
+
+TEST_F(TestConstantFolder, SimplifiesTypedVariables)
+{
+    ASSERT_EQ(fold("numb x = 2;\nprint(x + 0, 1 * x, x ^ 2);\n"), "Declaration: x = 2\nprint( x, x, (x * x) )\n");
+}
+
+TEST_F(TestConstantFolder, KeepsUntypedVariables)
+{
+    // Nothing is known about x inside the function, it may be text
+    ASSERT_EQ(fold("numb x = 2;\nfunk f = () { return x + 0; }\n"),
+        "Declaration: x = 2\nfunk f = () {\nreturn (x + 0)\n}\n");
+    ASSERT_EQ(changed, 0);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
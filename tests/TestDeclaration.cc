@@ -32,7 +32,7 @@ TEST_F(TestDeclaration, DeclareAndRetrieveVariable) {
     auto* var = dynamic_cast<VariableNode*>(Scope::instance().get("x"));
     ASSERT_NE(var, nullptr);
     ASSERT_EQ(var->get_identifier(), "x");
-    ASSERT_EQ(var->get_value().get<int>(), 42);
+    ASSERT_EQ(var->get_value().get<Numb>(), 42);
     ASSERT_EQ(var->get_type(), TokenType::NUMB_TYPE);
 }
 
@@ -0,0 +1,135 @@
+#include "ast/BlockNode.h"
+#include "lexer/Lexer.h"
+#include "parser/Parser.h"
+#include "parser/Registry.h"
+#include "parser/Scope.h"
+#include "runtime/Budget.h"
+#include "runtime/Multiplexer.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+const SourceLocation NOWHERE{"", 0, 0};
+
+class TestFiber : public ::testing::Test
+{
+protected:
+    /**
+     * @brief Runs a program on a scope stack and registry of its own, like a multiplexed file.
+     */
+    static NodeValue run(const String& source, const String& name)
+    {
+        Scope scope{};
+        Registry registry{};
+        Scope::enter(&scope);
+        Registry::enter(&registry);
+        scope.push();
+
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        auto ast = static_cast<BlockNode*>(parser.parse());
+        ast->evaluate_same_scope();
+        NodeValue value{static_cast<ExpressionNode*>(scope.get(name))->get_value()};
+
+        scope.pop();
+        Scope::enter(nullptr);
+        Registry::enter(nullptr);
+        delete ast;
+        return value;
+    }
+};
+
+TEST_F(TestFiber, StepsOutsideFibersNeverSuspend)
+{
+    ASSERT_EQ(Fiber::get_running(), nullptr);
+    for (int i{0}; i < 100000; i++) { Budget::step(NOWHERE); }
+    ASSERT_EQ(Fiber::get_running(), nullptr);
+}
+
+TEST_F(TestFiber, SuspendsAfterSlice)
+{
+    int count{0};
+    Fiber fiber{[&count]
+        {
+            for (int i{0}; i < 10; i++)
+            {
+                count++;
+                Budget::step(NOWHERE);
+            }
+        }};
+
+    fiber.resume(3);
+    ASSERT_EQ(count, 3);
+    ASSERT_FALSE(fiber.is_done());
+    fiber.resume(100);
+    ASSERT_EQ(count, 10);
+    ASSERT_TRUE(fiber.is_done());
+}
+
+TEST_F(TestFiber, ResumeRethrowsErrorOfBody)
+{
+    Fiber fiber{[] { throw RuntimeError("failed"); }};
+    ASSERT_THROW(fiber.resume(1), RuntimeError);
+    ASSERT_TRUE(fiber.is_done());
+}
+
+TEST_F(TestFiber, LoopThatNeverEndsLetsOthersRun)
+{
+    // On a single thread the first body only stops once the second one had a turn
+    bool stop{false};
+    Multiplexer multiplexer{1, 100};
+    multiplexer.add(
+        [&stop]
+        {
+            while (!stop) { Budget::step(NOWHERE); }
+        });
+    multiplexer.add([&stop] { stop = true; });
+    multiplexer.run();
+    ASSERT_TRUE(stop);
+}
+
+TEST_F(TestFiber, ProgramsTakeTurnsWithFunctionsOfTheirOwn)
+{
+    const String loop{"mut numb total = 0;\nmut numb i = 0;\nwhile (i < 1000) { total += f(i); i += 1; }\n"};
+    NodeValue doubled{};
+    NodeValue squared{};
+
+    Multiplexer multiplexer{2, 10};
+    multiplexer.add([&] { doubled = run("funk f = (numb n) { return n * 2; };\n" + loop, "total"); });
+    multiplexer.add([&] { squared = run("funk f = (numb n) { return n * n; };\n" + loop, "total"); });
+    multiplexer.run();
+
+    ASSERT_EQ(doubled.get<Numb>(), 999000);
+    ASSERT_EQ(squared.get<Numb>(), 332833500);
+    ASSERT_FALSE(Registry::instance().contains("f"));
+}
+
+TEST_F(TestFiber, ExitEndsOnlyTheProgram)
+{
+    int status{0};
+    Multiplexer multiplexer{1};
+    multiplexer.add(
+        [&status]
+        {
+            try
+            {
+                run("numb x = 1;\nexit(4);\n", "x");
+            }
+            catch (const ProgramExit& e)
+            {
+                status = e.get_status();
+            }
+            // run() leaves the program entered when it throws
+            Scope::enter(nullptr);
+            Registry::enter(nullptr);
+        });
+    multiplexer.run();
+    ASSERT_EQ(status, 4);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include "ProgramTest.h"
+#include "runtime/Generator.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestGenerator : public ProgramTest
+{
+};
+
+const String COUNT{"funk count = (numb from, numb to) { mut numb i = from; while (i <= to) { yield i; i += 1; } };\n"};
+
+TEST_F(TestGenerator, YieldsValuesLazily)
+{
+    std::shared_ptr<Generator> generator{Generator::from(run(COUNT + "gen g = count(1, 3);\n", "g"))};
+    ASSERT_NE(generator, nullptr);
+    ASSERT_EQ(generator->to_s(), "<generator count>");
+
+    NodeValue value{};
+    for (Numb i{1}; i <= 3; i++)
+    {
+        ASSERT_FALSE(generator->is_done());
+        ASSERT_TRUE(generator->next(value));
+        ASSERT_EQ(value.get<Numb>(), i);
+    }
+    ASSERT_TRUE(generator->is_done());
+    ASSERT_FALSE(generator->next(value));
+    ASSERT_EQ(generator->to_s(), "<generator count done>");
+}
+
+TEST_F(TestGenerator, RunsFromPipesAndLoops)
+{
+    String source{COUNT + "mut numb total = 0;\nfunk add = (numb x) { total += x; };\ncount(1, 100) >> add;\n"
+                          "funk naturals = () { mut numb n = 0; while (true) { n += 1; yield n; } };\n"
+                          "gen g = naturals();\nmut numb sum = 0;\nwhile (sum < 10) { sum += g.next(); }\n"};
+    ASSERT_EQ(run(source, "total").get<Numb>(), 5050);
+    ASSERT_EQ(run("numb last = g.next();\n", "last").get<Numb>(), 5);
+    ASSERT_EQ(run("numb sum_again = sum;\n", "sum_again").get<Numb>(), 10);
+}
+
+TEST_F(TestGenerator, FollowsBranchesAndReturn)
+{
+    String source{"funk odd = (numb n) { mut numb i = 0; while (true) { i += 1; if (i > n) { return; } "
+                  "else if (i % 2 == 0) { numb skipped = i; } else { yield i; } } };\n"
+                  "gen g = odd(6);\nnumb a = g.next();\nnumb b = g.next();\nnumb c = g.next();\n"
+                  "bool done = g.done();\n"};
+    ASSERT_EQ(run(source, "a").get<Numb>(), 1);
+    ASSERT_EQ(run("numb bc = b * 10 + c;\n", "bc").get<Numb>(), 35);
+    ASSERT_TRUE(run("bool ended = done;\n", "ended").get<bool>());
+}
+
+TEST_F(TestGenerator, ReportsErrors)
+{
+    ASSERT_THROW(run("yield 1;\n", "x"), SyntaxError);
+    ASSERT_THROW(run("funk bad = () { yield 1 / 0; };\ngen g = bad();\nnumb x = g.next();\n", "x"), RuntimeError);
+    // A failed generator has ended
+    ASSERT_TRUE(run("bool ended = g.done();\n", "ended").get<bool>());
+    // A generator can't pull from itself while it runs
+    String source{"funk self = (chan c) { gen me = recv(c); yield me.next(); };\nchan c = channel(1);\n"
+                  "gen g = self(c);\nsend(c, g);\nnumb z = g.next();\n"};
+    ASSERT_THROW(run(source, "z"), RuntimeError);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+#include "lexer/Lexer.h"
+#include "optimizer/Inliner.h"
+#include "parser/Parser.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestInliner : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        for (Node* ast : trees) { delete ast; }
+    }
+
+    /**
+     * @brief Parses a program and inlines its calls, returning the last statement as text.
+     */
+    String inline_calls(const String& source)
+    {
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        Inliner inliner{};
+        auto ast = static_cast<BlockNode*>(inliner.run(parser.parse()));
+        trees.push_back(ast);
+        changed = inliner.get_changed();
+        return ast->get_statements().back()->to_s();
+    }
+
+    Vector<Node*> trees{};
+    size_t changed{0};
+};
+
+TEST_F(TestInliner, InlinesSmallFunctions)
+{
+    ASSERT_EQ(inline_calls("funk sq = (numb x) { return x * x; }\nprint(sq(3) + sq(y));\n"),
+        "print( ((3 * 3) + (y * y)) )");
+    ASSERT_EQ(changed, 2);
+}
+
+TEST_F(TestInliner, InlinesNestedCalls)
+{
+    String source{"funk add = (numb a, numb b) { return a + b; }\nfunk inc = (numb n) { return add(n, 1); }\n"};
+    ASSERT_EQ(inline_calls(source + "print(inc(x));\n"), "print( (x + 1) )");
+}
+
+TEST_F(TestInliner, KeepsRecursiveAndRedefinableFunctions)
+{
+    ASSERT_EQ(inline_calls("funk f = (numb n) { return f(n); }\nprint(f(1));\n"), "print( f( 1 ) )");
+    ASSERT_EQ(inline_calls("print(1);\nfunk g = (numb n) { return n; }\nprint(g(1));\n"), "print( g( 1 ) )");
+    ASSERT_EQ(inline_calls("funk h = (numb n) { return n; }\nfunk h = (0) { return 1; }\nprint(h(1));\n"),
+        "print( h( 1 ) )");
+    ASSERT_EQ(changed, 0);
+}
+
+TEST_F(TestInliner, KeepsArgumentEvaluation)
+{
+    String source{"funk sub = (numb a, numb b) { return b - a; }\nfunk sq = (numb x) { return x * x; }\n"};
+    // Arguments with side effects must run once and in order
+    ASSERT_EQ(inline_calls(source + "print(sub(f(), g()));\n"), "print( sub( f(  ), g(  ) ) )");
+    ASSERT_EQ(inline_calls(source + "print(sq(f()));\n"), "print( sq( f(  ) ) )");
+    ASSERT_EQ(inline_calls(source + "print(sub(1, f()));\n"), "print( (f(  ) - 1) )");
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -61,6 +61,22 @@ TEST_F(TestLexer, Lexer)
     ASSERT_EQ(tokens[4].get_type(), TokenType::SEMICOLON);
 }
 
+TEST_F(TestLexer, CompoundAssignment)
+{
+    Lexer lexer{"+= -= *= /= %= ^=", "test"};
+    auto tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 6);
+    ASSERT_EQ(tokens[0].get_type(), TokenType::PLUS_ASSIGN);
+    ASSERT_EQ(tokens[1].get_type(), TokenType::MINUS_ASSIGN);
+    ASSERT_EQ(tokens[2].get_type(), TokenType::MULTIPLY_ASSIGN);
+    ASSERT_EQ(tokens[3].get_type(), TokenType::DIVIDE_ASSIGN);
+    ASSERT_EQ(tokens[4].get_type(), TokenType::MODULO_ASSIGN);
+    ASSERT_EQ(tokens[4].get_lexeme(), "%=");
+    ASSERT_EQ(tokens[5].get_type(), TokenType::POWER_ASSIGN);
+    ASSERT_EQ(tokens[5].get_lexeme(), "^=");
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -24,10 +24,10 @@ TEST_F(TestLiteralNode, Integer)
 
     LiteralNode node{loc, 5};
     ASSERT_TRUE(node.get_value().is_numeric());
-    ASSERT_TRUE(node.get_value().is_a<int>());
+    ASSERT_TRUE(node.get_value().is_a<Numb>());
     ASSERT_FALSE(node.get_value().is_a<double>());
     ASSERT_FALSE(node.get_value().is_nothing());
-    ASSERT_EQ(node.get_value().get<int>(), 5);
+    ASSERT_EQ(node.get_value().get<Numb>(), 5);
     ASSERT_THROW(node.get_value().get<double>(), TypeError);
     ASSERT_THROW(node.get_value().cast<None>(), TypeError);
     ASSERT_EQ(node.get_value().cast<double>(), 5.0);
@@ -42,12 +42,12 @@ TEST_F(TestLiteralNode, Double)
 
     LiteralNode node{loc, 3.14};
     ASSERT_TRUE(node.get_value().is_numeric());
-    ASSERT_FALSE(node.get_value().is_a<int>());
+    ASSERT_FALSE(node.get_value().is_a<Numb>());
     ASSERT_TRUE(node.get_value().is_a<double>());
     ASSERT_FALSE(node.get_value().is_nothing());
     ASSERT_EQ(node.get_value().get<double>(), 3.14);
-    ASSERT_THROW(node.get_value().get<int>(), TypeError);
-    ASSERT_EQ(node.get_value().cast<int>(), 3);
+    ASSERT_THROW(node.get_value().get<Numb>(), TypeError);
+    ASSERT_EQ(node.get_value().cast<Numb>(), 3);
     ASSERT_EQ(node.get_value().cast<bool>(), true);
     ASSERT_THROW(node.get_value().cast<char>(), TypeError);
 }
@@ -61,13 +61,13 @@ TEST_F(TestLiteralNode, Boolean)
     ASSERT_TRUE(true_node.get_value().is_a<bool>());
     ASSERT_FALSE(true_node.get_value().is_nothing());
     ASSERT_EQ(true_node.get_value().get<bool>(), true);
-    ASSERT_EQ(true_node.get_value().cast<int>(), 1);
+    ASSERT_EQ(true_node.get_value().cast<Numb>(), 1);
     ASSERT_EQ(true_node.get_value().cast<double>(), 1.0);
     ASSERT_EQ(true_node.get_value().cast<String>(), "true");
 
     LiteralNode false_node{loc, false};
     ASSERT_EQ(false_node.get_value().get<bool>(), false);
-    ASSERT_EQ(false_node.get_value().cast<int>(), 0);
+    ASSERT_EQ(false_node.get_value().cast<Numb>(), 0);
     ASSERT_EQ(false_node.get_value().cast<double>(), 0.0);
     ASSERT_EQ(false_node.get_value().cast<String>(), "false");
 }
@@ -83,7 +83,7 @@ TEST_F(TestLiteralNode, String)
     ASSERT_EQ(node.get_value().get<String>(), "hello");
     ASSERT_EQ(node.to_s(), "\"hello\"");
     ASSERT_EQ(node.get_value().cast<bool>(), true);
-    ASSERT_THROW(node.get_value().cast<int>(), TypeError);
+    ASSERT_THROW(node.get_value().cast<Numb>(), TypeError);
     ASSERT_THROW(node.get_value().cast<double>(), TypeError);
     ASSERT_THROW(node.get_value().cast<char>(), TypeError);
 }
@@ -97,7 +97,7 @@ TEST_F(TestLiteralNode, Char)
     ASSERT_TRUE(node.get_value().is_a<char>());
     ASSERT_FALSE(node.get_value().is_nothing());
     ASSERT_EQ(node.get_value().get<char>(), 'A');
-    ASSERT_EQ(node.get_value().cast<int>(), 65);
+    ASSERT_EQ(node.get_value().cast<Numb>(), 65);
     ASSERT_EQ(node.get_value().cast<double>(), 65.0);
     ASSERT_EQ(node.get_value().cast<bool>(), true);
     ASSERT_EQ(node.get_value().cast<String>(), "A");
@@ -114,7 +114,7 @@ TEST_F(TestLiteralNode, None)
     ASSERT_NO_THROW(node.get_value().get<None>());
     ASSERT_EQ(node.get_value().cast<bool>(), false);
     ASSERT_EQ(node.get_value().cast<String>(), "none");
-    ASSERT_THROW(node.get_value().cast<int>(), TypeError);
+    ASSERT_THROW(node.get_value().cast<Numb>(), TypeError);
     ASSERT_THROW(node.get_value().cast<double>(), TypeError);
     ASSERT_THROW(node.get_value().cast<char>(), TypeError);
 }
@@ -125,8 +125,8 @@ TEST_F(TestLiteralNode, GetValue)
 
     LiteralNode int_node{loc, 42};
     NodeValue value = int_node.get_value();
-    ASSERT_TRUE(std::holds_alternative<int>(value.get_variant()));
-    ASSERT_EQ(std::get<int>(value.get_variant()), 42);
+    ASSERT_TRUE(std::holds_alternative<Numb>(value.get_variant()));
+    ASSERT_EQ(std::get<Numb>(value.get_variant()), 42);
 
     LiteralNode stringNode{loc, String("test")};
     value = stringNode.get_value();
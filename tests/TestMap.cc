@@ -0,0 +1,153 @@
+#include "ProgramTest.h"
+#include "runtime/Map.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestMap : public ProgramTest
+{
+};
+
+TEST_F(TestMap, SetsFindsAndRemovesKeys)
+{
+    Map map{};
+    map.set(NodeValue{Numb{1}}, NodeValue{String{"one"}});
+    map.set(NodeValue{Numb{2}}, NodeValue{String{"two"}});
+    map.set(NodeValue{Numb{1}}, NodeValue{String{"uno"}});
+
+    ASSERT_EQ(map.size(), 2u);
+    ASSERT_EQ(map.find(NodeValue{Numb{1}})->get<String>(), "uno");
+    ASSERT_EQ(map.find(NodeValue{Numb{3}}), nullptr);
+
+    ASSERT_TRUE(map.remove(NodeValue{Numb{1}}));
+    ASSERT_FALSE(map.remove(NodeValue{Numb{1}}));
+    ASSERT_EQ(map.find(NodeValue{Numb{1}}), nullptr);
+    ASSERT_EQ(map.size(), 1u);
+}
+
+TEST_F(TestMap, GrowsAndKeepsInsertionOrder)
+{
+    Map map{};
+    for (Numb i{0}; i < 10000; i++) { map.set(NodeValue{String{"key" + to_str(i)}}, NodeValue{i}); }
+    for (Numb i{0}; i < 10000; i += 2) { map.remove(NodeValue{String{"key" + to_str(i)}}); }
+    for (Numb i{0}; i < 100; i++) { map.set(NodeValue{String{"more" + to_str(i)}}, NodeValue{i}); }
+
+    ASSERT_EQ(map.size(), 5100u);
+    ASSERT_EQ(map.find(NodeValue{String{"key9999"}})->get<Numb>(), 9999);
+
+    size_t position{0};
+    NodeValue key{};
+    NodeValue value{};
+    Numb expected{1};
+    while (expected < 10000 && map.next(position, key, value))
+    {
+        ASSERT_EQ(value.get<Numb>(), expected);
+        expected += 2;
+    }
+    ASSERT_TRUE(map.next(position, key, value));
+    ASSERT_EQ(key.get<String>(), "more0");
+}
+
+TEST_F(TestMap, KeysOfOtherTypesAreDifferent)
+{
+    Map map{};
+    map.set(NodeValue{0.0}, NodeValue{Numb{1}});
+    ASSERT_NE(map.find(NodeValue{-0.0}), nullptr);
+    ASSERT_THROW(map.set(NodeValue{Numb{0}}, NodeValue{Numb{2}}), TypeError);
+    ASSERT_THROW(map.set(NodeValue{1.5}, NodeValue{String{"x"}}), TypeError);
+    ASSERT_THROW(map.set(NodeValue{None{}}, NodeValue{Numb{2}}), TypeError);
+    ASSERT_EQ(map.size(), 1u);
+}
+
+TEST_F(TestMap, UpdatedCopiesLeaveEarlierVersions)
+{
+    Vector<std::shared_ptr<Map>> versions{std::make_shared<Map>()};
+    for (Numb i{0}; i < 2000; i++) { versions.push_back(versions.back()->with(NodeValue{i}, NodeValue{i * i})); }
+
+    ASSERT_EQ(versions[10]->size(), 10u);
+    ASSERT_EQ(versions[10]->find(NodeValue{Numb{10}}), nullptr);
+    ASSERT_EQ(versions[2000]->find(NodeValue{Numb{1234}})->get<Numb>(), 1234 * 1234);
+
+    std::shared_ptr<Map> removed{versions[2000]->without(NodeValue{Numb{1}})};
+    ASSERT_EQ(removed->size(), 1999u);
+    ASSERT_EQ(removed->find(NodeValue{Numb{1}}), nullptr);
+    ASSERT_NE(versions[2000]->find(NodeValue{Numb{1}}), nullptr);
+
+    std::shared_ptr<Map> replaced{removed->with(NodeValue{Numb{0}}, NodeValue{Numb{-1}})};
+    ASSERT_EQ(removed->find(NodeValue{Numb{0}})->get<Numb>(), 0);
+    ASSERT_EQ(replaced->find(NodeValue{Numb{0}})->get<Numb>(), -1);
+
+    // Iterating keeps the order the keys were first added in
+    std::shared_ptr<Map> ordered{Map::iterable(replaced)};
+    size_t position{0};
+    NodeValue key{};
+    NodeValue value{};
+    ASSERT_TRUE(ordered->next(position, key, value));
+    ASSERT_EQ(value.get<Numb>(), -1);
+    ASSERT_TRUE(ordered->next(position, key, value));
+    ASSERT_EQ(key.get<Numb>(), 2);
+}
+
+TEST_F(TestMap, RunsMethodsOfLiterals)
+{
+    NodeValue value{run("mut map m = { \"a\": 1, \"b\": 2 };\n"
+                        "m.set(\"c\", 3);\n"
+                        "m.remove(\"a\");\n"
+                        "numb b = m.get(\"b\");\n"
+                        "numb missing = m.get(\"a\", 0);\n"
+                        "bool has = m.has(\"c\");\n",
+        "m")};
+    ASSERT_EQ(value.cast<String>(), "{ \"b\": 2, \"c\": 3 }");
+    ASSERT_EQ(get("b").get<Numb>(), 2);
+    ASSERT_EQ(get("missing").get<Numb>(), 0);
+    ASSERT_TRUE(get("has").get<bool>());
+}
+
+TEST_F(TestMap, CopiesStayUnchanged)
+{
+    run("mut map m = { 1: 1 };\n"
+        "map copy = m;\n"
+        "map with = m.with(2, 2);\n"
+        "m.set(3, 3);\n",
+        "m");
+    ASSERT_EQ(get("copy").cast<String>(), "{ 1: 1 }");
+    ASSERT_EQ(get("with").cast<String>(), "{ 1: 1, 2: 2 }");
+    ASSERT_EQ(get("m").cast<String>(), "{ 1: 1, 3: 3 }");
+}
+
+TEST_F(TestMap, CopiesChangeInPlaceOnceMutable)
+{
+    run("map base = { \"a\": 1, \"b\": 2 };\n"
+        "mut map m = base.without(\"a\").with(\"c\", 3);\n"
+        "m.set(\"a\", 4);\n",
+        "m");
+    ASSERT_EQ(get("m").cast<String>(), "{ \"b\": 2, \"c\": 3, \"a\": 4 }");
+    ASSERT_EQ(get("base").cast<String>(), "{ \"a\": 1, \"b\": 2 }");
+}
+
+TEST_F(TestMap, ImmutableMapsCannotChange)
+{
+    ASSERT_THROW(run("map m = { 1: 1 };\nm.set(2, 2);\n", "m"), RuntimeError);
+    ASSERT_THROW(run("map n = { 1: 1 };\nn.remove(1);\n", "n"), RuntimeError);
+}
+
+TEST_F(TestMap, PipesKeysAndValues)
+{
+    NodeValue value{run("map m = { \"x\": 1, \"y\": 2 };\n"
+                        "chan keys = channel();\n"
+                        "m >> keys;\n"
+                        "chan values = channel();\n"
+                        "m.values() >> values;\n"
+                        "text first = recv(keys);\n"
+                        "numb second = recv(values) + recv(values);\n",
+        "first")};
+    ASSERT_EQ(value.get<String>(), "x");
+    ASSERT_EQ(get("second").get<Numb>(), 3);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include "ast/NodeValue.h"
 #include "utils/Common.h"
 #include <gtest/gtest.h>
+#include <limits>
 
 using namespace funk;
 
@@ -22,10 +23,10 @@ TEST_F(TestNodeValue, Integer)
 {
     NodeValue value{5};
     ASSERT_TRUE(value.is_numeric());
-    ASSERT_TRUE(value.is_a<int>());
+    ASSERT_TRUE(value.is_a<Numb>());
     ASSERT_FALSE(value.is_a<double>());
     ASSERT_FALSE(value.is_nothing());
-    ASSERT_EQ(value.get<int>(), 5);
+    ASSERT_EQ(value.get<Numb>(), 5);
     ASSERT_THROW(value.get<double>(), TypeError);
     ASSERT_THROW(value.cast<None>(), TypeError);
     ASSERT_EQ(value.cast<double>(), 5.0);
@@ -38,12 +39,12 @@ TEST_F(TestNodeValue, Double)
 {
     NodeValue value{3.14};
     ASSERT_TRUE(value.is_numeric());
-    ASSERT_FALSE(value.is_a<int>());
+    ASSERT_FALSE(value.is_a<Numb>());
     ASSERT_TRUE(value.is_a<double>());
     ASSERT_FALSE(value.is_nothing());
     ASSERT_EQ(value.get<double>(), 3.14);
-    ASSERT_THROW(value.get<int>(), TypeError);
-    ASSERT_EQ(value.cast<int>(), 3);
+    ASSERT_THROW(value.get<Numb>(), TypeError);
+    ASSERT_EQ(value.cast<Numb>(), 3);
     ASSERT_EQ(value.cast<bool>(), true);
     ASSERT_THROW(value.cast<char>(), TypeError);
 }
@@ -55,13 +56,13 @@ TEST_F(TestNodeValue, Boolean)
     ASSERT_TRUE(true_value.is_a<bool>());
     ASSERT_FALSE(true_value.is_nothing());
     ASSERT_EQ(true_value.get<bool>(), true);
-    ASSERT_EQ(true_value.cast<int>(), 1);
+    ASSERT_EQ(true_value.cast<Numb>(), 1);
     ASSERT_EQ(true_value.cast<double>(), 1.0);
     ASSERT_EQ(true_value.cast<String>(), "true");
 
     NodeValue false_value{false};
     ASSERT_EQ(false_value.get<bool>(), false);
-    ASSERT_EQ(false_value.cast<int>(), 0);
+    ASSERT_EQ(false_value.cast<Numb>(), 0);
     ASSERT_EQ(false_value.cast<double>(), 0.0);
     ASSERT_EQ(false_value.cast<String>(), "false");
 }
@@ -74,7 +75,7 @@ TEST_F(TestNodeValue, String)
     ASSERT_FALSE(value.is_nothing());
     ASSERT_EQ(value.get<String>(), "hello");
     ASSERT_EQ(value.cast<bool>(), true);
-    ASSERT_THROW(value.cast<int>(), TypeError);
+    ASSERT_THROW(value.cast<Numb>(), TypeError);
     ASSERT_THROW(value.cast<double>(), TypeError);
     ASSERT_THROW(value.cast<char>(), TypeError);
 }
@@ -86,7 +87,7 @@ TEST_F(TestNodeValue, Char)
     ASSERT_TRUE(value.is_a<char>());
     ASSERT_FALSE(value.is_nothing());
     ASSERT_EQ(value.get<char>(), 'A');
-    ASSERT_EQ(value.cast<int>(), 65);
+    ASSERT_EQ(value.cast<Numb>(), 65);
     ASSERT_EQ(value.cast<double>(), 65.0);
     ASSERT_EQ(value.cast<bool>(), true);
     ASSERT_EQ(value.cast<String>(), "A");
@@ -101,7 +102,7 @@ TEST_F(TestNodeValue, None)
     ASSERT_NO_THROW(value.get<None>());
     ASSERT_EQ(value.cast<bool>(), false);
     ASSERT_EQ(value.cast<String>(), "none");
-    ASSERT_THROW(value.cast<int>(), TypeError);
+    ASSERT_THROW(value.cast<Numb>(), TypeError);
     ASSERT_THROW(value.cast<double>(), TypeError);
     ASSERT_THROW(value.cast<char>(), TypeError);
 }
@@ -110,8 +111,8 @@ TEST_F(TestNodeValue, GetVariant)
 {
     NodeValue int_value{42};
     auto variant = int_value.get_variant();
-    ASSERT_TRUE(std::holds_alternative<int>(variant));
-    ASSERT_EQ(std::get<int>(variant), 42);
+    ASSERT_TRUE(std::holds_alternative<Numb>(variant));
+    ASSERT_EQ(std::get<Numb>(variant), 42);
 
     NodeValue string_value{String("test")};
     variant = string_value.get_variant();
@@ -125,28 +126,28 @@ TEST_F(TestNodeValue, ArithmeticOperations)
     NodeValue b{3};
 
     NodeValue sum = a + b;
-    ASSERT_TRUE(sum.is_a<int>());
-    ASSERT_EQ(sum.get<int>(), 8);
+    ASSERT_TRUE(sum.is_a<Numb>());
+    ASSERT_EQ(sum.get<Numb>(), 8);
 
     NodeValue diff = a - b;
-    ASSERT_TRUE(diff.is_a<int>());
-    ASSERT_EQ(diff.get<int>(), 2);
+    ASSERT_TRUE(diff.is_a<Numb>());
+    ASSERT_EQ(diff.get<Numb>(), 2);
 
     NodeValue product = a * b;
-    ASSERT_TRUE(product.is_a<int>());
-    ASSERT_EQ(product.get<int>(), 15);
+    ASSERT_TRUE(product.is_a<Numb>());
+    ASSERT_EQ(product.get<Numb>(), 15);
 
     NodeValue quotient = a / b;
-    ASSERT_TRUE(quotient.is_a<int>());
-    ASSERT_EQ(quotient.get<int>(), 1);
+    ASSERT_TRUE(quotient.is_a<Numb>());
+    ASSERT_EQ(quotient.get<Numb>(), 1);
 
     NodeValue modulo = a % b;
-    ASSERT_TRUE(modulo.is_a<int>());
-    ASSERT_EQ(modulo.get<int>(), 2);
+    ASSERT_TRUE(modulo.is_a<Numb>());
+    ASSERT_EQ(modulo.get<Numb>(), 2);
 
     NodeValue power = pow(a, b);
-    ASSERT_TRUE(power.is_a<int>());
-    ASSERT_EQ(power.get<int>(), 125);
+    ASSERT_TRUE(power.is_a<Numb>());
+    ASSERT_EQ(power.get<Numb>(), 125);
 }
 
 TEST_F(TestNodeValue, ComparisonOperations)
@@ -206,6 +207,110 @@ TEST_F(TestNodeValue, LogicalOperations)
     ASSERT_EQ(or_result2.get<bool>(), false);
 }
 
+TEST_F(TestNodeValue, MixedTypeOperations)
+{
+    NodeValue sum = NodeValue{1} + NodeValue{0.5};
+    ASSERT_TRUE(sum.is_a<double>());
+    ASSERT_EQ(sum.get<double>(), 1.5);
+
+    NodeValue text = NodeValue{'a'} + NodeValue{String("bc")};
+    ASSERT_EQ(text.get<String>(), "abc");
+
+    ASSERT_EQ((NodeValue{2} < NodeValue{2.5}).get<bool>(), true);
+    ASSERT_EQ((NodeValue{} == NodeValue{}).get<bool>(), true);
+    ASSERT_EQ((NodeValue{1} == NodeValue{}).get<bool>(), false);
+
+    ASSERT_THROW(NodeValue{String("a")} - NodeValue{1}, TypeError);
+    ASSERT_THROW(NodeValue{1.5} % NodeValue{2}, TypeError);
+    ASSERT_THROW(NodeValue{true} < NodeValue{1}, TypeError);
+    ASSERT_THROW(NodeValue{String("a")} && NodeValue{String("b")}, TypeError);
+    ASSERT_THROW(NodeValue{String("a")} / NodeValue{0}, RuntimeError);
+}
+
+TEST_F(TestNodeValue, AppendInPlace)
+{
+    NodeValue text{String("ab")};
+    text.append(NodeValue{String("cd")});
+    text.append(NodeValue{'e'});
+    ASSERT_TRUE(text.is_a<String>());
+    ASSERT_EQ(text.get<String>(), "abcde");
+
+    ASSERT_THROW(text.append(NodeValue{1}), TypeError);
+    ASSERT_EQ(text.get<String>(), "abcde");
+
+    NodeValue number{1};
+    ASSERT_THROW(number.append(NodeValue{String("a")}), TypeError);
+}
+
+TEST_F(TestNodeValue, FitsInOneWord)
+{
+    ASSERT_EQ(sizeof(NodeValue), 8u);
+
+    NodeValue negative{-7};
+    ASSERT_EQ(negative.get<Numb>(), -7);
+    NodeValue character{static_cast<char>(-1)};
+    ASSERT_EQ(character.get<char>(), static_cast<char>(-1));
+
+    // Any NaN stays a real instead of being read as a boxed value
+    NodeValue nan{-std::nan("")};
+    ASSERT_TRUE(nan.is_a<double>());
+    ASSERT_TRUE(std::isnan(nan.get<double>()));
+    NodeValue infinity{-HUGE_VAL};
+    ASSERT_TRUE(infinity.is_a<double>());
+    ASSERT_EQ(infinity.get<double>(), -HUGE_VAL);
+}
+
+TEST_F(TestNodeValue, CopiesShareText)
+{
+    NodeValue text{String("abc")};
+    NodeValue copy{text};
+    ASSERT_EQ(&copy.as_text(), &text.as_text());
+
+    copy.append(NodeValue{'d'});
+    ASSERT_EQ(text.get<String>(), "abc");
+    ASSERT_EQ(copy.get<String>(), "abcd");
+
+    NodeValue moved{std::move(copy)};
+    ASSERT_EQ(moved.get<String>(), "abcd");
+    text = moved;
+    ASSERT_EQ(&text.as_text(), &moved.as_text());
+}
+
+TEST_F(TestNodeValue, NumbOverflow)
+{
+    NodeValue max{std::numeric_limits<Numb>::max()};
+    NodeValue min{std::numeric_limits<Numb>::min()};
+    ASSERT_EQ(max.get<Numb>(), std::numeric_limits<Numb>::max());
+    ASSERT_EQ((max - NodeValue{1}).get<Numb>(), std::numeric_limits<Numb>::max() - 1);
+
+    ASSERT_THROW(max + NodeValue{1}, RuntimeError);
+    ASSERT_THROW(min / NodeValue{-1}, RuntimeError);
+    ASSERT_THROW(-min, RuntimeError);
+    ASSERT_THROW(pow(NodeValue{3}, NodeValue{40}), RuntimeError);
+    ASSERT_EQ((min % NodeValue{-1}).get<Numb>(), 0);
+    ASSERT_EQ(pow(NodeValue{3}, NodeValue{39}).get<Numb>(), 4052555153018976267);
+}
+
+TEST_F(TestNodeValue, NumbPromotion)
+{
+    NodeValue::set_numb_promotion(true);
+    NodeValue max{std::numeric_limits<Numb>::max()};
+
+    NodeValue big = max + NodeValue{1};
+    ASSERT_TRUE(big.is_a<BigInt>());
+    ASSERT_EQ(big.get_token_type(), TokenType::NUMB);
+    ASSERT_EQ(big.cast<String>(), "9223372036854775808");
+    ASSERT_EQ((big > max).get<bool>(), true);
+
+    // Results that fit are numbs again
+    NodeValue back = big - NodeValue{1};
+    ASSERT_TRUE(back.is_a<Numb>());
+    ASSERT_EQ(back.get<Numb>(), std::numeric_limits<Numb>::max());
+    ASSERT_EQ(pow(NodeValue{2}, NodeValue{64}).cast<String>(), "18446744073709551616");
+
+    NodeValue::set_numb_promotion(false);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
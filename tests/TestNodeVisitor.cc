@@ -0,0 +1,84 @@
+#include "ast/NodeVisitor.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestNodeVisitor : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        // Cleanup code if needed
+    }
+
+    SourceLocation loc{"test.funk", 0, 0};
+};
+
+class CountingVisitor : public NodeVisitor
+{
+public:
+    int literals{0};
+    int binary_ops{0};
+
+protected:
+    void visit_literal(LiteralNode*) override { literals++; }
+
+    void visit_binary_op(BinaryOpNode* node) override
+    {
+        binary_ops++;
+        visit_children(node);
+    }
+};
+
+TEST_F(TestNodeVisitor, NodeKinds)
+{
+    LiteralNode literal{loc, 1};
+    VariableNode variable{loc, "x"};
+
+    ASSERT_EQ(literal.get_kind(), NodeKind::LITERAL);
+    ASSERT_EQ(variable.get_kind(), NodeKind::VARIABLE);
+    ASSERT_TRUE(literal.is_expression());
+    ASSERT_EQ(node_kind_to_s(NodeKind::BINARY_OP), "binary_op");
+}
+
+TEST_F(TestNodeVisitor, NodeCast)
+{
+    LiteralNode* literal{new LiteralNode(loc, 1)};
+    Token op{loc, "-", TokenType::MINUS};
+    UnaryOpNode unary{op, literal};
+    Node* node{&unary};
+
+    ASSERT_EQ(node_cast<UnaryOpNode>(node), &unary);
+    ASSERT_EQ(node_cast<ExpressionNode>(node), &unary);
+    ASSERT_EQ(node_cast<LiteralNode>(node), nullptr);
+    ASSERT_EQ(node_cast<BlockNode>(node), nullptr);
+    ASSERT_EQ(node_cast<LiteralNode>(static_cast<Node*>(nullptr)), nullptr);
+}
+
+TEST_F(TestNodeVisitor, VisitsChildren)
+{
+    // (1 + 2) * 3 inside a block
+    Token plus{loc, "+", TokenType::PLUS};
+    Token star{loc, "*", TokenType::MULTIPLY};
+    auto sum = new BinaryOpNode(new LiteralNode(loc, 1), plus, new LiteralNode(loc, 2));
+    auto product = new BinaryOpNode(sum, star, new LiteralNode(loc, 3));
+    BlockNode block{loc, {new ReturnNode(loc, product)}};
+
+    CountingVisitor visitor;
+    visitor.visit(&block);
+
+    ASSERT_EQ(visitor.literals, 3);
+    ASSERT_EQ(visitor.binary_ops, 2);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
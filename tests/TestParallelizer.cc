@@ -0,0 +1,83 @@
+#include "lexer/Lexer.h"
+#include "optimizer/Parallelizer.h"
+#include "parser/Parser.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestParallelizer : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        for (Node* ast : trees) { delete ast; }
+    }
+
+    /**
+     * @brief Parses a program and runs the pass, returning if the binary operation printed last is parallel.
+     */
+    bool is_parallel(const String& source)
+    {
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        Parallelizer parallelizer{};
+        auto ast = static_cast<BlockNode*>(parallelizer.run(parser.parse()));
+        trees.push_back(ast);
+        changed = parallelizer.get_changed();
+
+        auto call = static_cast<CallNode*>(ast->get_statements().back());
+        auto op = node_cast<BinaryOpNode>(call->get_args().front());
+        return op && op->is_parallel();
+    }
+
+    Vector<Node*> trees{};
+    size_t changed{0};
+};
+
+const String FIB{"funk fib = (0) { return 0; }\nfunk fib = (1) { return 1; }\n"
+                 "funk fib = (numb n) { return fib(n - 1) + fib(n - 2); }\n"};
+
+TEST_F(TestParallelizer, MarksCallsToPureRecursiveFunctions)
+{
+    ASSERT_TRUE(is_parallel(FIB + "print(fib(20) + fib(21));\n"));
+    // The calls inside fib are marked as well
+    ASSERT_EQ(changed, 2);
+    ASSERT_TRUE(is_parallel(FIB + "funk sum = (numb n) { mut numb i = 0; while (i < n) { i += 1; } return i; }\n"
+                                  "print(sum(x) * fib(y + 1));\n"));
+}
+
+TEST_F(TestParallelizer, KeepsCallsWithEffects)
+{
+    ASSERT_FALSE(is_parallel("funk f = (numb n) { print(n); return f(n - 1); }\nprint(f(1) + f(2));\n"));
+    ASSERT_FALSE(is_parallel("numb g = 1;\nfunk f = (numb n) { return f(n - g); }\nprint(f(1) + f(2));\n"));
+    ASSERT_FALSE(is_parallel(FIB + "mut funk h = (numb n) { return fib(n); }\nprint(h(1) + fib(2));\n"));
+    ASSERT_FALSE(is_parallel(FIB + "print(fib(1) + fib(read()));\n"));
+    ASSERT_EQ(changed, 1);
+}
+
+TEST_F(TestParallelizer, ScansOverloadsWithTheirOwnParameters)
+{
+    // k is a parameter of one overload only, the other one reads the variable of the caller
+    ASSERT_FALSE(is_parallel("funk f = (numb n, numb k) { return n + k; }\nfunk f = (0) { return 0; }\n"
+                             "funk f = (1) { return 1; }\n"
+                             "funk f = (numb n) { return f(n - 1) + f(n - 2) + k - k; }\n"
+                             "numb k = 1;\nprint(f(15) + f(14));\n"));
+}
+
+TEST_F(TestParallelizer, KeepsCallsNotWorthForking)
+{
+    ASSERT_FALSE(is_parallel("funk sq = (numb n) { return n * n; }\nprint(sq(1) + sq(2));\n"));
+    ASSERT_FALSE(is_parallel(FIB + "print(fib(1) + 2);\n"));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+#include "lexer/Lexer.h"
+#include "optimizer/PassManager.h"
+#include "parser/Parser.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestPassManager : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        for (Node* ast : trees) { delete ast; }
+    }
+
+    /**
+     * @brief Parses and optimizes a program, returning the optimized tree as text.
+     */
+    String optimize(const String& source, PassManager& passes)
+    {
+        Lexer lexer{source, "test.funk"};
+        Parser parser{lexer.tokenize(), "test.funk"};
+        Node* ast{passes.run(parser.parse())};
+        trees.push_back(ast);
+        return ast->to_s();
+    }
+
+    Vector<Node*> trees{};
+};
+
+TEST_F(TestPassManager, Levels)
+{
+    ASSERT_TRUE(PassManager{0}.get_pass_names().empty());
+    ASSERT_EQ(PassManager{1}.get_pass_names(), (Vector<String>{"fold", "dce"}));
+    ASSERT_TRUE(PassManager{2}.has_pass("fold"));
+    ASSERT_FALSE(PassManager{1}.has_pass("unknown"));
+}
+
+TEST_F(TestPassManager, NoPassesKeepTree)
+{
+    PassManager passes{0};
+    ASSERT_EQ(optimize("print(1 + 2);\n", passes), "print( (1 + 2) )\n");
+}
+
+TEST_F(TestPassManager, RemovesDeadCode)
+{
+    PassManager passes{1};
+    String source{"if (1 > 2) { print(1); }\nwhile (false) { print(2); }\nif (true) { print(3); }\n"};
+    ASSERT_EQ(optimize(source, passes), "print( 3 )\n\n");
+    ASSERT_NE(passes.report().find("dce"), String::npos);
+}
+
+TEST_F(TestPassManager, RemovesStatementsAfterReturn)
+{
+    PassManager passes{1};
+    ASSERT_EQ(optimize("funk f = () { return 1; print(2); }\n", passes), "funk f = () {\nreturn 1\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
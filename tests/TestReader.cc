@@ -0,0 +1,105 @@
+#include "io/Reader.h"
+#include "utils/Common.h"
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace funk;
+
+class TestReader : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Setup code if needed
+    }
+
+    void TearDown() override
+    {
+        for (int fd : fds) { ::close(fd); }
+        std::remove(path.c_str());
+    }
+
+    int open_file(const String& content)
+    {
+        {
+            std::ofstream file(path);
+            file << content;
+        }
+        int fd{::open(path.c_str(), O_RDONLY)};
+        fds.push_back(fd);
+        return fd;
+    }
+
+    int open_pipe(const String& content)
+    {
+        int ends[2];
+        EXPECT_EQ(::pipe(ends), 0);
+        EXPECT_EQ(::write(ends[1], content.data(), content.size()), static_cast<ssize_t>(content.size()));
+        ::close(ends[1]);
+        fds.push_back(ends[0]);
+        return ends[0];
+    }
+
+    String path{"test_reader_input.txt"};
+    Vector<int> fds{};
+};
+
+TEST_F(TestReader, ReadLinesFromFile)
+{
+    Reader reader{open_file("first\nsecond\nlast")};
+    String line;
+
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(line, "first");
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(line, "second");
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(line, "last");
+    ASSERT_FALSE(reader.read_line(line));
+    ASSERT_TRUE(reader.done());
+}
+
+TEST_F(TestReader, ReadLinesFromPipe)
+{
+    // A tiny buffer forces lines to span several reads
+    Reader reader{open_pipe("a line longer than the buffer\nb\n"), 4};
+    String line;
+
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(line, "a line longer than the buffer");
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(line, "b");
+    ASSERT_FALSE(reader.read_line(line));
+}
+
+TEST_F(TestReader, ReadAll)
+{
+    Reader reader{open_pipe("one\ntwo\nthree\n"), 4};
+    String line;
+
+    ASSERT_TRUE(reader.read_line(line));
+    ASSERT_EQ(reader.read_all(), "two\nthree\n");
+    ASSERT_TRUE(reader.done());
+}
+
+TEST_F(TestReader, ReadAllFromFile)
+{
+    Reader reader{open_file("mapped content")};
+    ASSERT_EQ(reader.read_all(), "mapped content");
+    ASSERT_EQ(reader.read_all(), "");
+}
+
+TEST_F(TestReader, EmptyInput)
+{
+    Reader reader{open_pipe("")};
+    String line;
+    ASSERT_FALSE(reader.read_line(line));
+    ASSERT_TRUE(reader.done());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
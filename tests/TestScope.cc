@@ -0,0 +1,80 @@
+#include "ast/expression/LiteralNode.h"
+#include "parser/Scope.h"
+#include "utils/Common.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestScope : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Every test works in its own scope
+        Scope::instance().push();
+    }
+
+    void TearDown() override
+    {
+        Scope::instance().pop();
+    }
+
+    SourceLocation loc{"test.funk", 0, 0};
+};
+
+TEST_F(TestScope, InnerScopesShadowOuterScopes)
+{
+    LiteralNode outer{loc, 1};
+    LiteralNode inner{loc, 2};
+    Scope::instance().add("x", &outer);
+
+    Scope::instance().push();
+    Scope::instance().add("x", &inner);
+    ASSERT_EQ(Scope::instance().get("x"), &inner);
+    ASSERT_TRUE(Scope::instance().contains_in_current_scope("x"));
+    Scope::instance().pop();
+
+    ASSERT_EQ(Scope::instance().get("x"), &outer);
+}
+
+TEST_F(TestScope, RecycledFramesStartEmpty)
+{
+    LiteralNode value{loc, 1};
+
+    Scope::instance().push(1);
+    Scope::instance().add("local", &value);
+    Scope::instance().pop();
+
+    Scope::instance().push(1);
+    ASSERT_EQ(Scope::instance().get("local"), nullptr);
+    ASSERT_FALSE(Scope::instance().contains("local"));
+    Scope::instance().pop();
+}
+
+TEST_F(TestScope, RedefinitionReplacesSymbol)
+{
+    LiteralNode first{loc, 1};
+    LiteralNode second{loc, 2};
+    Scope::instance().add("x", &first);
+    Scope::instance().add("x", &second);
+    ASSERT_EQ(Scope::instance().get("x"), &second);
+}
+
+TEST_F(TestScope, LargeScopes)
+{
+    Vector<LiteralNode> values;
+    for (int i{0}; i < 100; i++) { values.emplace_back(loc, i); }
+    for (int i{0}; i < 100; i++) { Scope::instance().add("v" + to_str(i), &values[i]); }
+
+    for (int i{0}; i < 100; i++) { ASSERT_EQ(Scope::instance().get("v" + to_str(i)), &values[i]); }
+    ASSERT_EQ(Scope::instance().get("v100"), nullptr);
+
+    Scope::instance().add("v5", &values[0]);
+    ASSERT_EQ(Scope::instance().get("v5"), &values[0]);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
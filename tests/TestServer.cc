@@ -0,0 +1,117 @@
+#include "utils/Common.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace funk;
+
+/**
+ * @brief Runs the interpreter as a server and as its clients, the tests run from the root of the repository.
+ */
+class TestServer : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(::access(FUNK, X_OK), 0) << "Build the interpreter before the tests";
+
+        server = ::fork();
+        ASSERT_GE(server, 0);
+        if (server == 0)
+        {
+            int null{::open("/dev/null", O_WRONLY)};
+            ::dup2(null, STDOUT_FILENO);
+            ::dup2(null, STDERR_FILENO);
+            ::execl(FUNK, FUNK, ("--serve=" + path).c_str(), ("--log=" + log).c_str(), static_cast<char*>(nullptr));
+            ::_exit(127);
+        }
+
+        struct stat info{};
+        for (int i{0}; i < 500 && ::stat(path.c_str(), &info) != 0; i++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(::stat(path.c_str(), &info), 0) << "The server did not start";
+    }
+
+    void TearDown() override
+    {
+        if (server > 0)
+        {
+            ::kill(server, SIGTERM);
+            ::waitpid(server, nullptr, 0);
+        }
+        ::unlink(path.c_str());
+        ::unlink(script.c_str());
+        ::unlink(log.c_str());
+    }
+
+    /**
+     * @brief Runs a program through the server.
+     * @param source The program
+     * @param output Receives what the program printed
+     * @return int Exit status of the client
+     */
+    int run(const String& source, String& output)
+    {
+        std::ofstream{script} << source;
+        FILE* client{::popen((String(FUNK) + " --client=" + path + " " + script + " 2>&1").c_str(), "r")};
+        if (!client) { return -1; }
+
+        output.clear();
+        char buffer[256];
+        for (size_t read; (read = std::fread(buffer, 1, sizeof(buffer), client)) > 0;) { output.append(buffer, read); }
+        int status{::pclose(client)};
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    /**
+     * @brief Checks if the server is still running.
+     */
+    bool server_running() const { return ::waitpid(server, nullptr, WNOHANG) == 0; }
+
+    static constexpr const char* FUNK{"bin/funk"};
+    String path{"/tmp/test_server_" + to_str(::getpid()) + ".sock"};
+    String script{"/tmp/test_server_" + to_str(::getpid()) + ".funk"};
+    String log{"/tmp/test_server_" + to_str(::getpid()) + ".log"};
+    pid_t server{-1};
+};
+
+TEST_F(TestServer, RunsFilesForClients)
+{
+    String output;
+    ASSERT_EQ(run("print(\"hello\");\n", output), 0);
+    ASSERT_EQ(output, "hello \n");
+    ASSERT_EQ(run("exit(3);\n", output), 3);
+    ASSERT_TRUE(server_running());
+}
+
+TEST_F(TestServer, UnawaitedTasksFinishBeforeTheClient)
+{
+    const String source{"funk slow = (numb n) { mut numb i = 0; while (i < n) { i += 1; } "
+                        "print(\"task finished\", i); return i; };\n"
+                        "task t = spawn slow(300000);\n"
+                        "print(\"main done\");\n"};
+
+    for (int i{0}; i < 5; i++)
+    {
+        String output;
+        ASSERT_EQ(run(source, output), 0) << output;
+        ASSERT_NE(output.find("main done"), String::npos);
+        ASSERT_NE(output.find("task finished"), String::npos);
+        ASSERT_TRUE(server_running());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
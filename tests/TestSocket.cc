@@ -0,0 +1,125 @@
+#include "io/Socket.h"
+#include "utils/Common.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace funk;
+
+class TestSocket : public ::testing::Test
+{
+protected:
+    String path{"/tmp/test_socket_" + to_str(::getpid()) + ".sock"};
+};
+
+TEST_F(TestSocket, ExchangesWholeMessages)
+{
+    Socket server{Socket::listen(path)};
+    Socket client{Socket::connect(path)};
+    Socket connection{server.accept()};
+
+    client.send("first");
+    client.send("second");
+
+    String message;
+    Vector<int> fds{};
+    ASSERT_TRUE(connection.receive(message, fds));
+    ASSERT_EQ(message, "first");
+    ASSERT_TRUE(connection.receive(message, fds));
+    ASSERT_EQ(message, "second");
+    ASSERT_TRUE(fds.empty());
+}
+
+TEST_F(TestSocket, SendsDescriptors)
+{
+    int pipe_fds[2];
+    ASSERT_EQ(::pipe(pipe_fds), 0);
+
+    Socket server{Socket::listen(path)};
+    Socket client{Socket::connect(path)};
+    Socket connection{server.accept()};
+    client.send("output", {pipe_fds[1]});
+    ::close(pipe_fds[1]);
+
+    String message;
+    Vector<int> fds{};
+    ASSERT_TRUE(connection.receive(message, fds));
+    ASSERT_EQ(fds.size(), 1u);
+    ASSERT_EQ(::write(fds[0], "hi", 2), 2);
+    ::close(fds[0]);
+
+    char buffer[4]{};
+    ASSERT_EQ(::read(pipe_fds[0], buffer, sizeof(buffer)), 2);
+    ASSERT_EQ(String(buffer, 2), "hi");
+    ::close(pipe_fds[0]);
+}
+
+TEST_F(TestSocket, ReceiveFailsOnceClosed)
+{
+    Socket server{Socket::listen(path)};
+    String message;
+    Vector<int> fds{};
+    {
+        Socket client{Socket::connect(path)};
+        Socket connection{server.accept()};
+        client.send("last");
+        ASSERT_TRUE(connection.receive(message, fds));
+        {
+            Socket gone{std::move(client)};
+        }
+        ASSERT_FALSE(connection.receive(message, fds));
+    }
+}
+
+TEST_F(TestSocket, ListeningSocketRemovesItsFile)
+{
+    struct stat info{};
+    {
+        Socket server{Socket::listen(path)};
+        ASSERT_EQ(::stat(path.c_str(), &info), 0);
+    }
+    ASSERT_NE(::stat(path.c_str(), &info), 0);
+    ASSERT_THROW(Socket::connect(path), FileError);
+}
+
+TEST_F(TestSocket, KeepsFilesThatAreNotSockets)
+{
+    std::ofstream{path} << "notes";
+    ASSERT_THROW(Socket::listen(path), FileError);
+
+    String contents;
+    std::ifstream{path} >> contents;
+    ASSERT_EQ(contents, "notes");
+    ::unlink(path.c_str());
+}
+
+TEST_F(TestSocket, RefusesSocketOfRunningServer)
+{
+    Socket server{Socket::listen(path)};
+    ASSERT_THROW(Socket::listen(path), FileError);
+    Socket client{Socket::connect(path)};
+}
+
+TEST_F(TestSocket, ReplacesSocketLeftBehind)
+{
+    // A socket file whose server is gone, as a killed server leaves it
+    int fd{::socket(AF_UNIX, SOCK_SEQPACKET, 0)};
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+    ASSERT_EQ(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ::close(fd);
+
+    Socket server{Socket::listen(path)};
+    Socket client{Socket::connect(path)};
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include "ast/BlockNode.h"
+#include "ast/expression/BinaryOpNode.h"
+#include "ast/expression/LiteralNode.h"
+#include "parser/Scope.h"
+#include "utils/Common.h"
+#include "utils/Stats.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestStats : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Start every test from zeroed counters
+        Stats::instance().reset();
+    }
+
+    void TearDown() override
+    {
+        // Cleanup code if needed
+    }
+
+    SourceLocation loc{"test.funk", 0, 0};
+};
+
+TEST_F(TestStats, CountsEvaluatedNodes)
+{
+    BinaryOpNode node(new LiteralNode(loc, 1), Token(loc, "+", TokenType::PLUS), new LiteralNode(loc, 2));
+    Stats::instance().reset();
+    node.evaluate();
+
+    String json{Stats::instance().to_json()};
+    ASSERT_NE(json.find("\"binary_op\": 1"), String::npos);
+    ASSERT_NE(json.find("\"literal\": 0"), String::npos);
+    // The result of the operation is a newly allocated literal
+    ASSERT_NE(json.find("\"nodes_allocated\": 1"), String::npos);
+}
+
+TEST_F(TestStats, CountsScopeDepth)
+{
+    Scope::instance().push();
+    Scope::instance().push();
+    Scope::instance().pop();
+    Scope::instance().pop();
+
+    String json{Stats::instance().to_json()};
+    ASSERT_NE(json.find("\"scope_pushes\": 2"), String::npos);
+    ASSERT_NE(json.find("\"scope_pops\": 2"), String::npos);
+    ASSERT_NE(json.find("\"max_scope_depth\": 2"), String::npos);
+}
+
+TEST_F(TestStats, CountsScopeLookups)
+{
+    Scope::instance().push();
+    Scope::instance().add("x", new LiteralNode(loc, 1));
+    Scope::instance().push();
+    Stats::instance().reset();
+
+    ASSERT_NE(Scope::instance().get("x"), nullptr);
+    String json{Stats::instance().to_json()};
+    ASSERT_NE(json.find("\"scope_gets\": 1"), String::npos);
+    ASSERT_NE(json.find("\"scope_avg_chain\": 2.0000"), String::npos);
+
+    Scope::instance().pop();
+    Scope::instance().pop();
+}
+
+TEST_F(TestStats, ResetClearsCounters)
+{
+    Stats::instance().function_lookup();
+    Stats::instance().reset();
+    ASSERT_NE(Stats::instance().to_json().find("\"registry_lookups\": 0"), String::npos);
+}
+
+TEST_F(TestStats, BlocksOnlyPushScopesForDeclarations)
+{
+    BlockNode plain{loc, {new LiteralNode(loc, 1), new LiteralNode(loc, 2)}};
+    BlockNode declaring{loc};
+    declaring.add(new DeclarationNode(loc, false, TokenType::NUMB, "a", new LiteralNode(loc, 1)));
+    declaring.add(new DeclarationNode(loc, false, TokenType::NUMB, "b", new LiteralNode(loc, 2)));
+
+    ASSERT_EQ(plain.get_slot_count(), 0);
+    ASSERT_EQ(declaring.get_slot_count(), 2);
+
+    plain.evaluate();
+    ASSERT_NE(Stats::instance().to_json().find("\"scope_pushes\": 0"), String::npos);
+    declaring.evaluate();
+    ASSERT_NE(Stats::instance().to_json().find("\"scope_pushes\": 1"), String::npos);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,49 @@
+#include "ProgramTest.h"
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestTask : public ProgramTest
+{
+};
+
+TEST_F(TestTask, AwaitReturnsValueOfTask)
+{
+    String source{"funk twice = (numb n) { return n * 2; };\ntask t = spawn twice(21);\nnumb result = await t;\n"};
+    ASSERT_EQ(run(source, "result").get<Numb>(), 42);
+    ASSERT_EQ(run("task u = spawn 1 + 2 * 3;\n", "u").get_token_type(), TokenType::TASK);
+}
+
+TEST_F(TestTask, AwaitRethrowsErrorOfTask)
+{
+    ASSERT_THROW(run("task t = spawn 1 / 0;\nnumb result = await t;\n", "result"), RuntimeError);
+}
+
+TEST_F(TestTask, AwaitRequiresTask)
+{
+    ASSERT_THROW(run("numb result = await 1;\n", "result"), TypeError);
+}
+
+TEST_F(TestTask, CapturesVariablesWhenSpawned)
+{
+    // The task sees the value the variable had when it was spawned, not later assignments
+    String source{"mut numb x = 1;\ntask t = spawn x + 1;\nx = 10;\nnumb result = await t * 100 + x;\n"};
+    ASSERT_EQ(run(source, "result").get<Numb>(), 210);
+}
+
+TEST_F(TestTask, RunsManyTasksOnWorkers)
+{
+    Scheduler::instance().set_workers(4);
+    String source{"funk sum = (0) { return 0; };\nfunk sum = (numb n) { return n + sum(n - 1); };\n"
+                  "funk split = (numb n) { task a = spawn sum(n); task b = spawn sum(n + 1); "
+                  "return await a + await b; };\n"
+                  "mut numb total = 0;\nmut numb i = 0;\n"
+                  "while (i < 50) { task t = spawn split(20); total += await t; i += 1; }\n"};
+    ASSERT_EQ(run(source, "total").get<Numb>(), 50 * (210 + 231));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
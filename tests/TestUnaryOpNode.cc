@@ -51,7 +51,7 @@ TEST_F(TestUnaryOpNode, NegateEvaluation)
     UnaryOpNode negateInt(minus_token, val1);
     UnaryOpNode negateDouble(minus_token, val2);
 
-    ASSERT_EQ(negateInt.get_value().get<int>(), -5);
+    ASSERT_EQ(negateInt.get_value().get<Numb>(), -5);
     ASSERT_DOUBLE_EQ(negateDouble.get_value().get<double>(), -3.14);
 }
 
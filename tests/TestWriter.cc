@@ -0,0 +1,121 @@
+#include "io/Writer.h"
+#include "utils/Common.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace funk;
+
+class TestWriter : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // Start from an empty file
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    String contents() const
+    {
+        std::ifstream file(path);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    String path{"test_writer_output.txt"};
+};
+
+TEST_F(TestWriter, BuffersUntilFlush)
+{
+    Writer writer{path, false, 64};
+    writer.write("hello");
+    writer.put(' ');
+    ASSERT_EQ(contents(), "");
+
+    writer.flush();
+    ASSERT_EQ(contents(), "hello ");
+}
+
+TEST_F(TestWriter, FlushesWhenBufferIsFull)
+{
+    Writer writer{path, false, 4};
+    writer.write("abc");
+    writer.write("de");
+    ASSERT_EQ(contents(), "abc");
+
+    writer.write("a string longer than the buffer");
+    ASSERT_EQ(contents(), "abcdea string longer than the buffer");
+}
+
+TEST_F(TestWriter, FlushesOnDestruction)
+{
+    {
+        Writer writer{path, false};
+        writer.write("done");
+    }
+    ASSERT_EQ(contents(), "done");
+}
+
+TEST_F(TestWriter, AppendKeepsExistingContent)
+{
+    {
+        Writer writer{path, false};
+        writer.write("first");
+    }
+    {
+        Writer writer{path, true};
+        writer.write(" second");
+    }
+    ASSERT_EQ(contents(), "first second");
+}
+
+TEST_F(TestWriter, ChangeCapacity)
+{
+    Writer writer{path, false, 8};
+    writer.write("abc");
+    writer.set_capacity(128);
+    ASSERT_EQ(writer.get_capacity(), 128u);
+    ASSERT_EQ(contents(), "abc");
+}
+
+TEST_F(TestWriter, OpenFailureThrows)
+{
+    ASSERT_THROW(Writer("/nonexistent/directory/file.txt", false), FileError);
+}
+
+TEST_F(TestWriter, CapturesIntoString)
+{
+    String output{};
+    Writer writer{&output, 4};
+    writer.write("abc");
+    ASSERT_EQ(output, "");
+
+    writer.write("a string longer than the buffer");
+    writer.put('!');
+    writer.flush();
+    ASSERT_EQ(output, "abca string longer than the buffer!");
+}
+
+TEST_F(TestWriter, OutPrintsToEnteredWriter)
+{
+    String output{};
+    Writer writer{&output};
+    Writer* previous{Writer::enter(&writer)};
+    Writer::out().write("captured");
+    Writer::out().flush();
+    Writer::enter(previous);
+
+    ASSERT_EQ(output, "captured");
+    ASSERT_NE(&Writer::out(), &writer);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}